@@ -0,0 +1,51 @@
+#include "benchmark.h"
+
+#include <p3/platform/event_loop.h>
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+namespace p3::bench {
+
+namespace {
+
+    std::size_t constexpr Events = 10000;
+
+    //
+    // the producers post all events, the loop runs until the last one
+    // was dispatched
+    void post_dispatch(State& state, std::size_t threads)
+    {
+        EventLoop loop;
+        std::atomic<std::size_t> processed { 0 };
+        state.set_items(Events);
+        while (state.keep_running()) {
+            processed = 0;
+            std::vector<std::thread> producers;
+            for (std::size_t i = 0; i < threads; ++i)
+                producers.emplace_back([&]() {
+                    for (std::size_t j = 0; j < Events / threads; ++j)
+                        loop.call_at(EventLoop::Clock::now(), Event::create([&]() {
+                            if (++processed == Events)
+                                loop.stop();
+                        }));
+                });
+            loop.run_forever();
+            for (auto& producer : producers)
+                producer.join();
+        }
+        loop.close();
+    }
+
+    Registration single_producer("event_loop.post_dispatch/10000/1_thread", [](State& state) {
+        post_dispatch(state, 1);
+    });
+
+    Registration multiple_producers("event_loop.post_dispatch/10000/4_threads", [](State& state) {
+        post_dispatch(state, 4);
+    });
+
+}
+
+}
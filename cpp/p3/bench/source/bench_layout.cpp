@@ -0,0 +1,51 @@
+#include "benchmark.h"
+#include "headless.h"
+#include "trees.h"
+
+#include <p3/UserInterface.h>
+
+#include <imgui.h>
+
+namespace p3::bench {
+
+namespace {
+
+    //
+    // renders the layout into an imgui window. if the available width
+    // alternates, every frame misses the placement cache
+    void place(State& state, std::size_t children, bool alternate_width)
+    {
+        Headless headless;
+        auto root = make_wide_tree(children);
+        headless.user_interface().set_content(root);
+        headless.frame();
+        state.set_items(children);
+        auto width = 1280.f;
+        while (state.keep_running()) {
+            state.pause_timing();
+            auto& context = headless.begin_frame();
+            ImGui::SetNextWindowPos(ImVec2(0.f, 0.f));
+            ImGui::SetNextWindowSize(ImVec2(1280.f, 720.f));
+            ImGui::Begin("layout", nullptr, ImGuiWindowFlags_NoDecoration);
+            if (alternate_width)
+                width = width == 1280.f ? 1279.f : 1280.f;
+            state.resume_timing();
+            root->render(context, width, 720.f);
+            state.pause_timing();
+            ImGui::End();
+            headless.end_frame();
+            state.resume_timing();
+        }
+    }
+
+    Registration place_cached("layout.render/10000", [](State& state) {
+        place(state, 10000, false);
+    });
+
+    Registration place_uncached("layout.render/10000/resized", [](State& state) {
+        place(state, 10000, true);
+    });
+
+}
+
+}
@@ -0,0 +1,92 @@
+#include "benchmark.h"
+
+#include <p3/Loader.h>
+#include <p3/Node.h>
+#include <p3/Parser.h>
+#include <p3/widgets/Button.h>
+
+#include <fmt/format.h>
+
+#include <iterator>
+#include <memory>
+#include <random>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace p3::bench {
+
+namespace {
+
+    std::size_t constexpr Rows = 1000;
+
+    //
+    // a large document, rows of a button, a text and a nested layout with
+    // every typed attribute, generated with a fixed seed
+    std::string make_markup()
+    {
+        static char const* alignments[] = { "start", "center", "end", "stretch", "baseline" };
+        static char const* justifications[] = { "start", "center", "end", "space_between", "space_around" };
+        std::mt19937 random(42);
+        std::string markup = R"(<Layout direction="vertical" width="100% 1 0">)";
+        for (std::size_t i = 0; i < Rows; ++i) {
+            markup += fmt::format(
+                R"(<Layout direction="horizontal" justify_content="{}" align_items="{}" spacing="{}px" padding="1em 0.5rem" class="row">)"
+                R"(<Button label="button {}" width="auto 1 0" disabled="{}"/>)"
+                R"(<Text value="text {}" color="#{:06x}"/>)"
+                R"(<Layout direction="vertical" background_color="#{:06x}" height="{}em 0 1"/>)"
+                R"(</Layout>)",
+                justifications[random() % 5], alignments[random() % 5], random() % 16,
+                i, random() % 2 ? "true" : "false",
+                i, random() & 0xffffff,
+                random() & 0xffffff, random() % 8);
+        }
+        markup += "</Layout>";
+        return markup;
+    }
+
+    Registration compile("loader.compile/1000_rows", [](State& state) {
+        Loader loader;
+        auto const markup = make_markup();
+        state.set_items(Rows);
+        while (state.keep_running())
+            do_not_optimize(loader.compile(markup));
+    });
+
+    Registration load("loader.load/1000_rows", [](State& state) {
+        Loader loader;
+        auto const markup = make_markup();
+        state.set_items(Rows);
+        while (state.keep_running())
+            do_not_optimize(loader.load(markup));
+    });
+
+    Registration instantiate("loader.instantiate/1000_rows", [](State& state) {
+        Loader loader;
+        auto const image = loader.compile(make_markup());
+        state.set_items(Rows);
+        while (state.keep_running())
+            do_not_optimize(loader.instantiate(image.data(), image.size()));
+    });
+
+    //
+    // the keyword lookups alone
+    Registration set_attribute("loader.set_attribute/label", [](State& state) {
+        auto button = std::make_shared<Button>();
+        std::string const value = "label";
+        state.set_items(1);
+        while (state.keep_running())
+            button->set_attribute("label", value);
+    });
+
+    Registration enum_lookup("loader.enum_table/justification", [](State& state) {
+        static std::string_view const keywords[] = { "start", "center", "end", "space_between", "space_around", "diagonal" };
+        state.set_items(std::size(keywords));
+        while (state.keep_running())
+            for (auto keyword : keywords)
+                do_not_optimize(parser::enum_table<Justification>.find(keyword));
+    });
+
+}
+
+}
@@ -0,0 +1,91 @@
+#include "benchmark.h"
+#include "headless.h"
+#include "trees.h"
+
+#include <p3/Theme.h>
+#include <p3/UserInterface.h>
+
+namespace p3::bench {
+
+namespace {
+
+    void construct(State& state, std::shared_ptr<Layout> (*make)(std::size_t), std::size_t size)
+    {
+        state.set_items(size);
+        while (state.keep_running()) {
+            auto root = make(size);
+            do_not_optimize(root);
+        }
+    }
+
+    void restyle(State& state, std::shared_ptr<Layout> root, std::size_t nodes)
+    {
+        Headless headless;
+        headless.user_interface().set_content(root);
+        auto& context = headless.begin_frame();
+        auto apply = headless.user_interface().theme()->compile(context);
+        {
+            auto theme_guard = apply();
+            root->update_restyle(context, true);
+            state.set_items(nodes);
+            while (state.keep_running())
+                root->update_restyle(context, true);
+        }
+        headless.end_frame();
+    }
+
+    //
+    // only the width of a single leaf changed, measures the invalidation
+    // and re-measure path up to the root
+    void restyle_one_dirty(State& state, std::shared_ptr<Layout> root, Node& leaf)
+    {
+        Headless headless;
+        headless.user_interface().set_content(root);
+        auto& context = headless.begin_frame();
+        auto apply = headless.user_interface().theme()->compile(context);
+        {
+            auto theme_guard = apply();
+            root->update_restyle(context, true);
+            float width = 10.f;
+            while (state.keep_running()) {
+                width = width == 10.f ? 20.f : 10.f;
+                leaf.set_width(LayoutLength { width | px, 0.f, 0.f });
+                root->update_restyle(context, false);
+            }
+        }
+        headless.end_frame();
+    }
+
+    Registration construct_wide("node.construct_teardown/wide/10000", [](State& state) {
+        construct(state, make_wide_tree, 10000);
+    });
+
+    Registration construct_deep("node.construct_teardown/deep/1000", [](State& state) {
+        construct(state, make_deep_tree, 1000);
+    });
+
+    Registration restyle_wide("node.update_restyle/wide/10000", [](State& state) {
+        restyle(state, make_wide_tree(10000), 10001);
+    });
+
+    Registration restyle_deep("node.update_restyle/deep/1000", [](State& state) {
+        restyle(state, make_deep_tree(1000), 1999);
+    });
+
+    Registration restyle_wide_one_dirty("node.update_restyle/wide/10000/one_dirty", [](State& state) {
+        auto root = make_wide_tree(10000);
+        auto& leaf = *root->children()[5000];
+        restyle_one_dirty(state, std::move(root), leaf);
+    });
+
+    Registration restyle_deep_one_dirty("node.update_restyle/deep/1000/one_dirty", [](State& state) {
+        auto root = make_deep_tree(1000);
+        Node* leaf = root.get();
+        while (leaf->children().size() > 1)
+            leaf = leaf->children()[1].get();
+        restyle_one_dirty(state, std::move(root), *leaf);
+    });
+
+}
+
+}
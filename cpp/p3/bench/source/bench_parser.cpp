@@ -0,0 +1,112 @@
+#include "benchmark.h"
+
+#include <p3/Parser.h>
+
+#include <fmt/format.h>
+
+#include <random>
+#include <string>
+#include <vector>
+
+namespace p3::bench {
+
+namespace {
+
+    using namespace p3::parser;
+
+    std::size_t constexpr Values = 10000;
+
+    //
+    // attribute values as they appear in markup, generated with a fixed seed
+    std::vector<std::string> make_values(std::string (*make)(std::mt19937&))
+    {
+        std::mt19937 random(42);
+        std::vector<std::string> values;
+        values.reserve(Values);
+        for (std::size_t i = 0; i < Values; ++i)
+            values.push_back(make(random));
+        return values;
+    }
+
+    std::string make_layout_length(std::mt19937& random)
+    {
+        static char const* units[] = { "px", "em", "rem", "%" };
+        std::uniform_real_distribution<float> value(0.f, 100.f);
+        if (random() % 8 == 0)
+            return fmt::format("auto {} {}", random() % 2, random() % 2);
+        return fmt::format("{:.2f}{} {} {}", value(random), units[random() % 4], random() % 2, random() % 2);
+    }
+
+    std::string make_color(std::mt19937& random)
+    {
+        return fmt::format("#{:06x}", random() & 0xffffff);
+    }
+
+    std::string make_alignment(std::mt19937& random)
+    {
+        static char const* names[] = { "start", "center", "end", "stretch", "baseline" };
+        return names[random() % 5];
+    }
+
+    std::string make_floating_point(std::mt19937& random)
+    {
+        std::uniform_real_distribution<double> value(-1000., 1000.);
+        return fmt::format("{}", value(random));
+    }
+
+    std::string make_name(std::mt19937& random)
+    {
+        static char const* names[] = { "width", "height", "justify_content", "align_items", "background_color" };
+        return names[random() % 5];
+    }
+
+    template <typename T>
+    void parse_values(State& state, std::string (*make)(std::mt19937&))
+    {
+        auto const values = make_values(make);
+        state.set_items(values.size());
+        while (state.keep_running())
+            for (auto const& value : values) {
+                T t;
+                do_not_optimize(parse(value.c_str(), t));
+                do_not_optimize(t);
+            }
+    }
+
+    template <pos (*Tokenizer)(pos)>
+    void tokenize(State& state, std::string (*make)(std::mt19937&))
+    {
+        auto const values = make_values(make);
+        state.set_items(values.size());
+        while (state.keep_running())
+            for (auto const& value : values)
+                do_not_optimize(Tokenizer(value.c_str()));
+    }
+
+    Registration tokenize_floating_point("parser.tokenizer/floating_point", [](State& state) {
+        tokenize<tokenizer::floating_point>(state, make_floating_point);
+    });
+
+    Registration tokenize_hex_color("parser.tokenizer/hex_color", [](State& state) {
+        tokenize<tokenizer::hex_color>(state, make_color);
+    });
+
+    Registration tokenize_name("parser.tokenizer/name", [](State& state) {
+        tokenize<tokenizer::name>(state, make_name);
+    });
+
+    Registration parse_layout_length("parser.parse/layout_length", [](State& state) {
+        parse_values<LayoutLength>(state, make_layout_length);
+    });
+
+    Registration parse_color("parser.parse/color", [](State& state) {
+        parse_values<parser::Color>(state, make_color);
+    });
+
+    Registration parse_alignment("parser.parse/alignment", [](State& state) {
+        parse_values<Alignment>(state, make_alignment);
+    });
+
+}
+
+}
@@ -0,0 +1,58 @@
+#include "benchmark.h"
+#include "headless.h"
+
+#include <p3/UserInterface.h>
+#include <p3/widgets/Plot.h>
+
+#include <cmath>
+#include <random>
+
+namespace p3::bench {
+
+namespace {
+
+    std::size_t constexpr Points = 1000000;
+
+    //
+    // a noisy sine with a fixed seed
+    template <typename Series>
+    std::shared_ptr<Series> make_series()
+    {
+        std::mt19937 random(42);
+        std::normal_distribution<double> noise(0., 0.1);
+        std::vector<double> x(Points);
+        std::vector<double> y(Points);
+        for (std::size_t i = 0; i < Points; ++i) {
+            x[i] = double(i) / double(Points);
+            y[i] = std::sin(x[i] * 20.) + noise(random);
+        }
+        auto series = std::make_shared<Series>();
+        series->set_name("series");
+        series->set_x(std::move(x));
+        series->set_y(std::move(y));
+        return series;
+    }
+
+    template <typename Series>
+    void render(State& state)
+    {
+        Headless headless;
+        auto plot = std::make_shared<Plot>();
+        plot->add(make_series<Series>());
+        headless.user_interface().set_content(plot);
+        state.set_items(Points);
+        while (state.keep_running())
+            headless.frame();
+    }
+
+    Registration line_series("plot.render/line_series/1000000", [](State& state) {
+        render<Plot::LineSeries<double>>(state);
+    });
+
+    Registration scatter_series("plot.render/scatter_series/1000000", [](State& state) {
+        render<Plot::ScatterSeries<double>>(state);
+    });
+
+}
+
+}
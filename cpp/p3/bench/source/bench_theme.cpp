@@ -0,0 +1,35 @@
+#include "benchmark.h"
+#include "headless.h"
+
+#include <p3/Theme.h>
+#include <p3/UserInterface.h>
+
+namespace p3::bench {
+
+namespace {
+
+    Registration compile("theme.compile", [](State& state) {
+        Headless headless;
+        auto& context = headless.begin_frame();
+        auto theme = headless.user_interface().theme();
+        while (state.keep_running()) {
+            auto apply = theme->compile(context);
+            do_not_optimize(apply);
+        }
+        headless.end_frame();
+    });
+
+    Registration apply("theme.apply", [](State& state) {
+        Headless headless;
+        auto& context = headless.begin_frame();
+        auto apply = headless.user_interface().theme()->compile(context);
+        while (state.keep_running()) {
+            auto guard = apply();
+            do_not_optimize(guard);
+        }
+        headless.end_frame();
+    });
+
+}
+
+}
@@ -0,0 +1,170 @@
+#include "benchmark.h"
+
+#include <fmt/chrono.h>
+#include <fmt/format.h>
+
+#include <algorithm>
+#include <cmath>
+#include <ctime>
+#include <numeric>
+
+namespace p3::bench {
+
+namespace {
+
+    std::size_t constexpr MaxIterations = 1000000000;
+
+    void append_escaped(std::string& out, std::string const& text)
+    {
+        for (auto c : text) {
+            if (c == '"' || c == '\\')
+                out.push_back('\\');
+            out.push_back(c);
+        }
+    }
+
+}
+
+State::State(std::size_t iterations)
+    : _iterations(iterations)
+{
+}
+
+bool State::keep_running()
+{
+    if (_iteration == 0 && !_start)
+        resume_timing();
+    if (_iteration == _iterations) {
+        pause_timing();
+        return false;
+    }
+    ++_iteration;
+    return true;
+}
+
+void State::pause_timing()
+{
+    if (!_start)
+        return;
+    _elapsed += Clock::now() - _start.value();
+    _start = std::nullopt;
+}
+
+void State::resume_timing()
+{
+    _start = Clock::now();
+}
+
+std::vector<Benchmark>& registry()
+{
+    static std::vector<Benchmark> benchmarks;
+    return benchmarks;
+}
+
+std::string& renderer()
+{
+    static std::string renderer;
+    return renderer;
+}
+
+double Result::min() const
+{
+    return samples.empty() ? 0. : *std::min_element(samples.begin(), samples.end());
+}
+
+double Result::median() const
+{
+    if (samples.empty())
+        return 0.;
+    auto sorted = samples;
+    std::sort(sorted.begin(), sorted.end());
+    auto const middle = sorted.size() / 2;
+    return sorted.size() % 2 ? sorted[middle] : (sorted[middle - 1] + sorted[middle]) / 2.;
+}
+
+double Result::mean() const
+{
+    return samples.empty() ? 0. : std::accumulate(samples.begin(), samples.end(), 0.) / double(samples.size());
+}
+
+double Result::stddev() const
+{
+    if (samples.size() < 2)
+        return 0.;
+    auto const m = mean();
+    auto sum = 0.;
+    for (auto sample : samples)
+        sum += (sample - m) * (sample - m);
+    return std::sqrt(sum / double(samples.size() - 1));
+}
+
+Result run(Benchmark const& benchmark, Options const& options)
+{
+    //
+    // grow the iteration count until a run takes the minimum time. the
+    // last run of the calibration warms up caches and pools
+    std::size_t iterations = 1;
+    for (;;) {
+        State state(iterations);
+        benchmark.function(state);
+        auto const seconds = std::chrono::duration<double>(state.elapsed()).count();
+        if (seconds >= options.min_time || iterations >= MaxIterations)
+            break;
+        auto const factor = seconds > 0. ? std::min(10., 1.4 * options.min_time / seconds) : 10.;
+        iterations = std::min(MaxIterations, std::max(iterations + 1, std::size_t(double(iterations) * factor)));
+    }
+
+    Result result;
+    result.name = benchmark.name;
+    result.iterations = iterations;
+    for (std::size_t i = 0; i < std::max(options.repetitions, std::size_t(1)); ++i) {
+        State state(iterations);
+        benchmark.function(state);
+        result.items = state.items();
+        result.samples.push_back(std::chrono::duration<double, std::nano>(state.elapsed()).count() / double(iterations));
+    }
+    return result;
+}
+
+std::string to_json(std::vector<Result> const& results, Options const& options)
+{
+    std::string out = "{\"context\":{";
+    out += fmt::format("\"date\":\"{:%Y-%m-%dT%H:%M:%SZ}\",", fmt::gmtime(std::time(nullptr)));
+#ifdef NDEBUG
+    out += "\"build_type\":\"release\",";
+#else
+    out += "\"build_type\":\"debug\",";
+#endif
+#ifdef P3_PROFILER
+    out += "\"profiler\":true,";
+#else
+    out += "\"profiler\":false,";
+#endif
+    out += "\"renderer\":\"";
+    append_escaped(out, renderer());
+    out += fmt::format("\",\"repetitions\":{},\"min_time\":{}}},\"benchmarks\":[", options.repetitions, options.min_time);
+    auto first = true;
+    for (auto const& result : results) {
+        if (!first)
+            out.push_back(',');
+        first = false;
+        out += "{\"name\":\"";
+        append_escaped(out, result.name);
+        auto const median = result.median();
+        out += fmt::format("\",\"iterations\":{},\"median_ns\":{:.3f},\"min_ns\":{:.3f},\"mean_ns\":{:.3f},\"stddev_ns\":{:.3f}",
+            result.iterations, median, result.min(), result.mean(), result.stddev());
+        if (result.items && median > 0.)
+            out += fmt::format(",\"items_per_second\":{:.1f}", double(result.items) * 1e9 / median);
+        out += ",\"samples_ns\":[";
+        for (std::size_t i = 0; i < result.samples.size(); ++i) {
+            if (i)
+                out.push_back(',');
+            out += fmt::format("{:.3f}", result.samples[i]);
+        }
+        out += "]}";
+    }
+    out += "]}";
+    return out;
+}
+
+}
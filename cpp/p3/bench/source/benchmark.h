@@ -0,0 +1,106 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <functional>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace p3::bench {
+
+using Clock = std::chrono::steady_clock;
+
+/*
+ * the timed loop of a benchmark. the setup before the loop is not timed,
+ * work inside the loop which should not count is excluded by pausing.
+ *
+ *     while (state.keep_running()) { ... }
+ */
+class State {
+public:
+    explicit State(std::size_t iterations);
+
+    bool keep_running();
+    std::size_t iterations() const { return _iterations; }
+
+    void pause_timing();
+    void resume_timing();
+
+    /// items processed per iteration, reported as throughput
+    void set_items(std::size_t items) { _items = items; }
+    std::size_t items() const { return _items; }
+
+    Clock::duration elapsed() const { return _elapsed; }
+
+private:
+    std::size_t _iterations;
+    std::size_t _iteration = 0;
+    std::size_t _items = 0;
+    std::optional<Clock::time_point> _start = std::nullopt;
+    Clock::duration _elapsed { 0 };
+};
+
+using Function = std::function<void(State&)>;
+
+struct Benchmark {
+    std::string name;
+    Function function;
+};
+
+std::vector<Benchmark>& registry();
+
+///
+/// registers a benchmark at static initialization
+struct Registration {
+    Registration(std::string name, Function function)
+    {
+        registry().push_back({ std::move(name), std::move(function) });
+    }
+};
+
+struct Options {
+    std::string filter;
+    std::size_t repetitions = 5;
+    /// time of a single repetition, the iteration count is fixed before
+    /// the first repetition, such that all repetitions do the same work
+    double min_time = 0.25;
+};
+
+struct Result {
+    std::string name;
+    std::size_t iterations = 0;
+    std::size_t items = 0;
+    /// nanoseconds per iteration of each repetition
+    std::vector<double> samples;
+
+    double min() const;
+    double median() const;
+    double mean() const;
+    double stddev() const;
+};
+
+Result run(Benchmark const&, Options const&);
+
+/// the gl renderer of the headless context, if one was created
+std::string& renderer();
+
+/// the results in a json document for trend tracking
+std::string to_json(std::vector<Result> const&, Options const&);
+
+/// keeps the compiler from discarding a result
+template <typename T>
+void do_not_optimize(T const& value)
+{
+#if defined(_MSC_VER)
+    static void const* volatile sink = nullptr;
+    sink = &value;
+#else
+    asm volatile(""
+                 :
+                 : "r"(&value)
+                 : "memory");
+#endif
+}
+
+}
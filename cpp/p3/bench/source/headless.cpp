@@ -0,0 +1,90 @@
+#include "headless.h"
+#include "benchmark.h"
+
+#define GLFW_INCLUDE_NONE
+#include <GLFW/glfw3.h>
+#include <glad/gl.h>
+
+#include <p3/UserInterface.h>
+#include <p3/backend/OpenGL3RenderBackend.h>
+#include <p3/platform/event_loop.h>
+
+#include <fmt/format.h>
+#include <imgui.h>
+#include <implot.h>
+
+#include <stdexcept>
+
+namespace p3::bench {
+
+Headless::Headless(std::size_t width, std::size_t height)
+    : _width(width)
+    , _height(height)
+    , _event_loop(std::make_shared<EventLoop>())
+{
+    glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE);
+    _glfw_window = std::shared_ptr<GLFWwindow>(
+        glfwCreateWindow(int(width), int(height), "p3_bench", nullptr, nullptr),
+        glfwDestroyWindow);
+    glfwDefaultWindowHints();
+    if (!_glfw_window)
+        throw std::runtime_error("failed to create headless context");
+    glfwMakeContextCurrent(_glfw_window.get());
+    gladLoadGL(glfwGetProcAddress);
+    glfwSwapInterval(0);
+    renderer() = fmt::format("{} ({})",
+        reinterpret_cast<char const*>(glGetString(GL_RENDERER)),
+        reinterpret_cast<char const*>(glGetString(GL_VERSION)));
+
+    _user_interface = std::make_shared<UserInterface>(width, height);
+    ImGui::SetCurrentContext(&_user_interface->im_gui_context());
+    ImPlot::SetCurrentContext(&_user_interface->im_plot_context());
+    _render_backend = std::make_shared<OpenGL3RenderBackend>();
+    _render_backend->init();
+    //
+    // no platform backend, the display is fixed
+    auto& io = ImGui::GetIO();
+    io.DisplaySize = ImVec2(float(width), float(height));
+    io.DeltaTime = 1.f / 60.f;
+}
+
+Headless::~Headless()
+{
+    _context.reset();
+    glfwMakeContextCurrent(_glfw_window.get());
+    _render_backend->shutdown();
+}
+
+void Headless::frame()
+{
+    glfwMakeContextCurrent(_glfw_window.get());
+    _render_backend->new_frame();
+    glViewport(0, 0, GLsizei(_width), GLsizei(_height));
+    glClear(GL_COLOR_BUFFER_BIT);
+    _render_backend->gc();
+    {
+        Context context(*_user_interface, *_render_backend, std::nullopt);
+        _user_interface->render(context, float(_width), float(_height), false);
+    }
+    _render_backend->render(*_user_interface);
+    glFinish();
+}
+
+Context& Headless::begin_frame()
+{
+    glfwMakeContextCurrent(_glfw_window.get());
+    //
+    // builds the font atlas on first use
+    _render_backend->new_frame();
+    _context.emplace(*_user_interface, *_render_backend, std::nullopt);
+    ImGui::NewFrame();
+    return _context.value();
+}
+
+void Headless::end_frame()
+{
+    ImGui::EndFrame();
+    _context.reset();
+}
+
+}
@@ -0,0 +1,54 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <optional>
+
+#include <p3/Context.h>
+
+struct GLFWwindow;
+
+namespace p3 {
+
+class EventLoop;
+class OpenGL3RenderBackend;
+class UserInterface;
+
+namespace bench {
+
+    /*
+     * an invisible window with an opengl context, the user interface is
+     * rendered into its framebuffer at a fixed size. on machines without
+     * a gpu mesa's llvmpipe provides the context, e.g.
+     *     LIBGL_ALWAYS_SOFTWARE=1 xvfb-run p3_bench
+     */
+    class Headless {
+    public:
+        Headless(std::size_t width = 1280, std::size_t height = 720);
+        ~Headless();
+
+        UserInterface& user_interface() const { return *_user_interface; }
+        OpenGL3RenderBackend& render_backend() const { return *_render_backend; }
+
+        /// a whole frame, including the submit to the gpu and glFinish
+        void frame();
+
+        ///
+        /// an imgui frame without rendering, e.g. for measuring the styling
+        /// of a tree. the context is valid until end_frame()
+        Context& begin_frame();
+        void end_frame();
+
+    private:
+        std::size_t _width;
+        std::size_t _height;
+        std::shared_ptr<EventLoop> _event_loop;
+        std::shared_ptr<GLFWwindow> _glfw_window;
+        std::shared_ptr<OpenGL3RenderBackend> _render_backend;
+        std::shared_ptr<UserInterface> _user_interface;
+        std::optional<Context> _context;
+    };
+
+}
+
+}
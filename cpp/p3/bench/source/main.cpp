@@ -0,0 +1,99 @@
+#include "benchmark.h"
+
+#include <fmt/format.h>
+
+#include <cstring>
+#include <fstream>
+#include <iostream>
+
+using namespace p3::bench;
+
+namespace {
+
+std::string format_time(double ns)
+{
+    if (ns < 1e3)
+        return fmt::format("{:.1f} ns", ns);
+    if (ns < 1e6)
+        return fmt::format("{:.2f} us", ns / 1e3);
+    if (ns < 1e9)
+        return fmt::format("{:.2f} ms", ns / 1e6);
+    return fmt::format("{:.2f} s", ns / 1e9);
+}
+
+void usage()
+{
+    std::cout << "usage: p3_bench [--list] [--filter=<substring>] [--repetitions=<n>]\n"
+                 "                [--min-time=<seconds>] [--json=<path>|-]\n";
+}
+
+}
+
+int main(int argc, char** argv)
+{
+    Options options;
+    std::string json;
+    auto list = false;
+    for (int i = 1; i < argc; ++i) {
+        std::string const arg = argv[i];
+        std::string value;
+        auto option = [&](char const* prefix) {
+            if (arg.rfind(prefix, 0) != 0)
+                return false;
+            value = arg.substr(std::strlen(prefix));
+            return true;
+        };
+        if (arg == "--list")
+            list = true;
+        else if (option("--filter="))
+            options.filter = value;
+        else if (option("--repetitions="))
+            options.repetitions = std::stoul(value);
+        else if (option("--min-time="))
+            options.min_time = std::stod(value);
+        else if (option("--json="))
+            json = value;
+        else {
+            usage();
+            return arg == "--help" ? 0 : 1;
+        }
+    }
+
+    //
+    // the table goes to stderr if the json is written to stdout
+    auto& out = json == "-" ? std::cerr : std::cout;
+    if (!list)
+        out << fmt::format("{:<44} {:>12} {:>12} {:>9} {:>12}", "benchmark", "median", "min", "stddev", "iterations") << std::endl;
+    std::vector<Result> results;
+    for (auto const& benchmark : registry()) {
+        if (benchmark.name.find(options.filter) == std::string::npos)
+            continue;
+        if (list) {
+            std::cout << benchmark.name << std::endl;
+            continue;
+        }
+        results.push_back(run(benchmark, options));
+        auto const& result = results.back();
+        auto line = fmt::format("{:<44} {:>12} {:>12} {:>8.1f}% {:>12}",
+            result.name,
+            format_time(result.median()),
+            format_time(result.min()),
+            result.median() > 0. ? 100. * result.stddev() / result.median() : 0.,
+            result.iterations);
+        if (result.items)
+            line += fmt::format(" {:>14.0f} items/s", double(result.items) * 1e9 / result.median());
+        out << line << std::endl;
+    }
+
+    if (json == "-") {
+        std::cout << to_json(results, options) << std::endl;
+    } else if (!json.empty()) {
+        std::ofstream file(json);
+        if (!file) {
+            std::cerr << "could not write " << json << std::endl;
+            return 1;
+        }
+        file << to_json(results, options);
+    }
+    return 0;
+}
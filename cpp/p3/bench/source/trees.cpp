@@ -0,0 +1,30 @@
+#include "trees.h"
+
+#include <p3/widgets/Button.h>
+
+#include <fmt/format.h>
+
+namespace p3::bench {
+
+std::shared_ptr<Layout> make_wide_tree(std::size_t children)
+{
+    auto root = std::make_shared<Layout>();
+    for (std::size_t i = 0; i < children; ++i)
+        root->add(std::make_shared<Button>(fmt::format("button {}", i)));
+    return root;
+}
+
+std::shared_ptr<Layout> make_deep_tree(std::size_t depth)
+{
+    auto root = std::make_shared<Layout>();
+    auto parent = root;
+    for (std::size_t i = 1; i < depth; ++i) {
+        parent->add(std::make_shared<Button>(fmt::format("button {}", i)));
+        auto child = std::make_shared<Layout>();
+        parent->add(child);
+        parent = child;
+    }
+    return root;
+}
+
+}
@@ -0,0 +1,16 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+
+#include <p3/Layout.h>
+
+namespace p3::bench {
+
+/// a layout with the given number of buttons
+std::shared_ptr<Layout> make_wide_tree(std::size_t children);
+
+/// a chain of nested layouts, each with a button next to the nested one
+std::shared_ptr<Layout> make_deep_tree(std::size_t depth);
+
+}
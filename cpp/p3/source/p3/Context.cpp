@@ -1,6 +1,8 @@
 
 #include "context.h"
+#include "Node.h"
 #include "UserInterface.h"
+#include "platform/event_loop.h"
 
 #include <imgui.h>
 
@@ -51,6 +53,26 @@ Context::MouseMove const& Context::mouse_move() const
     return _mouse_move;
 }
 
+void Context::schedule_mouse_dispatch(std::shared_ptr<Node> node)
+{
+    _mouse_dispatch.push_back(std::move(node));
+}
+
+void Context::dispatch_mouse_events()
+{
+    if (_mouse_dispatch.empty())
+        return;
+    auto event = Event::create([nodes = std::move(_mouse_dispatch)]() {
+        for (auto& node : nodes)
+            node->dispatch_mouse_events();
+    });
+    //
+    // the handlers are timed per node, see Node::dispatch_mouse_events
+    event->set_self_timed();
+    EventLoop::current()->call_at(EventLoop::Clock::now(), std::move(event));
+    _mouse_dispatch.clear();
+}
+
 float Context::to_actual(Length const& length) const
 {
     if (std::holds_alternative<Px>(length))
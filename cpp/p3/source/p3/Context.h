@@ -7,9 +7,11 @@
 #include <memory>
 #include <optional>
 #include <string>
+#include <vector>
 
 namespace p3 {
 
+class Node;
 class Theme;
 class UserInterface;
 class RenderBackend;
@@ -35,6 +37,11 @@ public:
     MouseMove const& mouse_move() const;
     float to_actual(Length const&) const;
 
+    /// nodes with batched mouse events, see Node::raw_mouse_events
+    void schedule_mouse_dispatch(std::shared_ptr<Node>);
+    /// posts a single event delivering the mouse events of this frame
+    void dispatch_mouse_events();
+
     RenderLayer& render_layer() const;
     void push_render_layer(RenderLayer& layer) { _render_layer.push_back(&layer); }
     void pop_render_layer() { _render_layer.pop_back(); }
@@ -51,6 +58,7 @@ private:
     MouseMove _mouse_move;
     RenderTarget* _render_target;
     std::vector<RenderLayer*> _render_layer;
+    std::vector<std::shared_ptr<Node>> _mouse_dispatch;
 };
 
 }
@@ -0,0 +1,73 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+namespace p3 {
+
+//
+// binary indexed tree over non-negative values (e.g. item heights).
+// point updates, prefix sums and the search for the item containing a
+// given offset are O(log n), building from a list of values is O(n).
+template <typename T>
+class FenwickTree {
+public:
+    void assign(std::vector<T> values)
+    {
+        _values = std::move(values);
+        _tree.assign(_values.size() + 1, T {});
+        for (std::size_t i = 1; i < _tree.size(); ++i) {
+            _tree[i] += _values[i - 1];
+            auto parent = i + (i & (~i + 1));
+            if (parent < _tree.size())
+                _tree[parent] += _tree[i];
+        }
+    }
+
+    std::size_t size() const { return _values.size(); }
+    bool empty() const { return _values.empty(); }
+
+    T const& value(std::size_t index) const { return _values[index]; }
+
+    void set(std::size_t index, T value)
+    {
+        auto delta = value - _values[index];
+        if (delta == T {})
+            return;
+        _values[index] = value;
+        for (auto i = index + 1; i < _tree.size(); i += i & (~i + 1))
+            _tree[i] += delta;
+    }
+
+    /// sum of the first "count" values
+    T prefix(std::size_t count) const
+    {
+        T sum {};
+        for (auto i = count; i > 0; i -= i & (~i + 1))
+            sum += _tree[i];
+        return sum;
+    }
+
+    T total() const { return prefix(_values.size()); }
+
+    /// index of the item that contains the offset, size() if behind the last item
+    std::size_t find(T offset) const
+    {
+        std::size_t index = 0;
+        std::size_t step = 1;
+        while (step * 2 < _tree.size())
+            step *= 2;
+        for (; step > 0; step /= 2)
+            if (index + step < _tree.size() && _tree[index + step] <= offset) {
+                index += step;
+                offset -= _tree[index];
+            }
+        return index;
+    }
+
+private:
+    std::vector<T> _values;
+    std::vector<T> _tree;
+};
+
+}
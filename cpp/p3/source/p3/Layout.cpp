@@ -1,6 +1,7 @@
 
 #include "Layout.h"
 #include "Context.h"
+#include "Profiler.h"
 #include "convert.h"
 
 #include <numeric>
@@ -13,6 +14,7 @@
 
 namespace {
 bool _debug = false;
+p3::Layout::CacheStatistics cache_statistics_;
 }
 
 namespace p3 {
@@ -29,6 +31,7 @@ void Layout::update_content()
         padding.x = Context::current().to_actual(std::get<0>(_padding.value()));
         padding.y = Context::current().to_actual(std::get<1>(_padding.value()));
     }
+    auto const spacing = actual_spacing(ImGui::GetStyle().ItemSpacing.y);
     if (_direction == Direction::Vertical) {
         if (!height_basis()) {
             _automatic_height = 0.0f;
@@ -37,7 +40,7 @@ void Layout::update_content()
                 if (!child->visible() || child->position() == Position::Absolute)
                     continue;
                 if (!first)
-                    _automatic_height += _spacing ? Context::current().to_actual(_spacing.value()) : ImGui::GetStyle().ItemSpacing.y;
+                    _automatic_height += spacing;
                 first = false;
                 _automatic_height += child->contextual_height(0);
             }
@@ -60,7 +63,7 @@ void Layout::update_content()
                 if (!child->visible() || child->position() == Position::Absolute)
                     continue;
                 if (!first)
-                    _automatic_width += _spacing ? Context::current().to_actual(_spacing.value()) : ImGui::GetStyle().ItemSpacing.y;
+                    _automatic_width += spacing;
                 first = false;
                 _automatic_width += child->contextual_width(0);
             }
@@ -78,8 +81,208 @@ void Layout::update_content()
     }
 }
 
+Layout::CacheStatistics const& Layout::cache_statistics()
+{
+    return cache_statistics_;
+}
+
+void Layout::reset_cache_statistics()
+{
+    cache_statistics_ = CacheStatistics {};
+}
+
+float Layout::actual_spacing(float fallback) const
+{
+    return _spacing ? Context::current().to_actual(_spacing.value()) : fallback;
+}
+
+std::vector<Layout::Placement> const& Layout::placements(float w, float h)
+{
+    if (_cache.valid
+        && _cache.width == w
+        && _cache.height == h
+        && _cache.generation == update_generation()) {
+        ++cache_statistics_.hits;
+        return _cache.placements;
+    }
+    ++cache_statistics_.misses;
+    _cache.placements.clear();
+    if (_direction == Direction::Horizontal)
+        place_horizontal(w, h);
+    else
+        place_vertical(w, h);
+    _cache.valid = true;
+    _cache.width = w;
+    _cache.height = h;
+    _cache.generation = update_generation();
+    return _cache.placements;
+}
+
+void Layout::place_horizontal(float w, float h)
+{
+    auto const spacing = actual_spacing(ImGui::GetStyle().ItemSpacing.x);
+    auto content = w;
+    auto occupied = 0.0f;
+    auto grow_total = 0.0f;
+    bool first = true;
+    std::size_t visible_count = 0;
+    for (auto const& child : children()) {
+        if (!child->visible() || child->position() == Position::Absolute)
+            continue;
+        ++visible_count;
+        if (!first)
+            occupied += spacing;
+        first = false;
+        //
+        // fallback to 0.0, although this should be the natively computed size
+        occupied += child->contextual_width(w);
+        grow_total += child->width_grow();
+    }
+    auto remaining = content - occupied;
+    first = true;
+    ImVec2 cursor(0.f, 0.f);
+    for (auto& child : children()) {
+        if (!child->visible() || child->position() == Position::Absolute)
+            continue;
+        //
+        // fallback to 0.0, although this should be the natively computed size
+        float width = child->contextual_width(content);
+        float height;
+        if (remaining >= 0. && child->width_grow() != 0.f)
+            width += remaining * (child->width_grow() / grow_total);
+        else if (remaining < 0.f && child->width_shrink() != 0.f)
+            width -= std::max(.1f, remaining * (child->width_shrink() / grow_total));
+        std::optional<float> y = std::nullopt;
+        switch (_align_items) {
+        case Alignment::Stretch:
+            height = h;
+            break;
+        case Alignment::Center:
+            height = child->contextual_height(h);
+            y = (h - height) / 2.0f;
+            break;
+        case Alignment::Baseline:
+            height = child->contextual_height(h);
+            break;
+        case Alignment::Start:
+            height = child->contextual_height(h);
+            y = 0.0f;
+            break;
+        case Alignment::End:
+            height = child->contextual_height(h);
+            y = h - height;
+            break;
+        }
+        std::optional<float> x;
+        if (grow_total == 0.f && remaining > 0.f)
+            switch (_justify_content) {
+            case Justification::Start:
+                x = 0.f;
+                break;
+            case Justification::End:
+                x = first ? w - occupied : 0.f;
+                break;
+            case Justification::SpaceAround:
+                x = remaining / (visible_count + 1);
+                break;
+            case Justification::SpaceBetween:
+                x = first ? 0.f : remaining / (visible_count - 1);
+                break;
+            case Justification::Center:
+                x = first ? remaining / 2.f : 0.f;
+                break;
+            }
+        if (x)
+            cursor.x += x.value();
+        if (y)
+            cursor.y += y.value();
+        _cache.placements.push_back(Placement { child.get(), cursor.x, cursor.y, width, height });
+        cursor.x += width + spacing;
+        cursor.y = 0.f;
+        first = false;
+    }
+}
+
+void Layout::place_vertical(float w, float h)
+{
+    auto const spacing = actual_spacing(ImGui::GetStyle().ItemSpacing.y);
+    auto content = h;
+
+    auto occupied = 0.f;
+    auto grow_total = 0.f;
+    std::size_t visible_count = 0;
+    for (auto const& child : children()) {
+        if (!child->visible() || child->position() == Position::Absolute)
+            continue;
+        ++visible_count;
+        occupied += child->contextual_height(content);
+        grow_total += child->height_grow();
+    }
+    if (visible_count > 1)
+        occupied += (visible_count - 1) * spacing;
+    auto remaining = content - occupied;
+    auto first = true;
+    ImVec2 cursor(0.f, 0.f);
+    for (auto& child : children()) {
+        if (!child->visible() || child->position() == Position::Absolute)
+            continue;
+        float height = child->contextual_height(content);
+        float width = 0.f;
+        if (remaining >= 0.f && child->height_grow() != 0.f)
+            height += remaining * (child->height_grow() / grow_total);
+        else if (remaining < 0.f && child->height_shrink() != 0.f)
+            height -= std::max(0.0001f, remaining * (child->height_shrink() / grow_total));
+        std::optional<float> x;
+        switch (_align_items) {
+        case Alignment::Stretch:
+            width = w;
+            break;
+        case Alignment::Center:
+            width = child->contextual_width(w);
+            x = (w - width) / 2.0f;
+            break;
+        case Alignment::Start:
+            width = child->contextual_width(w);
+            x = 0.0f;
+            break;
+        case Alignment::End:
+            width = child->contextual_width(w);
+            x = w - width;
+            break;
+        }
+        std::optional<float> y;
+        if (grow_total == 0.f && remaining > 0.f)
+            switch (_justify_content) {
+            case Justification::Start:
+                y = 0.f;
+                break;
+            case Justification::End:
+                y = first ? h - occupied : 0.f;
+                break;
+            case Justification::SpaceAround:
+                y = remaining / (visible_count + 1);
+                break;
+            case Justification::SpaceBetween:
+                y = first ? 0.f : remaining / (visible_count - 1);
+                break;
+            case Justification::Center:
+                y = first ? remaining / 2.f : 0.f;
+                break;
+            }
+        if (x)
+            cursor.x += x.value();
+        if (y)
+            cursor.y += y.value();
+        _cache.placements.push_back(Placement { child.get(), cursor.x, cursor.y, width, height });
+        cursor.y += height + spacing;
+        cursor.x = 0.f;
+        first = false;
+    }
+}
+
 void Layout::render_impl(Context& context, float w, float h)
 {
+    P3_PROFILE_ZONE("layout.render");
     if (_background_color) {
         auto& window = *ImGui::GetCurrentWindow();
         auto p1 = ImGui::GetCursorScreenPos();
@@ -103,176 +306,24 @@ void Layout::render_impl(Context& context, float w, float h)
 
     ImGui::SetCursorPos(initial_cursor);
 
-    auto cursor = initial_cursor;
-    if (_direction == Direction::Horizontal) {
-        auto content = w;
-        auto occupied = 0.0f;
-        auto grow_total = 0.0f;
-        bool first = true;
-        std::size_t visible_count = 0;
-        for (auto const& child : children()) {
-            if (!child->visible() || child->position() == Position::Absolute)
-                continue;
-            ++visible_count;
-            if (!first)
-                occupied += _spacing ? Context::current().to_actual(_spacing.value()) : ImGui::GetStyle().ItemSpacing.x;
-            first = false;
-            //
-            // fallback to 0.0, although this should be the natively computed size
-            occupied += child->contextual_width(w);
-            grow_total += child->width_grow();
-        }
-        auto remaining = content - occupied;
-        first = true;
-        for (auto& child : children()) {
-            if (!child->visible() || child->position() == Position::Absolute)
-                continue;
-            //
-            // fallback to 0.0, although this should be the natively computed size
-            float width = child->contextual_width(content);
-            float height;
-            if (remaining >= 0. && child->width_grow() != 0.f)
-                width += remaining * (child->width_grow() / grow_total);
-            else if (remaining < 0.f && child->width_shrink() != 0.f)
-                width -= std::max(.1f, remaining * (child->width_shrink() / grow_total));
+    auto const horizontal = _direction == Direction::Horizontal;
+    auto first = true;
+    for (auto const& placement : placements(w, h)) {
+        if (horizontal) {
             if (!first)
                 ImGui::SameLine();
-            std::optional<float> y = std::nullopt;
-            switch (_align_items) {
-            case Alignment::Stretch:
-                height = h;
-                break;
-            case Alignment::Center:
-                height = child->contextual_height(h);
-                y = (h - height) / 2.0f;
-                break;
-            case Alignment::Baseline:
-                height = child->contextual_height(h);
+            if (_align_items == Alignment::Baseline)
                 ImGui::AlignTextToFramePadding();
-                break;
-            case Alignment::Start:
-                height = child->contextual_height(h);
-                y = 0.0f;
-                break;
-            case Alignment::End:
-                height = child->contextual_height(h);
-                y = h - height;
-                break;
-            }
-            std::optional<float> x;
-            if (grow_total == 0.f && remaining > 0.f)
-                switch (_justify_content) {
-                case Justification::Start:
-                    x = 0.f;
-                    break;
-                case Justification::End:
-                    x = first ? w - occupied : 0.f;
-                    break;
-                case Justification::SpaceAround:
-                    x = remaining / (visible_count + 1);
-                    break;
-                case Justification::SpaceBetween:
-                    x = first ? 0.f : remaining / (visible_count - 1);
-                    break;
-                case Justification::Center:
-                    x = first ? remaining / 2.f : 0.f;
-                    break;
-                }
-            if (x)
-                cursor.x += x.value();
-            if (y)
-                cursor.y += y.value();
-            ImGui::SetCursorPos(cursor);
-            auto window = ImGui::GetCurrentWindow();
-            window->DC.CurrLineTextBaseOffset = 0;
-            window->DC.CursorPosPrevLine.y = window->DC.CursorPos.y;
-            float backup = 0.f;
-            child->render(context, width, height, true);
-            cursor.x += width + (_spacing ? Context::current().to_actual(_spacing.value()) : ImGui::GetStyle().ItemSpacing.x);
-            cursor.y = initial_cursor.y;
-            first = false;
-        }
-    } else {
-        auto content = h;
-
-        auto occupied = 0.f;
-        auto grow_total = 0.f;
-        auto first = true;
-        std::size_t visible_count = 0;
-        for (auto const& child : children()) {
-            if (!child->visible() || child->position() == Position::Absolute)
-                continue;
-            first = false;
-            ++visible_count;
-            occupied += child->contextual_height(content);
-            grow_total += child->height_grow();
-        }
-        if (visible_count > 1)
-            occupied += (visible_count - 1) * (_spacing ? Context::current().to_actual(_spacing.value()) : ImGui::GetStyle().ItemSpacing.y);
-        auto remaining = content - occupied;
-        first = true;
-        for (auto& child : children()) {
-            if (!child->visible() || child->position() == Position::Absolute)
-                continue;
-            float height = child->contextual_height(content);
-            float width = 0.f;
-            if (remaining >= 0.f && child->height_grow() != 0.f)
-                height += remaining * (child->height_grow() / grow_total);
-            else if (remaining < 0.f && child->height_shrink() != 0.f)
-                height -= std::max(0.0001f, remaining * (child->height_shrink() / grow_total));
-            std::optional<float> x;
-            switch (_align_items) {
-            case Alignment::Stretch:
-                width = w;
-                break;
-            case Alignment::Center:
-                width = child->contextual_width(w);
-                x = (w - width) / 2.0f;
-                break;
-            case Alignment::Start:
-                width = child->contextual_width(w);
-                x = 0.0f;
-                break;
-            case Alignment::End:
-                width = child->contextual_width(w);
-                x = w - width;
-                break;
-            }
-            std::optional<float> y;
-            if (grow_total == 0.f && remaining > 0.f)
-                switch (_justify_content) {
-                case Justification::Start:
-                    y = 0.f;
-                    break;
-                case Justification::End:
-                    y = first ? h - occupied : 0.f;
-                    break;
-                case Justification::SpaceAround:
-                    y = remaining / (visible_count + 1);
-                    break;
-                case Justification::SpaceBetween:
-                    y = first ? 0.f : remaining / (visible_count - 1);
-                    break;
-                case Justification::Center:
-                    y = first ? remaining / 2.f : 0.f;
-                    break;
-                }
-            if (x)
-                cursor.x += x.value();
-            if (y)
-                cursor.y += y.value();
-            ImGui::SetCursorPos(cursor);
-            auto window = ImGui::GetCurrentWindow();
-            window->DC.CurrLineTextBaseOffset = 0;
-            float backup = 0.f;
-            child->render(context, width, height, true);
-            cursor.y += height + (_spacing ? Context::current().to_actual(_spacing.value()) : ImGui::GetStyle().ItemSpacing.y);
-            cursor.x = initial_cursor.x;
-            first = false;
         }
+        ImGui::SetCursorPos(ImVec2(initial_cursor.x + placement.x, initial_cursor.y + placement.y));
+        auto window = ImGui::GetCurrentWindow();
+        window->DC.CurrLineTextBaseOffset = 0;
+        if (horizontal)
+            window->DC.CursorPosPrevLine.y = window->DC.CursorPos.y;
+        placement.node->render(context, placement.width, placement.height, true);
+        first = false;
     }
-    cursor.x = initial_cursor.x + w + frame_padding.x;
-    cursor.y = initial_cursor.y + h + frame_padding.y;
+    ImVec2 cursor(initial_cursor.x + w + frame_padding.x, initial_cursor.y + h + frame_padding.y);
     ImGui::SetCursorPos(cursor);
 
     if (_debug) {
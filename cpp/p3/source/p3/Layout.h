@@ -10,6 +10,15 @@ namespace p3 {
 
 class Layout : public Node {
 public:
+    //
+    // hit/miss counters of the placement cache (all layouts)
+    struct CacheStatistics {
+        std::uint64_t hits = 0;
+        std::uint64_t misses = 0;
+    };
+    static CacheStatistics const& cache_statistics();
+    static void reset_cache_statistics();
+
     Layout();
 
     void update_content() override;
@@ -34,6 +43,31 @@ public:
     void set_background_color(std::optional<Color>);
 
 private:
+    //
+    // child rects relative to the padded content origin.
+    // replayed as long as the available size and the update generation
+    // of this subtree do not change.
+    struct Placement {
+        Node* node;
+        float x;
+        float y;
+        float width;
+        float height;
+    };
+    struct {
+        bool valid = false;
+        float width = 0.f;
+        float height = 0.f;
+        std::uint64_t generation = 0;
+        std::vector<Placement> placements;
+    } _cache;
+
+    std::vector<Placement> const& placements(float width, float height);
+    void place_horizontal(float width, float height);
+    void place_vertical(float width, float height);
+
+    float actual_spacing(float fallback) const;
+
     Direction _direction = Direction::Vertical;
     Justification _justify_content = Justification::SpaceBetween;
     Alignment _align_items = Alignment::Stretch;
@@ -0,0 +1,699 @@
+#include "Loader.h"
+#include "Layout.h"
+#include "Node.h"
+#include "Text.h"
+#include "log.h"
+#include "platform/MappedFile.h"
+#include "widgets/Button.h"
+#include "widgets/Collapsible.h"
+#include "widgets/ColorEdit.h"
+#include "widgets/ComboBox.h"
+#include "widgets/Image.h"
+#include "widgets/InputText.h"
+#include "widgets/Menu.h"
+#include "widgets/MenuItem.h"
+#include "widgets/Plot.h"
+#include "widgets/Popup.h"
+#include "widgets/InputScalar.h"
+#include "widgets/ProgressBar.h"
+#include "widgets/ScrollArea.h"
+#include "widgets/Slider.h"
+#include "widgets/ToolTip.h"
+#include "widgets/check_box.h"
+#include "widgets/child_window.h"
+#include "widgets/spacer.h"
+
+#include <p3/Parser.h>
+#include <p3/StaticMap.h>
+
+#include <fmt/format.h>
+#include <pugixml.hpp>
+
+#include <charconv>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <stdexcept>
+
+namespace p3 {
+
+namespace {
+
+    constexpr char Magic[4] = { 'p', '3', 'u', 'i' };
+    constexpr std::uint32_t Version = 2;
+    constexpr std::uint32_t None = ~std::uint32_t(0);
+
+    //
+    // the hash covers everything behind the hash itself
+    struct Header {
+        char magic[4];
+        std::uint32_t version;
+        std::uint64_t hash;
+        std::uint64_t source_hash;
+        std::uint32_t node_count;
+        std::uint32_t attribute_count;
+        std::uint32_t string_count;
+        std::uint32_t string_bytes;
+    };
+    constexpr std::size_t HashedOffset = offsetof(Header, source_hash);
+
+    //
+    // nodes are stored in document order, the parent precedes its children
+    struct CompiledNode {
+        std::uint32_t element;
+        std::uint32_t parent;
+        std::uint32_t first_attribute;
+        std::uint32_t attribute_count;
+    };
+
+    enum class Type : std::uint8_t {
+        String,
+        Bool,
+        Int,
+        Float,
+        Color,
+        Length,
+        Length2,
+        LayoutLength,
+        Direction,
+        Alignment,
+        Justification
+    };
+
+    enum class Unit : std::uint8_t {
+        None,
+        Px,
+        Em,
+        Rem,
+        Percent
+    };
+
+    //
+    // data holds the string index, the bits of the floats, the rgba value
+    // or the enum value. units of pairs are packed into the nibbles
+    struct CompiledAttribute {
+        std::uint32_t name;
+        Type type;
+        std::uint8_t units;
+        std::uint16_t reserved;
+        std::uint32_t data[3];
+    };
+
+    struct CompiledString {
+        std::uint32_t offset;
+        std::uint32_t size;
+    };
+
+    static_assert(sizeof(Header) == 40);
+    static_assert(sizeof(CompiledNode) == 16);
+    static_assert(sizeof(CompiledAttribute) == 20);
+    static_assert(sizeof(CompiledString) == 8);
+
+    std::uint64_t hash(std::uint8_t const* data, std::size_t size)
+    {
+        //
+        // fnv-1a
+        std::uint64_t hash = 0xcbf29ce484222325ull;
+        for (std::size_t i = 0; i < size; ++i)
+            hash = (hash ^ data[i]) * 0x100000001b3ull;
+        return hash;
+    }
+
+    std::uint32_t to_bits(float value)
+    {
+        std::uint32_t bits;
+        std::memcpy(&bits, &value, sizeof(bits));
+        return bits;
+    }
+
+    float from_bits(std::uint32_t bits)
+    {
+        float value;
+        std::memcpy(&value, &bits, sizeof(value));
+        return value;
+    }
+
+    void encode_length(Length const& length, Unit& unit, std::uint32_t& data)
+    {
+        if (std::holds_alternative<Px>(length)) {
+            unit = Unit::Px;
+            data = to_bits(std::get<Px>(length).value);
+        } else if (std::holds_alternative<Em>(length)) {
+            unit = Unit::Em;
+            data = to_bits(std::get<Em>(length).value);
+        } else {
+            unit = Unit::Rem;
+            data = to_bits(std::get<Rem>(length).value);
+        }
+    }
+
+    Length decode_length(Unit unit, std::uint32_t data)
+    {
+        switch (unit) {
+        case Unit::Px:
+            return Px { from_bits(data) };
+        case Unit::Em:
+            return Em { from_bits(data) };
+        case Unit::Rem:
+            return Rem { from_bits(data) };
+        default:
+            throw std::runtime_error("invalid length in compiled ui");
+        }
+    }
+
+    //
+    // value of an attribute while instantiating
+    struct Value {
+        CompiledAttribute const& attribute;
+        std::string_view text;
+
+        template <typename T>
+        T get() const;
+    };
+
+    template <>
+    std::string Value::get<std::string>() const { return std::string(text); }
+
+    template <>
+    bool Value::get<bool>() const { return attribute.data[0] != 0; }
+
+    template <>
+    std::int32_t Value::get<std::int32_t>() const { return std::int32_t(attribute.data[0]); }
+
+    template <>
+    float Value::get<float>() const { return from_bits(attribute.data[0]); }
+
+    template <>
+    Color Value::get<Color>() const { return Color(attribute.data[0]); }
+
+    template <>
+    Length Value::get<Length>() const { return decode_length(Unit(attribute.units), attribute.data[0]); }
+
+    template <>
+    Length2 Value::get<Length2>() const
+    {
+        return Length2 {
+            decode_length(Unit(attribute.units & 0xF), attribute.data[0]),
+            decode_length(Unit(attribute.units >> 4), attribute.data[1])
+        };
+    }
+
+    template <>
+    LayoutLength Value::get<LayoutLength>() const
+    {
+        OptionalLengthPercentage basis;
+        auto const unit = Unit(attribute.units);
+        if (unit == Unit::Percent)
+            basis = Percentage { from_bits(attribute.data[0]) };
+        else if (unit != Unit::None)
+            basis = decode_length(unit, attribute.data[0]);
+        return LayoutLength { basis, from_bits(attribute.data[1]), from_bits(attribute.data[2]) };
+    }
+
+    template <>
+    Direction Value::get<Direction>() const { return Direction(attribute.data[0]); }
+
+    template <>
+    Alignment Value::get<Alignment>() const { return Alignment(attribute.data[0]); }
+
+    template <>
+    Justification Value::get<Justification>() const { return Justification(attribute.data[0]); }
+
+    template <typename T>
+    constexpr Type type_of();
+    template <>
+    constexpr Type type_of<std::string>() { return Type::String; }
+    template <>
+    constexpr Type type_of<bool>() { return Type::Bool; }
+    template <>
+    constexpr Type type_of<std::int32_t>() { return Type::Int; }
+    template <>
+    constexpr Type type_of<float>() { return Type::Float; }
+    template <>
+    constexpr Type type_of<Color>() { return Type::Color; }
+    template <>
+    constexpr Type type_of<Length>() { return Type::Length; }
+    template <>
+    constexpr Type type_of<Length2>() { return Type::Length2; }
+    template <>
+    constexpr Type type_of<LayoutLength>() { return Type::LayoutLength; }
+    template <>
+    constexpr Type type_of<Direction>() { return Type::Direction; }
+    template <>
+    constexpr Type type_of<Alignment>() { return Type::Alignment; }
+    template <>
+    constexpr Type type_of<Justification>() { return Type::Justification; }
+
+    struct Attribute {
+        Type type;
+        void (*apply)(Node&, Value const&);
+    };
+
+    template <typename N, typename T, auto Setter>
+    void apply(Node& node, Value const& value)
+    {
+        auto target = dynamic_cast<N*>(&node);
+        if (!target)
+            throw std::runtime_error(fmt::format("attribute does not apply to {}", node.element_name()));
+        (target->*Setter)(value.get<T>());
+    }
+
+    template <typename N, typename T, auto Setter>
+    constexpr Attribute attribute()
+    {
+        return Attribute { type_of<T>(), &apply<N, T, Setter> };
+    }
+
+    //
+    // typed attributes, keyed by name for all nodes or by element.name
+    constexpr auto attributes = make_static_map<Attribute>({
+        { "label", attribute<Node, std::string, &Node::set_label>() },
+        { "class", attribute<Node, std::string, &Node::set_class_name>() },
+        { "width", attribute<Node, LayoutLength, &Node::set_width>() },
+        { "height", attribute<Node, LayoutLength, &Node::set_height>() },
+        { "visible", attribute<Node, bool, &Node::set_visible>() },
+        { "disabled", attribute<Node, bool, &Node::set_disabled>() },
+        { "color", attribute<Node, Color, &Node::set_color>() },
+        { "Layout.direction", attribute<Layout, Direction, &Layout::set_direction>() },
+        { "Layout.justify_content", attribute<Layout, Justification, &Layout::set_justify_content>() },
+        { "Layout.align_items", attribute<Layout, Alignment, &Layout::set_align_items>() },
+        { "Layout.spacing", attribute<Layout, Length, &Layout::set_spacing>() },
+        { "Layout.padding", attribute<Layout, Length2, &Layout::set_padding>() },
+        { "Layout.background_color", attribute<Layout, Color, &Layout::set_background_color>() },
+        { "Text.value", attribute<Text, std::string, &Text::set_value>() },
+        { "CheckBox.value", attribute<CheckBox, bool, &CheckBox::set_value>() },
+        { "CheckBox.radio", attribute<CheckBox, bool, &CheckBox::set_radio>() },
+        { "ProgressBar.value", attribute<ProgressBar, float, &ProgressBar::set_value>() },
+        { "InputText.value", attribute<InputText, std::string, &InputText::set_value>() },
+        { "InputText.hint", attribute<InputText, std::string, &InputText::set_hint>() },
+        { "InputText.multi_line", attribute<InputText, bool, &InputText::set_multi_line>() },
+        { "SliderFloat.value", attribute<Slider<float>, float, &Slider<float>::set_value>() },
+        { "SliderFloat.min", attribute<Slider<float>, float, &Slider<float>::set_min>() },
+        { "SliderFloat.max", attribute<Slider<float>, float, &Slider<float>::set_max>() },
+        { "SliderFloat.format", attribute<Slider<float>, std::string, &Slider<float>::set_format>() },
+        { "SliderFloat.direction", attribute<Slider<float>, Direction, &Slider<float>::set_direction>() },
+        { "SliderS32.value", attribute<Slider<std::int32_t>, std::int32_t, &Slider<std::int32_t>::set_value>() },
+        { "SliderS32.min", attribute<Slider<std::int32_t>, std::int32_t, &Slider<std::int32_t>::set_min>() },
+        { "SliderS32.max", attribute<Slider<std::int32_t>, std::int32_t, &Slider<std::int32_t>::set_max>() },
+        { "SliderS32.format", attribute<Slider<std::int32_t>, std::string, &Slider<std::int32_t>::set_format>() },
+        { "SliderS32.direction", attribute<Slider<std::int32_t>, Direction, &Slider<std::int32_t>::set_direction>() },
+        { "InputFloat.value", attribute<InputScalar<float>, float, &InputScalar<float>::set_value>() },
+        { "InputFloat.step", attribute<InputScalar<float>, float, &InputScalar<float>::set_step>() },
+        { "InputFloat.format", attribute<InputScalar<float>, std::string, &InputScalar<float>::set_format>() },
+        { "InputS32.value", attribute<InputScalar<std::int32_t>, std::int32_t, &InputScalar<std::int32_t>::set_value>() },
+        { "InputS32.step", attribute<InputScalar<std::int32_t>, std::int32_t, &InputScalar<std::int32_t>::set_step>() },
+        { "InputS32.format", attribute<InputScalar<std::int32_t>, std::string, &InputScalar<std::int32_t>::set_format>() },
+    });
+
+    Attribute const* find_attribute(std::string_view element, std::string_view name)
+    {
+        //
+        // the qualified key is assembled on the stack, keys are short
+        char key[64];
+        if (element.size() + 1 + name.size() <= sizeof(key)) {
+            std::memcpy(key, element.data(), element.size());
+            key[element.size()] = '.';
+            std::memcpy(key + element.size() + 1, name.data(), name.size());
+            if (auto attribute = attributes.find(std::string_view(key, element.size() + 1 + name.size())))
+                return attribute;
+        }
+        return attributes.find(name);
+    }
+
+    //
+    // the whole value has to be consumed, the offset is the one of the
+    // first character which could not be consumed
+    template <typename T>
+    parser::ParseResult parse_value(std::string const& text, T& value)
+    {
+        return parser::try_parse(text.c_str(), value);
+    }
+
+    parser::ParseResult parse_int(std::string const& text, std::int32_t& value)
+    {
+        auto const end = text.data() + text.size();
+        auto const result = std::from_chars(text.data(), end, value);
+        return parser::ParseResult { result.ec == std::errc() && result.ptr == end, std::size_t(result.ptr - text.data()) };
+    }
+
+    template <typename E>
+    parser::ParseResult parse_enum(std::string const& text, std::uint32_t& value)
+    {
+        auto const keyword = parser::enum_table<E>.find(text);
+        if (keyword)
+            value = std::uint32_t(*keyword);
+        return parser::ParseResult { keyword != nullptr, keyword ? text.size() : 0 };
+    }
+
+    class Builder {
+    public:
+        //
+        // invalid values are collected and reported at once
+        struct Error {
+            std::string attribute;
+            std::size_t offset;
+        };
+
+        std::vector<CompiledNode> nodes;
+        std::vector<CompiledAttribute> attributes;
+        std::vector<Error> errors;
+
+        std::uint32_t string(std::string_view value)
+        {
+            auto it = _index.find(std::string(value));
+            if (it != _index.end())
+                return it->second;
+            auto const index = std::uint32_t(_strings.size());
+            _strings.push_back(CompiledString { std::uint32_t(_bytes.size()), std::uint32_t(value.size()) });
+            _bytes.insert(_bytes.end(), value.begin(), value.end());
+            _index.emplace(std::string(value), index);
+            return index;
+        }
+
+        CompiledAttribute encode(std::string_view element, char const* name, std::string const& text)
+        {
+            CompiledAttribute compiled {};
+            compiled.name = string(name);
+            auto const attribute = find_attribute(element, name);
+            if (!attribute)
+                throw parser::ParserError(fmt::format("attribute {} of {} not found", name, element));
+            compiled.type = attribute->type;
+            auto result = parser::ParseResult { true, 0 };
+            switch (compiled.type) {
+            case Type::String:
+                compiled.data[0] = string(text);
+                break;
+            case Type::Bool:
+                result.ok = text == "true" || text == "false";
+                compiled.data[0] = text == "true";
+                break;
+            case Type::Int: {
+                std::int32_t value = 0;
+                result = parse_int(text, value);
+                compiled.data[0] = std::uint32_t(value);
+                break;
+            }
+            case Type::Float: {
+                float value = 0.f;
+                result = parse_value(text, value);
+                compiled.data[0] = to_bits(value);
+                break;
+            }
+            case Type::Color:
+                try {
+                    compiled.data[0] = std::uint32_t(Color(text));
+                } catch (std::exception const&) {
+                    result.ok = false;
+                }
+                break;
+            case Type::Length: {
+                Length length = Px { 0.f };
+                result = parse_value(text, length);
+                Unit unit;
+                encode_length(length, unit, compiled.data[0]);
+                compiled.units = std::uint8_t(unit);
+                break;
+            }
+            case Type::Length2: {
+                Length2 length { Px { 0.f }, Px { 0.f } };
+                result = parse_value(text, length);
+                Unit first, second;
+                encode_length(length[0], first, compiled.data[0]);
+                encode_length(length[1], second, compiled.data[1]);
+                compiled.units = std::uint8_t(first) | std::uint8_t(second) << 4;
+                break;
+            }
+            case Type::LayoutLength: {
+                LayoutLength length { std::nullopt, 0.f, 0.f };
+                result = parse_value(text, length);
+                auto const& basis = std::get<0>(length);
+                auto unit = Unit::None;
+                if (basis && std::holds_alternative<Percentage>(basis.value())) {
+                    unit = Unit::Percent;
+                    compiled.data[0] = to_bits(std::get<Percentage>(basis.value()).value);
+                } else if (basis) {
+                    encode_length(std::get<Length>(basis.value()), unit, compiled.data[0]);
+                }
+                compiled.units = std::uint8_t(unit);
+                compiled.data[1] = to_bits(std::get<1>(length));
+                compiled.data[2] = to_bits(std::get<2>(length));
+                break;
+            }
+            case Type::Direction:
+                result = parse_enum<Direction>(text, compiled.data[0]);
+                break;
+            case Type::Alignment:
+                result = parse_enum<Alignment>(text, compiled.data[0]);
+                break;
+            case Type::Justification:
+                result = parse_enum<Justification>(text, compiled.data[0]);
+                break;
+            }
+            if (!result)
+                errors.push_back(Error { fmt::format("{}.{}", element, name), result.offset });
+            return compiled;
+        }
+
+        std::vector<std::uint8_t> finish(std::uint64_t source_hash) const
+        {
+            Header header {};
+            std::memcpy(header.magic, Magic, sizeof(Magic));
+            header.version = Version;
+            header.source_hash = source_hash;
+            header.node_count = std::uint32_t(nodes.size());
+            header.attribute_count = std::uint32_t(attributes.size());
+            header.string_count = std::uint32_t(_strings.size());
+            header.string_bytes = std::uint32_t(_bytes.size());
+
+            std::vector<std::uint8_t> image;
+            image.reserve(sizeof(Header)
+                + nodes.size() * sizeof(CompiledNode)
+                + attributes.size() * sizeof(CompiledAttribute)
+                + _strings.size() * sizeof(CompiledString)
+                + _bytes.size());
+            auto append = [&](void const* data, std::size_t size) {
+                auto const bytes = static_cast<std::uint8_t const*>(data);
+                image.insert(image.end(), bytes, bytes + size);
+            };
+            append(&header, sizeof(header));
+            append(nodes.data(), nodes.size() * sizeof(CompiledNode));
+            append(attributes.data(), attributes.size() * sizeof(CompiledAttribute));
+            append(_strings.data(), _strings.size() * sizeof(CompiledString));
+            append(_bytes.data(), _bytes.size());
+            header.hash = hash(image.data() + HashedOffset, image.size() - HashedOffset);
+            std::memcpy(image.data(), &header, sizeof(header));
+            return image;
+        }
+
+    private:
+        std::vector<CompiledString> _strings;
+        std::vector<char> _bytes;
+        std::unordered_map<std::string, std::uint32_t> _index;
+    };
+
+    std::uint64_t hash(std::string_view text)
+    {
+        return hash(reinterpret_cast<std::uint8_t const*>(text.data()), text.size());
+    }
+
+}
+
+Loader::Loader()
+{
+    add_element("Layout", []() { return std::make_shared<Layout>(); });
+    add_element("Text", []() { return std::make_shared<Text>(); });
+    add_element("Button", []() { return std::make_shared<Button>(); });
+    add_element("CheckBox", []() { return std::make_shared<CheckBox>(); });
+    add_element("ChildWindow", []() { return std::make_shared<ChildWindow>(); });
+    add_element("Collapsible", []() { return std::make_shared<Collapsible>(); });
+    add_element("ColorEdit", []() { return std::make_shared<ColorEdit>(); });
+    add_element("ComboBox", []() { return std::make_shared<ComboBox>(); });
+    add_element("Image", []() { return std::make_shared<Image>(); });
+    add_element("InputText", []() { return std::make_shared<InputText>(); });
+    add_element("Menu", []() { return std::make_shared<Menu>(); });
+    add_element("MenuItem", []() { return std::make_shared<MenuItem>(); });
+    add_element("Plot", []() { return std::make_shared<Plot>(); });
+    add_element("Popup", []() { return std::make_shared<Popup>(); });
+    add_element("ProgressBar", []() { return std::make_shared<ProgressBar>(); });
+    add_element("ScrollArea", []() { return std::make_shared<ScrollArea>(); });
+    add_element("SliderFloat", []() { return std::make_shared<Slider<float>>(); });
+    add_element("SliderS32", []() { return std::make_shared<Slider<std::int32_t>>(); });
+    add_element("InputFloat", []() { return std::make_shared<InputScalar<float>>(); });
+    add_element("InputS32", []() { return std::make_shared<InputScalar<std::int32_t>>(); });
+    add_element("Spacer", []() { return std::make_shared<Spacer>(); });
+    add_element("ToolTip", []() { return std::make_shared<ToolTip>(); });
+}
+
+void Loader::add_element(std::string name, Factory factory)
+{
+    _factories[std::move(name)] = std::move(factory);
+}
+
+std::vector<std::uint8_t> Loader::compile(std::string_view markup) const
+{
+    pugi::xml_document document;
+    auto const result = document.load_buffer(markup.data(), markup.size());
+    if (!result)
+        throw parser::ParserError(fmt::format("{} at offset {}", result.description(), result.offset));
+    auto const root = document.document_element();
+    if (!root)
+        throw parser::ParserError("markup has no element");
+
+    Builder builder;
+    std::function<void(pugi::xml_node, std::uint32_t)> compile_element = [&](pugi::xml_node element, std::uint32_t parent) {
+        if (_factories.find(element.name()) == _factories.end())
+            throw parser::ParserError(fmt::format("element {} not found", element.name()));
+        auto const index = std::uint32_t(builder.nodes.size());
+        builder.nodes.push_back(CompiledNode {
+            builder.string(element.name()),
+            parent,
+            std::uint32_t(builder.attributes.size()),
+            0 });
+        for (auto const& attribute : element.attributes())
+            builder.attributes.push_back(builder.encode(element.name(), attribute.name(), attribute.value()));
+        builder.nodes[index].attribute_count = std::uint32_t(builder.attributes.size()) - builder.nodes[index].first_attribute;
+        for (auto const& child : element.children())
+            if (child.type() == pugi::node_element)
+                compile_element(child, index);
+    };
+    compile_element(root, None);
+    if (!builder.errors.empty()) {
+        std::string message = "invalid values:";
+        for (auto const& error : builder.errors)
+            message += fmt::format(" {} at offset {},", error.attribute, error.offset);
+        message.pop_back();
+        throw parser::ParserError(message);
+    }
+    return builder.finish(hash(markup));
+}
+
+bool Loader::valid(std::uint8_t const* data, std::size_t size)
+{
+    if (size < sizeof(Header))
+        return false;
+    Header header;
+    std::memcpy(&header, data, sizeof(header));
+    if (std::memcmp(header.magic, Magic, sizeof(Magic)) != 0 || header.version != Version)
+        return false;
+    auto const expected = sizeof(Header)
+        + std::size_t(header.node_count) * sizeof(CompiledNode)
+        + std::size_t(header.attribute_count) * sizeof(CompiledAttribute)
+        + std::size_t(header.string_count) * sizeof(CompiledString)
+        + std::size_t(header.string_bytes);
+    return size == expected && header.hash == hash(data + HashedOffset, size - HashedOffset);
+}
+
+std::shared_ptr<Node> Loader::instantiate(std::uint8_t const* data, std::size_t size) const
+{
+    if (!valid(data, size))
+        throw std::runtime_error("compiled ui is invalid or of another version");
+    Header header;
+    std::memcpy(&header, data, sizeof(header));
+    if (header.node_count == 0)
+        throw std::runtime_error("compiled ui has no element");
+    auto const nodes = reinterpret_cast<CompiledNode const*>(data + sizeof(Header));
+    auto const attributes = reinterpret_cast<CompiledAttribute const*>(nodes + header.node_count);
+    auto const strings = reinterpret_cast<CompiledString const*>(attributes + header.attribute_count);
+    auto const bytes = reinterpret_cast<char const*>(strings + header.string_count);
+
+    auto string = [&](std::uint32_t index) {
+        if (index >= header.string_count || std::size_t(strings[index].offset) + strings[index].size > header.string_bytes)
+            throw std::runtime_error("invalid string in compiled ui");
+        return std::string_view(bytes + strings[index].offset, strings[index].size);
+    };
+
+    //
+    // factories and attributes are resolved once per distinct name
+    std::vector<Factory const*> factories(header.string_count, nullptr);
+    std::unordered_map<std::uint64_t, Attribute const*> resolved;
+
+    std::vector<std::shared_ptr<Node>> instances;
+    instances.reserve(header.node_count);
+    for (std::uint32_t i = 0; i < header.node_count; ++i) {
+        auto const& compiled = nodes[i];
+        auto const element = string(compiled.element);
+        auto& factory = factories[compiled.element];
+        if (!factory) {
+            auto it = _factories.find(std::string(element));
+            if (it == _factories.end())
+                throw std::runtime_error(fmt::format("element {} not found", element));
+            factory = &it->second;
+        }
+        auto node = (*factory)();
+
+        if (std::size_t(compiled.first_attribute) + compiled.attribute_count > header.attribute_count)
+            throw std::runtime_error("invalid attributes in compiled ui");
+        for (std::uint32_t a = compiled.first_attribute; a < compiled.first_attribute + compiled.attribute_count; ++a) {
+            auto const& attribute = attributes[a];
+            auto const name = string(attribute.name);
+            auto const key = std::uint64_t(compiled.element) << 32 | attribute.name;
+            auto it = resolved.find(key);
+            if (it == resolved.end())
+                it = resolved.emplace(key, find_attribute(element, name)).first;
+            if (!it->second || it->second->type != attribute.type)
+                throw std::runtime_error(fmt::format("attribute {} of {} does not match", name, element));
+            auto const text = attribute.type == Type::String ? string(attribute.data[0]) : std::string_view();
+            it->second->apply(*node, Value { attribute, text });
+        }
+
+        if (compiled.parent != None) {
+            if (compiled.parent >= i)
+                throw std::runtime_error("invalid parent in compiled ui");
+            instances[compiled.parent]->add(node);
+        } else if (i != 0) {
+            throw std::runtime_error("compiled ui has more than one root");
+        }
+        instances.push_back(std::move(node));
+    }
+    return instances.front();
+}
+
+std::shared_ptr<Node> Loader::load(std::string_view markup) const
+{
+    auto const image = compile(markup);
+    return instantiate(image.data(), image.size());
+}
+
+std::shared_ptr<Node> Loader::load_compiled(std::filesystem::path const& path) const
+{
+    MappedFile file(path);
+    return instantiate(file.data(), file.size());
+}
+
+std::shared_ptr<Node> Loader::load_cached(std::filesystem::path const& markup, std::filesystem::path const& cache) const
+{
+    std::ifstream stream(markup, std::ios::binary);
+    if (!stream)
+        throw std::runtime_error("failed to open \"" + markup.string() + "\"");
+    std::string const text { std::istreambuf_iterator<char>(stream), std::istreambuf_iterator<char>() };
+
+    if (std::filesystem::exists(cache)) {
+        //
+        // the mapping is released before the cache may be rewritten
+        try {
+            MappedFile file(cache);
+            Header header;
+            if (valid(file.data(), file.size())) {
+                std::memcpy(&header, file.data(), sizeof(header));
+                if (header.source_hash == hash(text))
+                    return instantiate(file.data(), file.size());
+            }
+        } catch (std::runtime_error const& e) {
+            log_warn("ignoring ui cache \"{}\": {}", cache.string(), e.what());
+        }
+    }
+
+    //
+    // the cache is written only once the image was instantiated
+    auto const image = compile(text);
+    auto node = instantiate(image.data(), image.size());
+    std::ofstream output(cache, std::ios::binary | std::ios::trunc);
+    output.write(reinterpret_cast<char const*>(image.data()), std::streamsize(image.size()));
+    if (!output)
+        log_warn("failed to write ui cache \"{}\"", cache.string());
+    else
+        log_debug("ui cache \"{}\" written ({} bytes)", cache.string(), image.size());
+    return node;
+}
+
+}
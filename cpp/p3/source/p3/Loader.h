@@ -0,0 +1,62 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <functional>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace p3 {
+
+class Node;
+
+/*
+ * builds trees from markup, e.g. <Layout direction="horizontal"><Button
+ * label="ok"/></Layout>. elements are the element names of the nodes,
+ * attributes are parsed once into typed values, hence the compiled form
+ * instantiates without any text parsing. unknown attributes are rejected
+ * when compiling.
+ *
+ * the compiled form is a flat image of little endian tables, which is used
+ * in place, e.g. from a mapped file. it is validated by a hash over the
+ * content and carries the hash of its markup, see load_cached.
+ */
+class Loader {
+public:
+    using Factory = std::function<std::shared_ptr<Node>()>;
+
+    /// knows the builtin widgets
+    Loader();
+
+    void add_element(std::string name, Factory);
+
+    ///
+    /// throws parser::ParserError on invalid markup, unknown elements or
+    /// attributes. invalid values are reported at once, with their offsets
+    std::vector<std::uint8_t> compile(std::string_view markup) const;
+
+    /// throws std::runtime_error if the image is invalid
+    std::shared_ptr<Node> instantiate(std::uint8_t const* data, std::size_t size) const;
+
+    std::shared_ptr<Node> load(std::string_view markup) const;
+
+    /// maps a file written from compile()
+    std::shared_ptr<Node> load_compiled(std::filesystem::path const&) const;
+
+    ///
+    /// instantiates the cache if it was compiled from the current markup,
+    /// otherwise the markup is compiled and the cache rewritten
+    std::shared_ptr<Node> load_cached(std::filesystem::path const& markup, std::filesystem::path const& cache) const;
+
+    /// false if the image is truncated, of another version or corrupt
+    static bool valid(std::uint8_t const* data, std::size_t size);
+
+private:
+    std::unordered_map<std::string, Factory> _factories;
+};
+
+}
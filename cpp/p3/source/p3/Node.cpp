@@ -1,6 +1,8 @@
 #include "Node.h"
 #include "Context.h"
 #include "RenderLayer.h"
+#include "SlotMap.h"
+#include "StyleSheet.h"
 #include "Theme.h"
 #include "UserInterface.h"
 #include "convert.h"
@@ -8,11 +10,13 @@
 #include "platform/event_loop.h"
 
 #include <p3/Parser.h>
+#include <p3/StaticMap.h>
 
 #include <imgui.h>
 #include <imgui_internal.h>
 #include <mutex>
-#include <unordered_map>
+#include <stdexcept>
+#include <utility>
 
 namespace p3 {
 
@@ -20,42 +24,30 @@ std::function<void(Node&)> NodeInitializer = nullptr;
 
 namespace registry {
 
-    thread_local struct
-    {
-        std::vector<std::uint64_t> pool;
-        std::uint64_t max = 0;
-        std::unordered_map<std::uint64_t, Node*> nodes;
-    } state;
+    //
+    // imgui ids are handed out by a generational slot map. a recycled
+    // slot gets a new generation, hence a new imgui id and a new label,
+    // so stale imgui state is never picked up by a new node.
+    thread_local SlotMap<Node*> state;
 
     std::size_t count()
     {
-        return state.nodes.size();
+        return state.size();
     }
 
     std::uint64_t add(Node* node)
     {
-        std::uint64_t id;
-        if (state.pool.empty()) {
-            id = state.max++;
-        } else {
-            id = state.pool.back();
-            state.pool.pop_back();
-        }
-        state.nodes[id] = node;
-        return id;
+        return state.add(node);
     }
 
     void release(std::uint64_t id)
     {
-        state.pool.push_back(id);
-        state.nodes.erase(id);
+        state.release(id);
     }
 
     Node* get(std::uint64_t id)
     {
-        if (!registry::state.nodes.count(id))
-            return nullptr;
-        return registry::state.nodes[id];
+        return state.get(id);
     }
 
 }
@@ -78,54 +70,128 @@ Node::~Node()
     registry::release(_imgui_id);
 }
 
-void Node::set_attribute(std::string const& name, std::string const& value)
-{
-    static auto setter = std::unordered_map<std::string, std::function<void(Node&, std::string const&)>> {
+namespace {
+
+    using AttributeSetter = void (*)(Node&, std::string const&);
+
+    constexpr auto attribute_setters = make_static_map<AttributeSetter>({
         { "label", [](Node& node, std::string const& value) { node.set_label(value); } },
         { "width", [](Node& node, std::string const& value) { node.set_width(parser::parse<LayoutLength>(value.c_str())); } },
         { "height", [](Node& node, std::string const& value) { node.set_height(parser::parse<LayoutLength>(value.c_str())); } },
-    };
-    auto it = setter.find(name);
-    if (it == setter.end())
+        { "class", [](Node& node, std::string const& value) { node.set_class_name(value); } },
+    });
+
+}
+
+void Node::set_attribute(std::string_view name, std::string const& value)
+{
+    auto setter = attribute_setters.find(name);
+    if (!setter)
         throw parser::ParserError(fmt::format("attribute {} not found", name));
-    it->second(*this, value);
+    (*setter)(*this, value);
 }
 
 void Node::update_status()
 {
-    ImGuiWindow const& window = *GImGui->CurrentWindow;
     auto const status_flags = GImGui->LastItemData.StatusFlags;
     if (status_flags == _status_flags) {
-        if (_mouse.hovered && _mouse.move && Context::current().mouse_move()) {
-            MouseEvent e(this);
-            postpone([f = _mouse.move, e = std::move(e)]() mutable { f(std::move(e)); });
-        }
+        if (_mouse.hovered && _mouse.move && Context::current().mouse_move())
+            queue_mouse_event(MouseEventType::Move, MouseEvent(this));
     } else if ((status_flags & ImGuiItemStatusFlags_HoveredRect) && !(_status_flags & ImGuiItemStatusFlags_HoveredRect)) {
         _mouse.hovered = true;
-        if (_mouse.enter || _mouse.hovered) {
-            MouseEvent e(this);
-            _mouse.x = e.global_x();
-            _mouse.y = e.global_y();
-            if (_mouse.enter)
-                postpone([f = _mouse.enter, e = std::move(e)]() mutable { f(std::move(e)); });
-        }
+        MouseEvent e(this);
+        _mouse.x = e.global_x();
+        _mouse.y = e.global_y();
+        if (_mouse.enter)
+            queue_mouse_event(MouseEventType::Enter, std::move(e));
     } else if (_status_flags & ImGuiItemStatusFlags_HoveredRect) {
         _mouse.hovered = false;
         if (_mouse.leave)
-            postpone([f = _mouse.leave, e = MouseEvent(this)]() mutable { f(std::move(e)); });
+            queue_mouse_event(MouseEventType::Leave, MouseEvent(this));
     }
     if (_mouse.hovered && _mouse.wheel) {
         auto wheel = ImGui::GetIO().MouseWheel;
-        if (wheel != 0.f) {
-            postpone([f = _mouse.wheel, wheel]() mutable { f(wheel); });
-        }
+        if (wheel != 0.f)
+            queue_mouse_wheel(wheel);
     }
     _status_flags = status_flags;
 }
 
-void Node::postpone(std::function<void()> f)
+void Node::queue_mouse_event(MouseEventType type, MouseEvent e)
 {
-    EventLoop::current()->call_at(EventLoop::Clock::now(), Event::create(f));
+    if (_mouse.raw) {
+        auto const& f = type == MouseEventType::Enter ? _mouse.enter
+            : type == MouseEventType::Move            ? _mouse.move
+                                                      : _mouse.leave;
+        auto const signal = type == MouseEventType::Enter ? "on_mouse_enter"
+            : type == MouseEventType::Move                ? "on_mouse_move"
+                                                          : "on_mouse_leave";
+        postpone(signal, [f, e = std::move(e)]() mutable { f(std::move(e)); });
+        return;
+    }
+    _mouse.pending.emplace_back(type, std::move(e));
+    schedule_mouse_dispatch();
+}
+
+void Node::queue_mouse_wheel(float wheel)
+{
+    if (_mouse.raw) {
+        postpone("on_mouse_wheel", [f = _mouse.wheel, wheel]() mutable { f(wheel); });
+        return;
+    }
+    _mouse.pending_wheel += wheel;
+    schedule_mouse_dispatch();
+}
+
+void Node::schedule_mouse_dispatch()
+{
+    if (_mouse.scheduled)
+        return;
+    _mouse.scheduled = true;
+    Context::current().schedule_mouse_dispatch(shared_from_this());
+}
+
+void Node::dispatch_mouse_events()
+{
+    _mouse.scheduled = false;
+    //
+    // the events of all nodes are dispatched by a single event,
+    // hence the handlers are timed one by one
+    auto loop = EventLoop::current();
+    auto timed = [&](char const* signal, auto&& f) {
+        auto const begin = EventLoop::Clock::now();
+        f();
+        if (loop)
+            loop->callback_statistics().record(this, signal, EventLoop::Clock::now() - begin);
+    };
+    //
+    // handlers are copied, they may replace themselves
+    for (auto& [type, e] : _mouse.pending) {
+        auto f = type == MouseEventType::Enter ? _mouse.enter
+            : type == MouseEventType::Move     ? _mouse.move
+                                               : _mouse.leave;
+        auto const signal = type == MouseEventType::Enter ? "on_mouse_enter"
+            : type == MouseEventType::Move                ? "on_mouse_move"
+                                                          : "on_mouse_leave";
+        if (f)
+            timed(signal, [&]() { f(e); });
+    }
+    _mouse.pending.clear();
+    if (_mouse.pending_wheel != 0.f) {
+        auto wheel = std::exchange(_mouse.pending_wheel, 0.f);
+        if (auto f = _mouse.wheel)
+            timed("on_mouse_wheel", [&]() { f(wheel); });
+    }
+}
+
+bool Node::raw_mouse_events() const
+{
+    return _mouse.raw;
+}
+
+void Node::set_raw_mouse_events(bool raw)
+{
+    _mouse.raw = raw;
 }
 
 std::string const& Node::element_name() const
@@ -160,6 +226,7 @@ void Node::update_restyle(Context& context, bool force)
         // force layer to redraw
         if (_render_layer)
             _render_layer->set_dirty();
+        update_computed_style(context);
     }
 
     {
@@ -170,12 +237,66 @@ void Node::update_restyle(Context& context, bool force)
             if (child->visible())
                 child->update_restyle(context,
                     _needs_restyle /* force restyle of child if this was restyled*/);
-        update_content();
+        //
+        // only re-measure if this node was invalidated or the
+        // measured size of a child changed. if the measured size
+        // of this node changes, the parent needs to re-measure, too.
+        if (_needs_restyle || _needs_measure) {
+            auto const width = _automatic_width;
+            auto const height = _automatic_height;
+            update_content();
+            if (_parent && (_needs_restyle || width != _automatic_width || height != _automatic_height)) {
+                _parent->_needs_measure = true;
+                _parent->child_resized(*this);
+            }
+            ++_update_generation;
+        }
         pop_style();
     }
     //
     // change state
-    _needs_update = _needs_restyle = false;
+    _needs_update = _needs_restyle = _needs_measure = false;
+}
+
+void Node::update_computed_style(Context& context)
+{
+    auto parent = _parent ? _parent->_computed_style : nullptr;
+    if (!parent && !_style_sheet) {
+        _computed_style = nullptr;
+        _style_changed = false;
+        return;
+    }
+    auto const& parent_color = _parent ? _parent->_color : std::nullopt;
+    if (!_style_changed && _computed_style && _computed_style->up_to_date(parent.get(), parent_color, context.rem(), ImGui::GetFontSize()))
+        return;
+    _computed_style = ComputedStyle::compute(*this, std::move(parent), context);
+    _style_changed = false;
+}
+
+std::optional<std::string> const& Node::class_name() const
+{
+    return _class_name;
+}
+
+void Node::set_class_name(std::optional<std::string> class_name)
+{
+    if (_class_name == class_name)
+        return;
+    _class_name = std::move(class_name);
+    _style_changed = true;
+    set_needs_restyle();
+}
+
+std::shared_ptr<StyleSheet> const& Node::style_sheet() const
+{
+    return _style_sheet;
+}
+
+void Node::set_style_sheet(std::shared_ptr<StyleSheet> style_sheet)
+{
+    _style_sheet = std::move(style_sheet);
+    _style_changed = true;
+    set_needs_restyle();
 }
 
 void Node::set_needs_restyle()
@@ -184,6 +305,21 @@ void Node::set_needs_restyle()
     set_needs_update();
 }
 
+void Node::set_needs_repaint()
+{
+    auto it = this;
+    while (it) {
+        if (it->_render_layer) {
+            it->_render_layer->set_dirty();
+            break;
+        }
+        it = it->_parent;
+    }
+    //
+    // the window only renders if damaged
+    redraw();
+}
+
 void Node::redraw()
 {
     if (_parent)
@@ -197,16 +333,13 @@ std::size_t Node::node_count()
 
 void Node::set_needs_update()
 {
-    auto it = this;
-    while (it) {
-        if (it->_render_layer) {
-            it->_render_layer->set_dirty();
-            break;
-        }
-        it = it->_parent;
-    }
+    set_needs_repaint();
+    _needs_measure = true;
     _needs_update = true;
-    it = _parent;
+    //
+    // ancestors are only marked for traversal. they re-measure
+    // if the measured size of this node actually changed
+    auto it = _parent;
     while (it) {
         if (it->_needs_update)
             break;
@@ -225,6 +358,11 @@ bool Node::needs_update() const
     return _needs_update;
 }
 
+std::uint64_t Node::update_generation() const
+{
+    return _update_generation;
+}
+
 void Node::set_parent(Node* parent)
 {
     _parent = parent;
@@ -244,6 +382,7 @@ void Node::add(std::shared_ptr<Node> node)
     node->set_parent(this);
     _children.push_back(std::move(node));
     _children.back()->set_needs_restyle();
+    children_changed();
 }
 
 void Node::insert(std::size_t index, std::shared_ptr<Node> node)
@@ -253,6 +392,7 @@ void Node::insert(std::size_t index, std::shared_ptr<Node> node)
     auto it = _children.begin();
     std::advance(it, index);
     (*_children.insert(it, std::move(node)))->set_needs_restyle();
+    children_changed();
 }
 
 void Node::remove(std::shared_ptr<Node> node)
@@ -263,6 +403,7 @@ void Node::remove(std::shared_ptr<Node> node)
         return item == node;
     }),
         _children.end());
+    children_changed();
     set_needs_update();
 }
 
@@ -281,6 +422,14 @@ std::shared_ptr<RenderLayer> const& Node::render_layer() const
     return _render_layer;
 }
 
+void Node::capture(Promise<Pixels> promise)
+{
+    if (!_render_layer)
+        throw std::runtime_error("cannot capture node without render layer");
+    _render_layer->capture(std::move(promise));
+    redraw();
+}
+
 std::shared_ptr<void> const& Node::user_data() const
 {
     return _user_data;
@@ -312,7 +461,7 @@ void Node::render(Context& context, float width, float height, bool adjust_works
     auto size = Size { width, height };
     if (size != _size) {
         if (_on_resize)
-            postpone([on_resize = _on_resize, size]() { on_resize(std::move(size)); });
+            postpone("on_resize", [on_resize = _on_resize, size]() { on_resize(std::move(size)); });
         std::swap(size, _size);
     }
 
@@ -442,6 +591,13 @@ void Node::set_visible(bool visible)
         return;
     _visible = visible;
     set_needs_restyle();
+    //
+    // invisible nodes are not traversed, so the parent is not
+    // informed about the change by the restyle pass itself
+    if (_parent) {
+        _parent->child_resized(*this);
+        _parent->set_needs_update();
+    }
 }
 
 bool Node::visible() const
@@ -486,7 +642,13 @@ Position Node::position() const
 
 void Node::set_position(Position position)
 {
+    if (_position == position)
+        return;
     _position = position;
+    if (_parent) {
+        _parent->child_resized(*this);
+        _parent->set_needs_update();
+    }
 }
 
 LengthPercentage Node::left() const
@@ -550,6 +712,8 @@ Node::MouseEvent::MouseEvent(Node* source)
     auto& last_rect = context.LastItemData.Rect;
     _x = _global_x - last_rect.Min.x;
     _y = _global_y - last_rect.Min.y;
+    _movement_x = context.IO.MouseDelta.x;
+    _movement_y = context.IO.MouseDelta.y;
     _left_button_down = context.IO.MouseDown[0];
     _right_button_down = context.IO.MouseDown[1];
     _middle_button_down = context.IO.MouseDown[2];
@@ -580,6 +744,16 @@ float Node::MouseEvent::y() const
     return _y;
 }
 
+float Node::MouseEvent::movement_x() const
+{
+    return _movement_x;
+}
+
+float Node::MouseEvent::movement_y() const
+{
+    return _movement_y;
+}
+
 bool Node::MouseEvent::left_button_down() const
 {
     return _left_button_down;
@@ -671,12 +845,21 @@ std::optional<Color> const& Node::color() const
 
 void Node::set_color(std::optional<Color> color)
 {
+    if (_color == color)
+        return;
     _color = std::move(color);
-    redraw();
+    //
+    // the color is in effect for the computed styles of the children
+    if (_children.empty())
+        set_needs_repaint();
+    else
+        set_needs_restyle();
 }
 
 void Node::push_style()
 {
+    if (_computed_style)
+        _computed_style->push();
     if (_color) {
         ImVec4 imgui_color;
         assign(imgui_color, _color.value());
@@ -689,6 +872,8 @@ void Node::pop_style()
     if (_color) {
         ImGui::PopStyleColor();
     }
+    if (_computed_style)
+        _computed_style->pop();
 }
 
 }
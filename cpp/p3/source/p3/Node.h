@@ -2,9 +2,11 @@
 #pragma once
 
 #include "color.h"
+#include "Promise.h"
 #include "RenderBackend.h"
 #include "StyleTypes.h"
 #include "on_scope_exit.h"
+#include "platform/event_loop.h"
 
 #include <array>
 #include <cstdint>
@@ -12,12 +14,15 @@
 #include <memory>
 #include <optional>
 #include <string>
+#include <string_view>
 #include <vector>
 
 namespace p3 {
 
+class ComputedStyle;
 class Context;
 class RenderLayer;
+class StyleSheet;
 
 template <typename T>
 using ref = std::shared_ptr<T>;
@@ -41,7 +46,7 @@ public:
 
     std::string const& element_name() const;
     // this is used by the loader to apply xml attributes
-    virtual void set_attribute(std::string const&, std::string const&);
+    virtual void set_attribute(std::string_view, std::string const&);
 
     // ###### composition ##################################################
 
@@ -61,6 +66,13 @@ public:
     /// do update/restyle pass for the whole tree
     virtual void update_restyle(Context& context, bool force);
 
+    std::optional<std::string> const& class_name() const;
+    void set_class_name(std::optional<std::string>);
+
+    /// rules for this node and its descendants, see StyleSheet
+    std::shared_ptr<StyleSheet> const& style_sheet() const;
+    void set_style_sheet(std::shared_ptr<StyleSheet>);
+
     float contextual_width(float available_width) const;
     float contextual_height(float available_height) const;
     float contextual_minimum_content_width() const;
@@ -118,6 +130,18 @@ public:
     void set_on_mouse_move(MouseEventHandler);
     MouseEventHandler on_mouse_move() const;
 
+    //
+    // mouse events are batched per frame: they are collected while
+    // rendering and delivered in one batch afterwards. the status of a
+    // node is updated once per frame, hence there is at most one move
+    // per frame, carrying the movement since the last frame.
+    // raw mouse events are posted one by one.
+    bool raw_mouse_events() const;
+    void set_raw_mouse_events(bool);
+
+    /// deliver the batched mouse events, see Context::dispatch_mouse_events
+    void dispatch_mouse_events();
+
     bool hovered() const;
 
     // ##### render ########################################################
@@ -143,6 +167,11 @@ public:
     void set_render_layer(std::shared_ptr<RenderLayer>);
     std::shared_ptr<RenderLayer> const& render_layer() const;
 
+    ///
+    /// captures the skia content of the render layer in the next frame,
+    /// requires a layered node, e.g. the user interface or a scroll area
+    void capture(Promise<Pixels>);
+
     std::shared_ptr<void> const& user_data() const;
     void set_user_data(std::shared_ptr<void>);
 
@@ -156,6 +185,14 @@ protected:
     // validate if node valid for beeing added to this, throws..
     virtual void before_add(Node&) const;
 
+    //
+    // containers indexing their children, e.g. by their heights, update
+    // only the entries of the children reported here
+    /// a child was added or removed
+    virtual void children_changed() { }
+    /// the measured size, the visibility or the position of a child changed
+    virtual void child_resized(Node&) { }
+
     //
     // layers will only be created on demand for user interfaces,
     // scrolls areas, popups and child windows.
@@ -163,6 +200,17 @@ protected:
 
     virtual void render_absolute(Context&);
 
+    //
+    // invalidation levels:
+    //   * repaint: only the owning render layer is dirty, e.g. a value
+    //     changed but the measured size stays the same
+    //   * update: this node needs to be re-measured (update_content()).
+    //     ancestors are re-measured only if the measured size changes
+    //   * restyle: the whole subtree needs to be restyled and re-measured
+
+    /// inform that this node needs to be repainted only
+    void set_needs_repaint();
+
     /// inform that this node needs to update it's actual values
     virtual void set_needs_update();
 
@@ -172,6 +220,9 @@ protected:
     bool needs_restyle() const;
     bool needs_update() const;
 
+    /// incremented whenever this node was re-measured or restyled
+    std::uint64_t update_generation() const;
+
     // TODO: make private
     float _automatic_width = 0.f;
     float _automatic_height = 0.f;
@@ -180,7 +231,13 @@ protected:
 
     void update_status();
     // TODO: remove this
-    void postpone(std::function<void()>);
+    template <typename F>
+    void postpone(char const* signal, F&& f)
+    {
+        auto event = Event::create(std::forward<F>(f));
+        event->set_origin(weak_from_this(), signal);
+        EventLoop::current()->call_at(EventLoop::Clock::now(), std::move(event));
+    }
 
     // node specific render implementation
     virtual void render_impl(Context&, float width, float height);
@@ -196,6 +253,20 @@ protected:
     virtual void pop_style();
 
 private:
+    enum class MouseEventType : std::uint8_t {
+        Enter,
+        Move,
+        Leave
+    };
+    void queue_mouse_event(MouseEventType, MouseEvent);
+    void queue_mouse_wheel(float);
+    void schedule_mouse_dispatch();
+
+    //
+    // recomputed only if the class, the style sheet or the
+    // style of the parent changed
+    void update_computed_style(Context&);
+
     std::string _element_name;
     std::optional<std::string> _class_name;
     std::optional<std::string> _label;
@@ -204,6 +275,10 @@ private:
 
     std::shared_ptr<RenderLayer> _render_layer;
 
+    std::shared_ptr<StyleSheet> _style_sheet;
+    std::shared_ptr<ComputedStyle const> _computed_style;
+    bool _style_changed = true;
+
     std::shared_ptr<Node> _tooltip;
     Node* _parent = nullptr;
     std::vector<std::shared_ptr<Node>> _children;
@@ -233,10 +308,16 @@ private:
         MouseEventHandler move;
         float x, y;
         std::function<void(float)> wheel;
+        bool raw = false;
+        bool scheduled = false;
+        std::vector<std::pair<MouseEventType, MouseEvent>> pending;
+        float pending_wheel = 0.f;
     } _mouse;
 
     bool _needs_update = true;
+    bool _needs_measure = true;
     bool _needs_restyle = true;
+    std::uint64_t _update_generation = 0;
 };
 
 class Node::MouseEvent {
@@ -254,6 +335,10 @@ public:
     float x() const;
     float y() const;
 
+    /// movement since the last frame
+    float movement_x() const;
+    float movement_y() const;
+
     bool left_button_down() const;
     bool right_button_down() const;
     bool middle_button_down() const;
@@ -264,6 +349,8 @@ private:
     float _global_y;
     float _x;
     float _y;
+    float _movement_x;
+    float _movement_y;
     bool _left_button_down;
     bool _middle_button_down;
     bool _right_button_down;
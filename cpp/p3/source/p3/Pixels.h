@@ -0,0 +1,28 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+namespace p3 {
+
+//
+// rgba pixels of a capture, rows from top to bottom. the buffer is owned,
+// such that it can be handed over without copying it
+struct Pixels {
+    std::uint32_t width = 0;
+    std::uint32_t height = 0;
+    std::unique_ptr<std::uint8_t[]> data;
+
+    Pixels() = default;
+    Pixels(std::uint32_t width, std::uint32_t height)
+        : width(width)
+        , height(height)
+        , data(new std::uint8_t[size()])
+    {
+    }
+
+    std::size_t size() const { return std::size_t(width) * height * 4; }
+};
+
+}
@@ -0,0 +1,101 @@
+#include "Profiler.h"
+
+#include <fmt/format.h>
+
+#include <fstream>
+#include <stdexcept>
+
+namespace p3 {
+
+namespace {
+
+    void append_escaped(std::string& out, char const* text)
+    {
+        for (; *text; ++text) {
+            if (*text == '"' || *text == '\\')
+                out.push_back('\\');
+            out.push_back(*text);
+        }
+    }
+
+}
+
+Profiler::Buffer& Profiler::buffer()
+{
+    thread_local std::shared_ptr<Buffer> buffer;
+    if (!buffer) {
+        buffer = std::make_shared<Buffer>();
+        buffer->zones.resize(Capacity);
+        std::lock_guard<std::mutex> l(_mutex);
+        buffer->thread = std::uint32_t(_buffers.size() + 1);
+        _buffers.push_back(buffer);
+    }
+    return *buffer;
+}
+
+void Profiler::start()
+{
+    std::lock_guard<std::mutex> l(_mutex);
+    _start = Clock::now();
+    _capture.fetch_add(1, std::memory_order_release);
+    _capturing = true;
+}
+
+void Profiler::stop()
+{
+    _capturing = false;
+}
+
+void Profiler::record(char const* name, TimePoint begin, TimePoint end)
+{
+    if (!capturing())
+        return;
+    auto& buffer = this->buffer();
+    auto const capture = _capture.load(std::memory_order_acquire);
+    if (buffer.capture.load(std::memory_order_relaxed) != capture) {
+        buffer.count.store(0, std::memory_order_relaxed);
+        buffer.capture.store(capture, std::memory_order_relaxed);
+    }
+    auto const count = buffer.count.load(std::memory_order_relaxed);
+    buffer.zones[count % Capacity] = Zone { name, begin, end };
+    buffer.count.store(count + 1, std::memory_order_release);
+}
+
+std::string Profiler::trace() const
+{
+    std::string out = "{\"traceEvents\":[";
+    bool first = true;
+    std::lock_guard<std::mutex> l(_mutex);
+    auto const capture = _capture.load(std::memory_order_relaxed);
+    for (auto const& buffer : _buffers) {
+        auto const count = buffer->count.load(std::memory_order_acquire);
+        if (buffer->capture.load(std::memory_order_relaxed) != capture)
+            continue;
+        for (auto i = count > Capacity ? count - Capacity : 0; i < count; ++i) {
+            auto const& zone = buffer->zones[i % Capacity];
+            //
+            // zones which started before the capture
+            if (zone.begin < _start)
+                continue;
+            out += first ? "{\"name\":\"" : ",{\"name\":\"";
+            first = false;
+            append_escaped(out, zone.name);
+            out += fmt::format("\",\"cat\":\"p3\",\"ph\":\"X\",\"pid\":1,\"tid\":{},\"ts\":{:.3f},\"dur\":{:.3f}}}",
+                buffer->thread,
+                std::chrono::duration<double, std::micro>(zone.begin - _start).count(),
+                std::chrono::duration<double, std::micro>(zone.end - zone.begin).count());
+        }
+    }
+    out += "],\"displayTimeUnit\":\"ms\"}";
+    return out;
+}
+
+void Profiler::save(std::string const& path) const
+{
+    std::ofstream file(path, std::ios::binary);
+    if (!file)
+        throw std::runtime_error(fmt::format("cannot open \"{}\"", path));
+    file << trace();
+}
+
+}
@@ -0,0 +1,113 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace p3 {
+
+/*
+ * scoped zone profiler. every thread records into its own ring buffer,
+ * hence recording does not lock. when no capture is running a zone costs
+ * a single relaxed load. the zones are exported in the chrome trace event
+ * format (chrome://tracing, perfetto). zones are compiled in only if
+ * P3_PROFILER is defined.
+ */
+class Profiler {
+public:
+    using Clock = std::chrono::steady_clock;
+    using TimePoint = Clock::time_point;
+
+    /// zones per thread, older zones are overwritten
+    static constexpr std::size_t Capacity = std::size_t(1) << 16;
+
+    struct Zone {
+        /// must outlive the profiler, e.g. a string literal
+        char const* name;
+        TimePoint begin;
+        TimePoint end;
+    };
+
+    class Scope;
+
+    static Profiler& instance()
+    {
+        //
+        // never destroyed, threads may record during static destruction
+        static auto profiler = new Profiler();
+        return *profiler;
+    }
+
+    /// discards previous zones and starts recording
+    void start();
+    void stop();
+    bool capturing() const { return _capturing.load(std::memory_order_relaxed); }
+
+    void record(char const* name, TimePoint begin, TimePoint end);
+
+    /// the captured zones as chrome trace event json. call after stop()
+    std::string trace() const;
+    void save(std::string const& path) const;
+
+private:
+    //
+    // written by the owning thread only. a buffer of an older capture
+    // is reset by its thread when it records the first zone of the
+    // current capture, and it is skipped by trace() until then
+    struct Buffer {
+        std::uint32_t thread;
+        std::vector<Zone> zones;
+        std::atomic<std::uint64_t> capture { 0 };
+        std::atomic<std::size_t> count { 0 };
+    };
+
+    Profiler() = default;
+    Buffer& buffer();
+
+    std::atomic<bool> _capturing { false };
+    /// incremented by start()
+    std::atomic<std::uint64_t> _capture { 0 };
+    TimePoint _start;
+
+    mutable std::mutex _mutex;
+    std::vector<std::shared_ptr<Buffer>> _buffers;
+};
+
+class Profiler::Scope {
+public:
+    explicit Scope(char const* name)
+        : _name(name)
+    {
+        if (Profiler::instance().capturing())
+            _begin = Clock::now();
+    }
+
+    ~Scope()
+    {
+        if (_begin != TimePoint {})
+            Profiler::instance().record(_name, _begin, Clock::now());
+    }
+
+    Scope(Scope const&) = delete;
+    Scope& operator=(Scope const&) = delete;
+
+private:
+    char const* _name;
+    TimePoint _begin {};
+};
+
+}
+
+#define P3_PROFILE_CONCAT_IMPL(a, b) a##b
+#define P3_PROFILE_CONCAT(a, b) P3_PROFILE_CONCAT_IMPL(a, b)
+
+#ifdef P3_PROFILER
+#define P3_PROFILE_ZONE(name) ::p3::Profiler::Scope P3_PROFILE_CONCAT(p3_profile_zone_, __LINE__)(name)
+#else
+#define P3_PROFILE_ZONE(name)
+#endif
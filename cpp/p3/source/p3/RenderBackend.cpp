@@ -1,6 +1,9 @@
 #include "RenderBackend.h"
 
+#include <p3/platform/event_loop.h>
+
 #include <algorithm>
+#include <stdexcept>
 
 namespace p3 {
 
@@ -26,6 +29,11 @@ void RenderBackend::gc()
 
 void RenderBackend::shutdown()
 {
+    //
+    // the synchronous captures are read already
+    if (!_captures.empty())
+        run_in_external_scope([&] { RenderBackend::poll_captures(); });
+    on_shutdown();
     _skia_context.reset();
     gc();
     _textures.clear();
@@ -42,6 +50,33 @@ void RenderBackend::delete_render_target(RenderTarget* render_target)
     _deleted_render_targets.push_back(render_target);
 }
 
+void RenderBackend::capture(RenderTarget* target, std::uint32_t width, std::uint32_t height, bool bottom_up, CaptureCallback callback)
+{
+    if (!target)
+        throw std::runtime_error("render backend cannot capture the default framebuffer");
+    Pixels pixels(width, height);
+    target->read_pixels(pixels.data.get(), bottom_up);
+    _captures.emplace_back(std::move(pixels), std::move(callback));
+}
+
+void RenderBackend::poll_captures()
+{
+    auto captures = std::move(_captures);
+    _captures.clear();
+    for (auto& [pixels, callback] : captures)
+        callback(std::move(pixels));
+}
+
+RenderBackend::CaptureCallback RenderBackend::resolve(Promise<Pixels> promise)
+{
+    return [promise = std::move(promise)](Pixels pixels) mutable {
+        if (pixels.data)
+            promise.set_value(std::move(pixels));
+        else
+            promise.set_exception(std::make_exception_ptr(std::runtime_error("capture failed")));
+    };
+}
+
 void RenderBackend::exec(std::function<void()>&& task)
 {
     _tasks.push_back(std::move(task));
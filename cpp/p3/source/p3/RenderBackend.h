@@ -1,11 +1,16 @@
 #pragma once
 
+#include <chrono>
 #include <cstdint>
 #include <functional>
 #include <memory>
+#include <optional>
 #include <string>
 #include <vector>
 
+#include "Pixels.h"
+#include "Promise.h"
+
 #include <include/core/SkSurface.h>
 #include <include/gpu/GrContext.h>
 
@@ -18,6 +23,7 @@ class UserInterface;
 class RenderBackend : public std::enable_shared_from_this<RenderBackend> {
 public:
     using TextureId = void*;
+    using CaptureCallback = std::function<void(Pixels)>;
 
     class RenderTarget {
     public:
@@ -30,6 +36,13 @@ public:
         virtual std::uint32_t width() const = 0;
         virtual std::uint32_t height() const = 0;
 
+        ///
+        /// copies width * height * 4 bytes of rgba, rows from top to bottom.
+        /// bottom_up tells that the content was rendered with the first row
+        /// at the bottom, as imgui renders into gl framebuffers. skia draws
+        /// with a top left origin, hence render layers are not bottom up
+        virtual void read_pixels(std::uint8_t* rgba, bool bottom_up) = 0;
+
         virtual sk_sp<SkSurface> const& skia_surface() const = 0;
     };
 
@@ -50,6 +63,28 @@ public:
     virtual RenderTarget* create_render_target(std::uint32_t width, std::uint32_t height) = 0;
     virtual std::uint32_t max_texture_size() const = 0;
 
+    //
+    // gpu time of the sections of a frame, e.g. layer flushes and the
+    // imgui submit. the sum is available frames later, resolve_gpu_time
+    // returns one frame per call until none is left
+    virtual void begin_gpu_section() { }
+    virtual void end_gpu_section() { }
+    virtual std::optional<std::chrono::nanoseconds> resolve_gpu_time() { return std::nullopt; }
+
+    //
+    // readback of the target, or of the default framebuffer if null, with
+    // the size of either, see RenderTarget::read_pixels for bottom_up.
+    // the copy is queued behind the rendered commands, poll_captures()
+    // invokes the callbacks of finished copies. captures which failed or
+    // were dropped on shutdown deliver empty pixels. this implementation
+    // reads targets synchronously
+    virtual void capture(RenderTarget*, std::uint32_t width, std::uint32_t height, bool bottom_up, CaptureCallback);
+    virtual void poll_captures();
+    virtual bool capturing() const { return !_captures.empty(); }
+
+    /// resolves the promise with the pixels, or rejects it if they are empty
+    static CaptureCallback resolve(Promise<Pixels>);
+
     void gc();
     void shutdown();
 
@@ -60,6 +95,9 @@ public:
     sk_sp<GrContext> const& skia_context() const { return _skia_context; }
 
 protected:
+    /// release resources while the context is still current
+    virtual void on_shutdown() { }
+
     std::vector<std::unique_ptr<Texture>> _textures;
     std::vector<std::unique_ptr<RenderTarget>> _render_targets;
     sk_sp<GrContext> _skia_context;
@@ -68,6 +106,7 @@ private:
     std::vector<Texture*> _deleted_textures;
     std::vector<RenderTarget*> _deleted_render_targets;
     std::vector<std::function<void()>> _tasks;
+    std::vector<std::pair<Pixels, CaptureCallback>> _captures;
 };
 
 }
@@ -1,11 +1,14 @@
 #include "RenderLayer.h"
 #include "Context.h"
 #include "Node.h"
+#include "Profiler.h"
 #include "log.h"
 
 #include <imgui.h>
 #include <imgui_internal.h>
 
+#include <stdexcept>
+
 #include <include/core/SkCanvas.h>
 
 namespace p3 {
@@ -19,6 +22,12 @@ namespace {
 RenderLayer::~RenderLayer()
 {
     reset();
+    if (!_captures.empty()) {
+        run_in_external_scope([&] {
+            for (auto& promise : _captures)
+                promise.set_exception(std::make_exception_ptr(std::runtime_error("render layer was destroyed")));
+        });
+    }
 }
 
 void RenderLayer::push_to(Context& context)
@@ -104,6 +113,13 @@ void RenderLayer::pop_from_context_and_render(Context& context, Node& node)
         if (context.show_render_layers())
             _draw_debug();
         reset();
+        if (!_captures.empty()) {
+            run_in_external_scope([&] {
+                for (auto& promise : _captures)
+                    promise.set_exception(std::make_exception_ptr(std::runtime_error("render layer is empty")));
+            });
+            _captures.clear();
+        }
         return;
     }
 
@@ -124,15 +140,23 @@ void RenderLayer::pop_from_context_and_render(Context& context, Node& node)
     //
     // need to redraw. bind rt and do the traversal
     if (_dirty) {
+        P3_PROFILE_ZONE("render_layer.flush");
         // log_info("rendering {} objects", _object_count);
+        backend.begin_gpu_section();
         auto& canvas = *_render_target->skia_surface()->getCanvas();
         _render_target->bind();
         canvas.clear(0x0000000);
         node.render(*_render_target);
         _render_target->skia_surface()->flushAndSubmit();
         _render_target->release();
+        backend.end_gpu_section();
         _dirty = false;
     }
+    for (auto& promise : _captures) {
+        backend.capture(_render_target, _render_target->width(), _render_target->height(), false,
+            RenderBackend::resolve(std::move(promise)));
+    }
+    _captures.clear();
 
     //
     // if fbo is present, add color buffer as texture
@@ -154,6 +178,11 @@ void RenderLayer::pop_from_context_and_render(Context& context, Node& node)
         _draw_debug();
 }
 
+void RenderLayer::capture(Promise<Pixels> promise)
+{
+    _captures.push_back(std::move(promise));
+}
+
 void RenderLayer::set_dirty()
 {
     _dirty = true;
@@ -1,5 +1,8 @@
+#include "Promise.h"
 #include "RenderBackend.h"
 
+#include <vector>
+
 class SkCanvas;
 
 namespace p3 {
@@ -36,6 +39,10 @@ public:
     Viewport const& viewport() const { return _viewport; }
     void reset();
 
+    ///
+    /// reads the target back once it was rendered in the next frame
+    void capture(Promise<Pixels>);
+
 private:
     void _draw_debug();
 
@@ -48,6 +55,7 @@ private:
 
     std::shared_ptr<RenderBackend> _render_backend = nullptr;
     RenderBackend::RenderTarget* _render_target = nullptr;
+    std::vector<Promise<Pixels>> _captures;
 };
 
 }
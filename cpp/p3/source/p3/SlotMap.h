@@ -0,0 +1,91 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+namespace p3 {
+
+//
+// dense, generational slot map. an id packs the slot index into the lower
+// and the generation of the slot into the upper 32 bits. releasing a slot
+// bumps its generation, so ids of released items never resolve again,
+// even if the slot gets reused. add/release/get are O(1) and never hash.
+template <typename T>
+class SlotMap {
+public:
+    using Id = std::uint64_t;
+
+    static constexpr std::uint32_t index(Id id) { return static_cast<std::uint32_t>(id); }
+    static constexpr std::uint32_t generation(Id id) { return static_cast<std::uint32_t>(id >> 32); }
+    static constexpr Id make_id(std::uint32_t index, std::uint32_t generation)
+    {
+        return (static_cast<Id>(generation) << 32) | index;
+    }
+
+    Id add(T value)
+    {
+        std::uint32_t index;
+        if (_free.empty()) {
+            index = static_cast<std::uint32_t>(_slots.size());
+            _slots.push_back(Slot { value, 0, true });
+        } else {
+            index = _free.back();
+            _free.pop_back();
+            auto& slot = _slots[index];
+            slot.value = value;
+            slot.occupied = true;
+        }
+        ++_size;
+        return make_id(index, _slots[index].generation);
+    }
+
+    /// returns false if the id is stale or unknown
+    bool release(Id id)
+    {
+        if (!contains(id))
+            return false;
+        auto& slot = _slots[index(id)];
+        slot.value = T {};
+        slot.occupied = false;
+        ++slot.generation;
+        _free.push_back(index(id));
+        --_size;
+        return true;
+    }
+
+    bool contains(Id id) const
+    {
+        auto i = index(id);
+        return i < _slots.size()
+            && _slots[i].occupied
+            && _slots[i].generation == generation(id);
+    }
+
+    /// returns a default constructed value for stale or unknown ids
+    T get(Id id) const
+    {
+        return contains(id) ? _slots[index(id)].value : T {};
+    }
+
+    std::size_t size() const { return _size; }
+    std::size_t capacity() const { return _slots.size(); }
+
+    void reserve(std::size_t capacity)
+    {
+        _slots.reserve(capacity);
+        _free.reserve(capacity);
+    }
+
+private:
+    struct Slot {
+        T value;
+        std::uint32_t generation;
+        bool occupied;
+    };
+
+    std::vector<Slot> _slots;
+    std::vector<std::uint32_t> _free;
+    std::size_t _size = 0;
+};
+
+}
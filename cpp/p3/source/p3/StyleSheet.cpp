@@ -0,0 +1,262 @@
+#include "StyleSheet.h"
+#include "Context.h"
+#include "Node.h"
+#include "convert.h"
+
+#include <p3/Parser.h>
+
+#include <fmt/format.h>
+#include <imgui.h>
+
+#include <algorithm>
+#include <cctype>
+#include <iterator>
+
+namespace p3 {
+
+namespace {
+
+    template <typename T>
+    void merge_value(std::optional<T>& value, std::optional<T> const& other)
+    {
+        if (other)
+            value = other;
+    }
+
+    bool is_identifier(std::string const& text)
+    {
+        return !text.empty() && std::all_of(text.begin(), text.end(), [](char c) {
+            return std::isalnum(static_cast<unsigned char>(c)) || c == '_' || c == '-';
+        });
+    }
+
+    std::string match_key(std::string const& element_name, std::optional<std::string> const& class_name)
+    {
+        return class_name ? element_name + '.' + class_name.value() : element_name;
+    }
+
+    enum class Kind : std::uint8_t {
+        Color,
+        Float,
+        Vec2
+    };
+
+    //
+    // imgui target of each property, in the order of ComputedStyle::Property
+    struct Target {
+        Kind kind;
+        int index;
+    };
+
+    constexpr Target targets[] = {
+        { Kind::Color, ImGuiCol_Text },
+        { Kind::Color, ImGuiCol_FrameBg },
+        { Kind::Color, ImGuiCol_Button },
+        { Kind::Color, ImGuiCol_Border },
+        { Kind::Float, ImGuiStyleVar_Alpha },
+        { Kind::Vec2, ImGuiStyleVar_FramePadding },
+        { Kind::Vec2, ImGuiStyleVar_ItemSpacing },
+        { Kind::Float, ImGuiStyleVar_FrameRounding },
+        { Kind::Float, ImGuiStyleVar_FrameBorderSize },
+    };
+    static_assert(std::size(targets) == std::size_t(ComputedStyle::Property::Count));
+
+    std::optional<ComputedStyle::Value> to_value(std::optional<Color> const& color)
+    {
+        if (!color)
+            return std::nullopt;
+        ImVec4 v;
+        assign(v, color.value());
+        return ComputedStyle::Value { v.x, v.y, v.z, v.w };
+    }
+
+    std::optional<ComputedStyle::Value> to_value(std::optional<float> const& value)
+    {
+        if (!value)
+            return std::nullopt;
+        return ComputedStyle::Value { value.value(), 0.f, 0.f, 0.f };
+    }
+
+    std::optional<ComputedStyle::Value> to_value(Context const& context, std::optional<Length> const& length)
+    {
+        if (!length)
+            return std::nullopt;
+        return ComputedStyle::Value { context.to_actual(length.value()), 0.f, 0.f, 0.f };
+    }
+
+    std::optional<ComputedStyle::Value> to_value(Context const& context, std::optional<Length2> const& length)
+    {
+        if (!length)
+            return std::nullopt;
+        return ComputedStyle::Value { context.to_actual(length.value()[0]), context.to_actual(length.value()[1]), 0.f, 0.f };
+    }
+
+}
+
+void StyleBlock::merge(StyleBlock const& other)
+{
+    merge_value(color, other.color);
+    merge_value(background_color, other.background_color);
+    merge_value(button_color, other.button_color);
+    merge_value(border_color, other.border_color);
+    merge_value(alpha, other.alpha);
+    merge_value(padding, other.padding);
+    merge_value(spacing, other.spacing);
+    merge_value(rounding, other.rounding);
+    merge_value(border_width, other.border_width);
+}
+
+StyleSheet::StyleSheet(std::vector<Rule> rules)
+    : _rules(std::move(rules))
+{
+    _selectors.reserve(_rules.size());
+    for (std::size_t i = 0; i < _rules.size(); ++i) {
+        auto const& text = _rules[i].selector;
+        Selector selector { std::nullopt, std::nullopt, 0 };
+        auto const dot = text.find('.');
+        auto const element_name = text.substr(0, dot);
+        if (!element_name.empty() && element_name != "*") {
+            if (!is_identifier(element_name))
+                throw parser::ParserError(fmt::format("invalid selector \"{}\"", text));
+            selector.element_name = element_name;
+            selector.specificity += 1;
+        }
+        if (dot != std::string::npos) {
+            auto const class_name = text.substr(dot + 1);
+            if (!is_identifier(class_name))
+                throw parser::ParserError(fmt::format("invalid selector \"{}\"", text));
+            selector.class_name = class_name;
+            selector.specificity += 10;
+        } else if (element_name.empty()) {
+            throw parser::ParserError("empty selector");
+        }
+        //
+        // rules are indexed by their most selective part
+        if (selector.class_name)
+            _by_class_name[selector.class_name.value()].push_back(i);
+        else if (selector.element_name)
+            _by_element_name[selector.element_name.value()].push_back(i);
+        else
+            _universal.push_back(i);
+        _selectors.push_back(std::move(selector));
+    }
+}
+
+std::vector<StyleSheet::Rule> const& StyleSheet::rules() const
+{
+    return _rules;
+}
+
+StyleBlock const& StyleSheet::match(std::string const& element_name, std::optional<std::string> const& class_name) const
+{
+    auto key = match_key(element_name, class_name);
+    auto it = _matches.find(key);
+    if (it != _matches.end())
+        return it->second;
+
+    std::vector<std::size_t> matched(_universal);
+    auto by_element_name = _by_element_name.find(element_name);
+    if (by_element_name != _by_element_name.end())
+        matched.insert(matched.end(), by_element_name->second.begin(), by_element_name->second.end());
+    if (class_name) {
+        auto by_class_name = _by_class_name.find(class_name.value());
+        if (by_class_name != _by_class_name.end())
+            for (auto index : by_class_name->second)
+                if (!_selectors[index].element_name || _selectors[index].element_name == element_name)
+                    matched.push_back(index);
+    }
+    std::sort(matched.begin(), matched.end(), [&](std::size_t a, std::size_t b) {
+        return _selectors[a].specificity == _selectors[b].specificity
+            ? a < b
+            : _selectors[a].specificity < _selectors[b].specificity;
+    });
+    StyleBlock block;
+    for (auto index : matched)
+        block.merge(_rules[index].block);
+    return _matches.emplace(std::move(key), std::move(block)).first->second;
+}
+
+std::shared_ptr<ComputedStyle const> ComputedStyle::compute(Node const& node, std::shared_ptr<ComputedStyle const> parent, Context& context)
+{
+    auto sheets = parent ? parent->_sheets : nullptr;
+    if (node.style_sheet()) {
+        auto nested = sheets ? std::make_shared<Sheets>(*sheets) : std::make_shared<Sheets>();
+        nested->push_back(node.style_sheet());
+        sheets = std::move(nested);
+    }
+    if (!sheets)
+        return nullptr;
+
+    StyleBlock block;
+    for (auto const& sheet : *sheets)
+        block.merge(sheet->match(node.element_name(), node.class_name()));
+
+    auto style = std::make_shared<ComputedStyle>();
+    style->_sheets = std::move(sheets);
+    style->_rem = context.rem();
+    style->_font_size = ImGui::GetFontSize();
+    std::array<std::optional<Value>, std::size_t(Property::Count)> declared {
+        to_value(block.color),
+        to_value(block.background_color),
+        to_value(block.button_color),
+        to_value(block.border_color),
+        to_value(block.alpha),
+        to_value(context, block.padding),
+        to_value(context, block.spacing),
+        to_value(context, block.rounding),
+        to_value(context, block.border_width),
+    };
+    if (parent)
+        style->_values = parent->_values;
+    //
+    // the inline color is pushed after the style of the parent
+    if (node.parent())
+        style->_parent_color = node.parent()->color();
+    if (style->_parent_color)
+        style->_values[std::size_t(Property::Color)] = to_value(style->_parent_color);
+    for (std::size_t i = 0; i < declared.size(); ++i) {
+        if (!declared[i] || style->_values[i] == declared[i])
+            continue;
+        style->_values[i] = declared[i];
+        style->_pushes.emplace_back(Property(i), declared[i].value());
+        if (targets[i].kind == Kind::Color)
+            ++style->_pushed_colors;
+        else
+            ++style->_pushed_vars;
+    }
+    style->_parent = std::move(parent);
+    return style;
+}
+
+bool ComputedStyle::up_to_date(ComputedStyle const* parent, std::optional<Color> const& parent_color, float rem, float font_size) const
+{
+    return _parent.get() == parent && _parent_color == parent_color && _rem == rem && _font_size == font_size;
+}
+
+void ComputedStyle::push() const
+{
+    for (auto const& [property, value] : _pushes) {
+        auto const& target = targets[std::size_t(property)];
+        switch (target.kind) {
+        case Kind::Color:
+            ImGui::PushStyleColor(target.index, ImVec4(value[0], value[1], value[2], value[3]));
+            break;
+        case Kind::Float:
+            ImGui::PushStyleVar(target.index, value[0]);
+            break;
+        case Kind::Vec2:
+            ImGui::PushStyleVar(target.index, ImVec2(value[0], value[1]));
+            break;
+        }
+    }
+}
+
+void ComputedStyle::pop() const
+{
+    if (_pushed_colors)
+        ImGui::PopStyleColor(_pushed_colors);
+    if (_pushed_vars)
+        ImGui::PopStyleVar(_pushed_vars);
+}
+
+}
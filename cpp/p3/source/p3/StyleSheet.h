@@ -0,0 +1,119 @@
+#pragma once
+
+#include "Color.h"
+#include "StyleTypes.h"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace p3 {
+
+class Context;
+class Node;
+
+//
+// declarations of a rule. unset values are inherited from the
+// enclosing nodes, eventually from the theme
+struct StyleBlock {
+    std::optional<Color> color;
+    std::optional<Color> background_color;
+    std::optional<Color> button_color;
+    std::optional<Color> border_color;
+    std::optional<float> alpha;
+    std::optional<Length2> padding;
+    std::optional<Length2> spacing;
+    std::optional<Length> rounding;
+    std::optional<Length> border_width;
+
+    /// takes the values which are set in other
+    void merge(StyleBlock const& other);
+};
+
+/*
+ * rules for a subtree, matched on element name and class. selectors are
+ * "*", "Element", ".class" or "Element.class", the more specific rule
+ * wins, equally specific rules are applied in order. sheets are not
+ * modified once created, nested sheets override the enclosing ones.
+ */
+class StyleSheet {
+public:
+    struct Rule {
+        std::string selector;
+        StyleBlock block;
+    };
+
+    /// compiles the selectors, throws parser::ParserError on invalid ones
+    explicit StyleSheet(std::vector<Rule>);
+
+    std::vector<Rule> const& rules() const;
+
+    /// declarations of all matching rules, cached per element name and class
+    StyleBlock const& match(std::string const& element_name, std::optional<std::string> const& class_name) const;
+
+private:
+    struct Selector {
+        std::optional<std::string> element_name;
+        std::optional<std::string> class_name;
+        int specificity;
+    };
+
+    std::vector<Rule> _rules;
+    std::vector<Selector> _selectors;
+    std::vector<std::size_t> _universal;
+    std::unordered_map<std::string, std::vector<std::size_t>> _by_element_name;
+    std::unordered_map<std::string, std::vector<std::size_t>> _by_class_name;
+    mutable std::unordered_map<std::string, StyleBlock> _matches;
+};
+
+/*
+ * style of a node resolved from the sheets of its ancestors. it holds the
+ * values in effect for the subtree and the pushes which differ from the
+ * ones of the parent, hence rendering pushes only what changes. the
+ * inline color of the parent (Node::color) overrides its text color.
+ */
+class ComputedStyle {
+public:
+    enum class Property : std::uint8_t {
+        Color,
+        BackgroundColor,
+        ButtonColor,
+        BorderColor,
+        Alpha,
+        Padding,
+        Spacing,
+        Rounding,
+        BorderWidth,
+        Count
+    };
+    using Value = std::array<float, 4>;
+
+    /// nullptr if no style sheet applies to the node
+    static std::shared_ptr<ComputedStyle const> compute(Node const&, std::shared_ptr<ComputedStyle const> parent, Context&);
+
+    /// false if the parent was recomputed, its inline color changed or lengths resolve differently
+    bool up_to_date(ComputedStyle const* parent, std::optional<Color> const& parent_color, float rem, float font_size) const;
+
+    void push() const;
+    void pop() const;
+
+private:
+    using Sheets = std::vector<std::shared_ptr<StyleSheet>>;
+
+    std::shared_ptr<ComputedStyle const> _parent;
+    std::shared_ptr<Sheets const> _sheets;
+    std::optional<Color> _parent_color;
+    float _rem = 0.f;
+    float _font_size = 0.f;
+    std::array<std::optional<Value>, std::size_t(Property::Count)> _values;
+    std::vector<std::pair<Property, Value>> _pushes;
+    int _pushed_colors = 0;
+    int _pushed_vars = 0;
+};
+
+}
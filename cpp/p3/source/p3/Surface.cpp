@@ -68,7 +68,7 @@ void Surface::render_impl(Context& context, float fwidth, float fheight)
     if (viewport != _viewport) {
         _viewport = viewport;
         if (_on_viewport_change)
-            postpone([f = _on_viewport_change, rect = viewport]() {
+            postpone("on_viewport_change", [f = _on_viewport_change, rect = viewport]() {
                 f(rect);
             });
     }
@@ -85,7 +85,7 @@ void Surface::render_impl(Context& context, float fwidth, float fheight)
     bool hovered, held;
     bool pressed = ImGui::ButtonBehavior(bb, id, &hovered, &held, 0);
     if (pressed && _on_click && !disabled())
-        postpone([f = _on_click]() {
+        postpone("on_click", [f = _on_click]() {
             f();
         });
     update_status();
@@ -34,9 +34,12 @@ void Text::render_impl(Context& context, float width, float height)
 
 void Text::set_value(std::string value)
 {
+    if (_value == value)
+        return;
     _value = std::move(value);
+    //
+    // re-measures this node only. ancestors follow if the size changed
     set_needs_update();
-    std::optional<float> x;
 }
 
 std::string const& Text::value() const
@@ -1,12 +1,16 @@
 #include "Theme.h"
 #include "Context.h"
 #include "convert.h"
+#include "log.h"
 
 #include <imgui.h>
 #include <imgui_internal.h>
 #include <implot.h>
 #include <implot_internal.h>
 
+#include <cstddef>
+#include <cstring>
+
 namespace p3 {
 
 namespace {
@@ -21,8 +25,105 @@ namespace {
         return ImVec2(value[0], value[1]);
     }
 
+    //
+    // a field of a style struct which is written by the theme
+    struct Field {
+        std::size_t offset;
+        std::size_t size;
+    };
+
+#define P3_STYLE_FIELD(Style, member) \
+    Field { offsetof(Style, member), sizeof(Style::member) }
+
+    //
+    // previous value of a field which was overwritten
+    struct Delta {
+        void* address;
+        std::size_t size;
+        std::array<char, sizeof(ImVec4)> value;
+    };
+
+    std::vector<Field> const& im_gui_fields()
+    {
+        static auto const fields = []() {
+            std::vector<Field> fields {
+                P3_STYLE_FIELD(ImGuiStyle, Alpha),
+                P3_STYLE_FIELD(ImGuiStyle, WindowPadding),
+                P3_STYLE_FIELD(ImGuiStyle, WindowRounding),
+                P3_STYLE_FIELD(ImGuiStyle, WindowBorderSize),
+                P3_STYLE_FIELD(ImGuiStyle, WindowMinSize),
+                P3_STYLE_FIELD(ImGuiStyle, WindowTitleAlign),
+                P3_STYLE_FIELD(ImGuiStyle, ChildRounding),
+                P3_STYLE_FIELD(ImGuiStyle, ChildBorderSize),
+                P3_STYLE_FIELD(ImGuiStyle, PopupRounding),
+                P3_STYLE_FIELD(ImGuiStyle, PopupBorderSize),
+                P3_STYLE_FIELD(ImGuiStyle, FramePadding),
+                P3_STYLE_FIELD(ImGuiStyle, FrameRounding),
+                P3_STYLE_FIELD(ImGuiStyle, FrameBorderSize),
+                P3_STYLE_FIELD(ImGuiStyle, ItemSpacing),
+                P3_STYLE_FIELD(ImGuiStyle, ItemInnerSpacing),
+                P3_STYLE_FIELD(ImGuiStyle, IndentSpacing),
+                P3_STYLE_FIELD(ImGuiStyle, CellPadding),
+                P3_STYLE_FIELD(ImGuiStyle, ScrollbarSize),
+                P3_STYLE_FIELD(ImGuiStyle, ScrollbarRounding),
+                P3_STYLE_FIELD(ImGuiStyle, GrabMinSize),
+                P3_STYLE_FIELD(ImGuiStyle, GrabRounding),
+                P3_STYLE_FIELD(ImGuiStyle, TabRounding),
+                P3_STYLE_FIELD(ImGuiStyle, ButtonTextAlign),
+                P3_STYLE_FIELD(ImGuiStyle, SelectableTextAlign),
+                P3_STYLE_FIELD(ImGuiStyle, AntiAliasedLines),
+                P3_STYLE_FIELD(ImGuiStyle, AntiAliasedFill),
+            };
+            for (std::size_t i = 0; i < ImGuiCol_COUNT; ++i)
+                fields.push_back(Field { offsetof(ImGuiStyle, Colors) + i * sizeof(ImVec4), sizeof(ImVec4) });
+            return fields;
+        }();
+        return fields;
+    }
+
+    std::vector<Field> const& im_plot_fields()
+    {
+        static auto const fields = []() {
+            std::vector<Field> fields {
+                P3_STYLE_FIELD(ImPlotStyle, LineWeight),
+                P3_STYLE_FIELD(ImPlotStyle, PlotPadding),
+            };
+            for (std::size_t i = 0; i < ImPlotCol_COUNT; ++i)
+                fields.push_back(Field { offsetof(ImPlotStyle, Colors) + i * sizeof(ImVec4), sizeof(ImVec4) });
+            return fields;
+        }();
+        return fields;
+    }
+
+#undef P3_STYLE_FIELD
+
+    //
+    // copies the fields which differ and remembers their previous values
+    template <typename Style>
+    void apply(Style* current, Style const* compiled, std::vector<Field> const& fields, std::vector<Delta>& deltas)
+    {
+        auto target = reinterpret_cast<char*>(current);
+        auto source = reinterpret_cast<char const*>(compiled);
+        for (auto const& field : fields) {
+            if (std::memcmp(target + field.offset, source + field.offset, field.size) == 0)
+                continue;
+            Delta delta { target + field.offset, field.size, {} };
+            std::memcpy(delta.value.data(), delta.address, field.size);
+            deltas.push_back(delta);
+            std::memcpy(delta.address, source + field.offset, field.size);
+        }
+    }
+
 }
 
+struct Theme::Compiled {
+    std::uint64_t version;
+    float rem;
+    float font_size;
+    ImGuiStyle im_gui_style;
+    ImPlotStyle im_plot_style;
+};
+
 void Theme::add_observer(Observer* observer)
 {
     _observer.push_back(observer);
@@ -38,115 +139,133 @@ void Theme::remove_observer(Observer* observer)
 
 Theme::ApplyFunction Theme::compile(Context const& context)
 {
-    auto im_gui_style = std::make_shared<ImGuiStyle>();
-    im_gui_style->Alpha = _alpha;
-    im_gui_style->WindowPadding = to_actual(context, _window_padding);
-    im_gui_style->WindowRounding = context.to_actual(_window_rounding);
-    im_gui_style->WindowBorderSize = context.to_actual(_window_border_size);
-    im_gui_style->WindowMinSize = to_actual(context, _window_min_size);
-    im_gui_style->WindowTitleAlign = to_actual(context, _window_title_align);
-    im_gui_style->ChildRounding = context.to_actual(_child_rounding);
-    im_gui_style->ChildBorderSize = context.to_actual(_child_border_size);
-    im_gui_style->PopupRounding = context.to_actual(_popup_rounding);
-    im_gui_style->PopupBorderSize = context.to_actual(_popup_border_size);
-    im_gui_style->FramePadding = to_actual(context, _frame_padding);
-    im_gui_style->FrameRounding = context.to_actual(_frame_rounding);
-    im_gui_style->FrameBorderSize = context.to_actual(_frame_border_size);
-    im_gui_style->ItemSpacing = to_actual(context, _item_spacing);
-    im_gui_style->ItemInnerSpacing = to_actual(context, _item_inner_spacing);
-    im_gui_style->IndentSpacing = context.to_actual(_indent_spacing);
-    im_gui_style->CellPadding = to_actual(context, _cell_padding);
-    im_gui_style->ScrollbarSize = context.to_actual(_scrollbar_size);
-    im_gui_style->ScrollbarRounding = context.to_actual(_scrollbar_rounding);
-    im_gui_style->GrabMinSize = context.to_actual(_grab_min_size);
-    im_gui_style->GrabRounding = context.to_actual(_grab_rounding);
-    im_gui_style->TabRounding = context.to_actual(_tab_rounding);
-    im_gui_style->ButtonTextAlign = to_actual(context, _button_text_align);
-    im_gui_style->SelectableTextAlign = to_actual(context, _selectable_text_align);
-    assign(im_gui_style->Colors[ImGuiCol_Text], _text_color);
-    assign(im_gui_style->Colors[ImGuiCol_TextDisabled], _text_disabled_color);
-    assign(im_gui_style->Colors[ImGuiCol_WindowBg], _window_background_color);
-    assign(im_gui_style->Colors[ImGuiCol_ChildBg], _child_background_color);
-    assign(im_gui_style->Colors[ImGuiCol_PopupBg], _popup_background_color);
-    assign(im_gui_style->Colors[ImGuiCol_Border], _border_color);
-    assign(im_gui_style->Colors[ImGuiCol_BorderShadow], _border_shadow_color);
-    assign(im_gui_style->Colors[ImGuiCol_FrameBg], _frame_background_color);
-    assign(im_gui_style->Colors[ImGuiCol_FrameBgHovered], _frame_background_hovered_color);
-    assign(im_gui_style->Colors[ImGuiCol_FrameBgActive], _frame_background_active_color);
-    assign(im_gui_style->Colors[ImGuiCol_TitleBg], _title_background_color);
-    assign(im_gui_style->Colors[ImGuiCol_TitleBgActive], _title_background_active_color);
-    assign(im_gui_style->Colors[ImGuiCol_TitleBgCollapsed], _title_background_collapsed_color);
-    assign(im_gui_style->Colors[ImGuiCol_MenuBarBg], _menu_bar_background_color);
-    assign(im_gui_style->Colors[ImGuiCol_ScrollbarBg], _scrollbar_background_color);
-    assign(im_gui_style->Colors[ImGuiCol_ScrollbarGrab], _scrollbar_grab_color);
-    assign(im_gui_style->Colors[ImGuiCol_ScrollbarGrabHovered], _scrollbar_grab_hovered_color);
-    assign(im_gui_style->Colors[ImGuiCol_ScrollbarGrabActive], _scrollbar_grab_active_color);
-    assign(im_gui_style->Colors[ImGuiCol_CheckMark], _check_mark_color);
-    assign(im_gui_style->Colors[ImGuiCol_SliderGrab], _slider_grab_color);
-    assign(im_gui_style->Colors[ImGuiCol_SliderGrabActive], _slider_grab_active_color);
-    assign(im_gui_style->Colors[ImGuiCol_Button], _button_color);
-    assign(im_gui_style->Colors[ImGuiCol_ButtonHovered], _button_hovered_color);
-    assign(im_gui_style->Colors[ImGuiCol_ButtonActive], _button_active_color);
-    assign(im_gui_style->Colors[ImGuiCol_Header], _header_color);
-    assign(im_gui_style->Colors[ImGuiCol_PlotHistogram], _progress_bar_color);
-    assign(im_gui_style->Colors[ImGuiCol_HeaderHovered], _header_hovered_color);
-    assign(im_gui_style->Colors[ImGuiCol_HeaderActive], _header_active_color);
-    assign(im_gui_style->Colors[ImGuiCol_Separator], _separator_color);
-    assign(im_gui_style->Colors[ImGuiCol_SeparatorHovered], _separator_hovered_color);
-    assign(im_gui_style->Colors[ImGuiCol_SeparatorActive], _separator_active_color);
-    assign(im_gui_style->Colors[ImGuiCol_ResizeGrip], _resize_grip_color);
-    assign(im_gui_style->Colors[ImGuiCol_ResizeGripHovered], _resize_grip_hovered_color);
-    assign(im_gui_style->Colors[ImGuiCol_ResizeGripActive], _resize_grip_active_color);
-    assign(im_gui_style->Colors[ImGuiCol_Tab], _tab_color);
-    assign(im_gui_style->Colors[ImGuiCol_TabHovered], _tab_hovered_color);
-    assign(im_gui_style->Colors[ImGuiCol_TabActive], _tab_active_color);
-    assign(im_gui_style->Colors[ImGuiCol_TabUnfocused], _tab_unfocused_color);
-    assign(im_gui_style->Colors[ImGuiCol_TabUnfocusedActive], _tab_unfocused_active_color);
-    assign(im_gui_style->Colors[ImGuiCol_TableHeaderBg], _table_header_background_color);
-    assign(im_gui_style->Colors[ImGuiCol_TableBorderStrong], _table_border_strong_color);
-    assign(im_gui_style->Colors[ImGuiCol_TableBorderLight], _table_border_light_color);
-    assign(im_gui_style->Colors[ImGuiCol_TableRowBg], _table_row_background_color);
-    assign(im_gui_style->Colors[ImGuiCol_TableRowBgAlt], _table_row_background_alt_color);
-    assign(im_gui_style->Colors[ImGuiCol_TextSelectedBg], _text_selected_background_color);
-    assign(im_gui_style->Colors[ImGuiCol_DragDropTarget], _drag_drop_target_color);
-    assign(im_gui_style->Colors[ImGuiCol_NavHighlight], _nav_highlight_color);
-    assign(im_gui_style->Colors[ImGuiCol_NavWindowingHighlight], _nav_windowing_highlight_color);
-    assign(im_gui_style->Colors[ImGuiCol_NavWindowingDimBg], _nav_windowing_dim_background_color);
-    assign(im_gui_style->Colors[ImGuiCol_ModalWindowDimBg], _modal_window_dim_background_color);
-
-    auto im_plot_style = std::make_shared<ImPlotStyle>();
-    assign(im_plot_style->Colors[ImPlotCol_Line], _plot_line_color);
-    assign(im_plot_style->Colors[ImPlotCol_Fill], _plot_fill_color);
-    assign(im_plot_style->Colors[ImPlotCol_MarkerOutline], _plot_marker_outline_color);
-    assign(im_plot_style->Colors[ImPlotCol_MarkerFill], _plot_marker_fill_color);
-    assign(im_plot_style->Colors[ImPlotCol_ErrorBar], _plot_error_bar_color);
-    assign(im_plot_style->Colors[ImPlotCol_FrameBg], _plot_frame_background_color);
-    assign(im_plot_style->Colors[ImPlotCol_PlotBg], _plot_background_color);
-    assign(im_plot_style->Colors[ImPlotCol_PlotBorder], _plot_border_color);
-    assign(im_plot_style->Colors[ImPlotCol_LegendBg], _plot_legend_background_color);
-    assign(im_plot_style->Colors[ImPlotCol_LegendBorder], _plot_legend_border_color);
-    assign(im_plot_style->Colors[ImPlotCol_LegendText], _plot_legend_text_color);
-    assign(im_plot_style->Colors[ImPlotCol_TitleText], _plot_title_text_color);
-    assign(im_plot_style->Colors[ImPlotCol_InlayText], _plot_inlay_text_color);
-    assign(im_plot_style->Colors[ImPlotCol_AxisText], _plot_axis_color);
-    assign(im_plot_style->Colors[ImPlotCol_AxisGrid], _plot_axis_grid_color);
-    assign(im_plot_style->Colors[ImPlotCol_Selection], _plot_selection_color);
-    assign(im_plot_style->Colors[ImPlotCol_Crosshairs], _plot_crosshairs_color);
-    im_plot_style->LineWeight = _plot_line_weight;
-    im_plot_style->PlotPadding = im_gui_style->FramePadding;
-    im_gui_style->AntiAliasedLines = true;
-    im_gui_style->AntiAliasedFill = true;
-    auto apply = [im_gui_style { std::move(im_gui_style) }, im_plot_style { std::move(im_plot_style) }]() mutable {
+    auto const rem = context.rem();
+    auto const font_size = ImGui::GetFontSize();
+    if (!_compiled || _compiled->version != _version || _compiled->rem != rem || _compiled->font_size != font_size) {
+        log_verbose("-style- compile theme");
+        auto compiled = std::make_shared<Compiled>();
+        compiled->version = _version;
+        compiled->rem = rem;
+        compiled->font_size = font_size;
+        auto& im_gui_style = compiled->im_gui_style;
+        im_gui_style.Alpha = _alpha;
+        im_gui_style.WindowPadding = to_actual(context, _window_padding);
+        im_gui_style.WindowRounding = context.to_actual(_window_rounding);
+        im_gui_style.WindowBorderSize = context.to_actual(_window_border_size);
+        im_gui_style.WindowMinSize = to_actual(context, _window_min_size);
+        im_gui_style.WindowTitleAlign = to_actual(context, _window_title_align);
+        im_gui_style.ChildRounding = context.to_actual(_child_rounding);
+        im_gui_style.ChildBorderSize = context.to_actual(_child_border_size);
+        im_gui_style.PopupRounding = context.to_actual(_popup_rounding);
+        im_gui_style.PopupBorderSize = context.to_actual(_popup_border_size);
+        im_gui_style.FramePadding = to_actual(context, _frame_padding);
+        im_gui_style.FrameRounding = context.to_actual(_frame_rounding);
+        im_gui_style.FrameBorderSize = context.to_actual(_frame_border_size);
+        im_gui_style.ItemSpacing = to_actual(context, _item_spacing);
+        im_gui_style.ItemInnerSpacing = to_actual(context, _item_inner_spacing);
+        im_gui_style.IndentSpacing = context.to_actual(_indent_spacing);
+        im_gui_style.CellPadding = to_actual(context, _cell_padding);
+        im_gui_style.ScrollbarSize = context.to_actual(_scrollbar_size);
+        im_gui_style.ScrollbarRounding = context.to_actual(_scrollbar_rounding);
+        im_gui_style.GrabMinSize = context.to_actual(_grab_min_size);
+        im_gui_style.GrabRounding = context.to_actual(_grab_rounding);
+        im_gui_style.TabRounding = context.to_actual(_tab_rounding);
+        im_gui_style.ButtonTextAlign = to_actual(context, _button_text_align);
+        im_gui_style.SelectableTextAlign = to_actual(context, _selectable_text_align);
+        assign(im_gui_style.Colors[ImGuiCol_Text], _text_color);
+        assign(im_gui_style.Colors[ImGuiCol_TextDisabled], _text_disabled_color);
+        assign(im_gui_style.Colors[ImGuiCol_WindowBg], _window_background_color);
+        assign(im_gui_style.Colors[ImGuiCol_ChildBg], _child_background_color);
+        assign(im_gui_style.Colors[ImGuiCol_PopupBg], _popup_background_color);
+        assign(im_gui_style.Colors[ImGuiCol_Border], _border_color);
+        assign(im_gui_style.Colors[ImGuiCol_BorderShadow], _border_shadow_color);
+        assign(im_gui_style.Colors[ImGuiCol_FrameBg], _frame_background_color);
+        assign(im_gui_style.Colors[ImGuiCol_FrameBgHovered], _frame_background_hovered_color);
+        assign(im_gui_style.Colors[ImGuiCol_FrameBgActive], _frame_background_active_color);
+        assign(im_gui_style.Colors[ImGuiCol_TitleBg], _title_background_color);
+        assign(im_gui_style.Colors[ImGuiCol_TitleBgActive], _title_background_active_color);
+        assign(im_gui_style.Colors[ImGuiCol_TitleBgCollapsed], _title_background_collapsed_color);
+        assign(im_gui_style.Colors[ImGuiCol_MenuBarBg], _menu_bar_background_color);
+        assign(im_gui_style.Colors[ImGuiCol_ScrollbarBg], _scrollbar_background_color);
+        assign(im_gui_style.Colors[ImGuiCol_ScrollbarGrab], _scrollbar_grab_color);
+        assign(im_gui_style.Colors[ImGuiCol_ScrollbarGrabHovered], _scrollbar_grab_hovered_color);
+        assign(im_gui_style.Colors[ImGuiCol_ScrollbarGrabActive], _scrollbar_grab_active_color);
+        assign(im_gui_style.Colors[ImGuiCol_CheckMark], _check_mark_color);
+        assign(im_gui_style.Colors[ImGuiCol_SliderGrab], _slider_grab_color);
+        assign(im_gui_style.Colors[ImGuiCol_SliderGrabActive], _slider_grab_active_color);
+        assign(im_gui_style.Colors[ImGuiCol_Button], _button_color);
+        assign(im_gui_style.Colors[ImGuiCol_ButtonHovered], _button_hovered_color);
+        assign(im_gui_style.Colors[ImGuiCol_ButtonActive], _button_active_color);
+        assign(im_gui_style.Colors[ImGuiCol_Header], _header_color);
+        assign(im_gui_style.Colors[ImGuiCol_PlotHistogram], _progress_bar_color);
+        assign(im_gui_style.Colors[ImGuiCol_HeaderHovered], _header_hovered_color);
+        assign(im_gui_style.Colors[ImGuiCol_HeaderActive], _header_active_color);
+        assign(im_gui_style.Colors[ImGuiCol_Separator], _separator_color);
+        assign(im_gui_style.Colors[ImGuiCol_SeparatorHovered], _separator_hovered_color);
+        assign(im_gui_style.Colors[ImGuiCol_SeparatorActive], _separator_active_color);
+        assign(im_gui_style.Colors[ImGuiCol_ResizeGrip], _resize_grip_color);
+        assign(im_gui_style.Colors[ImGuiCol_ResizeGripHovered], _resize_grip_hovered_color);
+        assign(im_gui_style.Colors[ImGuiCol_ResizeGripActive], _resize_grip_active_color);
+        assign(im_gui_style.Colors[ImGuiCol_Tab], _tab_color);
+        assign(im_gui_style.Colors[ImGuiCol_TabHovered], _tab_hovered_color);
+        assign(im_gui_style.Colors[ImGuiCol_TabActive], _tab_active_color);
+        assign(im_gui_style.Colors[ImGuiCol_TabUnfocused], _tab_unfocused_color);
+        assign(im_gui_style.Colors[ImGuiCol_TabUnfocusedActive], _tab_unfocused_active_color);
+        assign(im_gui_style.Colors[ImGuiCol_TableHeaderBg], _table_header_background_color);
+        assign(im_gui_style.Colors[ImGuiCol_TableBorderStrong], _table_border_strong_color);
+        assign(im_gui_style.Colors[ImGuiCol_TableBorderLight], _table_border_light_color);
+        assign(im_gui_style.Colors[ImGuiCol_TableRowBg], _table_row_background_color);
+        assign(im_gui_style.Colors[ImGuiCol_TableRowBgAlt], _table_row_background_alt_color);
+        assign(im_gui_style.Colors[ImGuiCol_TextSelectedBg], _text_selected_background_color);
+        assign(im_gui_style.Colors[ImGuiCol_DragDropTarget], _drag_drop_target_color);
+        assign(im_gui_style.Colors[ImGuiCol_NavHighlight], _nav_highlight_color);
+        assign(im_gui_style.Colors[ImGuiCol_NavWindowingHighlight], _nav_windowing_highlight_color);
+        assign(im_gui_style.Colors[ImGuiCol_NavWindowingDimBg], _nav_windowing_dim_background_color);
+        assign(im_gui_style.Colors[ImGuiCol_ModalWindowDimBg], _modal_window_dim_background_color);
+
+        auto& im_plot_style = compiled->im_plot_style;
+        assign(im_plot_style.Colors[ImPlotCol_Line], _plot_line_color);
+        assign(im_plot_style.Colors[ImPlotCol_Fill], _plot_fill_color);
+        assign(im_plot_style.Colors[ImPlotCol_MarkerOutline], _plot_marker_outline_color);
+        assign(im_plot_style.Colors[ImPlotCol_MarkerFill], _plot_marker_fill_color);
+        assign(im_plot_style.Colors[ImPlotCol_ErrorBar], _plot_error_bar_color);
+        assign(im_plot_style.Colors[ImPlotCol_FrameBg], _plot_frame_background_color);
+        assign(im_plot_style.Colors[ImPlotCol_PlotBg], _plot_background_color);
+        assign(im_plot_style.Colors[ImPlotCol_PlotBorder], _plot_border_color);
+        assign(im_plot_style.Colors[ImPlotCol_LegendBg], _plot_legend_background_color);
+        assign(im_plot_style.Colors[ImPlotCol_LegendBorder], _plot_legend_border_color);
+        assign(im_plot_style.Colors[ImPlotCol_LegendText], _plot_legend_text_color);
+        assign(im_plot_style.Colors[ImPlotCol_TitleText], _plot_title_text_color);
+        assign(im_plot_style.Colors[ImPlotCol_InlayText], _plot_inlay_text_color);
+        assign(im_plot_style.Colors[ImPlotCol_AxisText], _plot_axis_color);
+        assign(im_plot_style.Colors[ImPlotCol_AxisGrid], _plot_axis_grid_color);
+        assign(im_plot_style.Colors[ImPlotCol_Selection], _plot_selection_color);
+        assign(im_plot_style.Colors[ImPlotCol_Crosshairs], _plot_crosshairs_color);
+        im_plot_style.LineWeight = _plot_line_weight;
+        im_plot_style.PlotPadding = im_gui_style.FramePadding;
+        im_gui_style.AntiAliasedLines = true;
+        im_gui_style.AntiAliasedFill = true;
+        _compiled = std::move(compiled);
+    }
+
+    return [compiled = _compiled]() {
+        std::vector<Delta> deltas;
         if (GImGui)
-            std::swap(*im_gui_style, GImGui->Style);
+            apply(&GImGui->Style, &compiled->im_gui_style, im_gui_fields(), deltas);
         if (GImPlot)
-            std::swap(*im_plot_style, GImPlot->Style);
+            apply(&GImPlot->Style, &compiled->im_plot_style, im_plot_fields(), deltas);
+        if (deltas.empty())
+            return on_scope_exit(nullptr);
+        return on_scope_exit([deltas = std::move(deltas)]() {
+            for (auto it = deltas.rbegin(); it != deltas.rend(); ++it)
+                std::memcpy(it->address, it->value.data(), it->size);
+        });
     };
+}
 
-    return [apply]() mutable {
-        apply();
-        return on_scope_exit(apply);
-    };
+std::uint64_t Theme::version() const
+{
+    return _version;
 }
 
 float Theme::alpha() const
@@ -1275,6 +1394,7 @@ std::unique_ptr<Theme> Theme::make_default()
 
 void Theme::_on_change()
 {
+    ++_version;
     for (auto observer : _observer)
         observer->on_theme_changed();
 }
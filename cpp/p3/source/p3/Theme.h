@@ -5,6 +5,7 @@
 #include "StyleTypes.h"
 
 #include <array>
+#include <cstdint>
 #include <optional>
 
 #include <memory>
@@ -30,9 +31,16 @@ public:
     void add_observer(Observer*);
     void remove_observer(Observer*);
 
+    //
+    // the compiled styles are cached per version, rem and font size. the
+    // apply function writes only the fields which differ from the current
+    // style and restores just those on scope exit
     using ApplyFunction = std::function<on_scope_exit(void)>;
     ApplyFunction compile(Context const&);
 
+    /// incremented on every change
+    std::uint64_t version() const;
+
     float alpha() const;
     void set_alpha(float);
 
@@ -317,8 +325,12 @@ public:
     static std::unique_ptr<Theme> make_default();
 
 private:
+    struct Compiled;
+
     void _on_change();
     std::vector<Observer*> _observer;
+    std::uint64_t _version = 0;
+    std::shared_ptr<Compiled const> _compiled;
 
     float _alpha = 1.f;
     Length2 _window_padding { 0 | em, 0 | em };
@@ -1,6 +1,7 @@
 #include "UserInterface.h"
 #include "Context.h"
 #include "Font.h"
+#include "Profiler.h"
 #include "RenderLayer.h"
 #include "log.h"
 
@@ -196,15 +197,16 @@ void UserInterface::update_restyle(Context& context, bool force_restyle)
 {
     if (needs_restyle()) {
         log_debug("restyling window");
+        //
+        // the theme recompiles only if it, the rem or the font size changed.
+        // the previous theme is restored before, such that its guard does
+        // not undo fields of the new one
+        _theme_guard.reset();
         _theme_apply_function = _theme
             ? _theme->compile(context)
             : nullptr;
-        if (_theme_apply_function) {
+        if (_theme_apply_function)
             _theme_guard = _theme_apply_function();
-            _theme_apply_function = _theme
-                ? _theme->compile(context)
-                : nullptr;
-        }
     }
     if (needs_update()) {
         if (_theme_apply_function) {
@@ -220,7 +222,10 @@ void UserInterface::render(Context& context, float width, float height, bool)
 {
     ImGui::NewFrame();
 
-    update_restyle(context);
+    {
+        P3_PROFILE_ZONE("ui.update_restyle");
+        update_restyle(context);
+    }
 
     std::optional<on_scope_exit> theme_guard;
     if (_theme_apply_function)
@@ -317,8 +322,15 @@ void UserInterface::set_active_node(std::shared_ptr<Node> node)
     if (active_node == node)
         return;
     _active_node = node;
+    //
+    // the callback is resolved when the event is processed,
+    // the weak reference avoids copying the function
     if (_on_active_node_changed)
-        EventLoop::current()->call_at(EventLoop::Clock::now(), Event::create(_on_active_node_changed));
+        postpone("on_active_node_changed", [weak_self = weak_from_this()]() {
+            auto self = std::static_pointer_cast<UserInterface>(weak_self.lock());
+            if (self && self->_on_active_node_changed)
+                self->_on_active_node_changed();
+        });
 }
 
 std::shared_ptr<Node> UserInterface::active_node() const
@@ -14,16 +14,24 @@ void OpenGL3RenderBackend::init()
     log_debug("creating skia context");
     if (!_skia_context)
         _skia_context = GrContext::MakeGL();
+    if (!_gpu_timer)
+        _gpu_timer = std::make_unique<OpenGLGpuTimer>();
+    if (!_capture)
+        _capture = std::make_unique<OpenGLCapture>();
 }
 
 void OpenGL3RenderBackend::new_frame()
 {
     ImGui_ImplOpenGL3_NewFrame();
+    _gpu_timer->begin_frame();
 }
 
 void OpenGL3RenderBackend::render(UserInterface const&)
 {
+    _gpu_timer->begin_section();
     ImGui_ImplOpenGL3_RenderDrawData(ImGui::GetDrawData());
+    _gpu_timer->end_section();
+    _gpu_timer->end_frame();
 }
 
 RenderBackend::Texture* OpenGL3RenderBackend::create_texture()
@@ -38,6 +46,42 @@ RenderBackend::RenderTarget* OpenGL3RenderBackend::create_render_target(std::uin
     return _render_targets.back().get();
 }
 
+void OpenGL3RenderBackend::begin_gpu_section()
+{
+    _gpu_timer->begin_section();
+}
+
+void OpenGL3RenderBackend::end_gpu_section()
+{
+    _gpu_timer->end_section();
+}
+
+std::optional<std::chrono::nanoseconds> OpenGL3RenderBackend::resolve_gpu_time()
+{
+    return _gpu_timer ? _gpu_timer->resolve() : std::nullopt;
+}
+
+void OpenGL3RenderBackend::capture(RenderTarget* target, std::uint32_t width, std::uint32_t height, bool bottom_up, CaptureCallback callback)
+{
+    _capture->read(target ? target->framebuffer_id() : 0, width, height, bottom_up, std::move(callback));
+}
+
+void OpenGL3RenderBackend::poll_captures()
+{
+    _capture->poll();
+}
+
+bool OpenGL3RenderBackend::capturing() const
+{
+    return _capture && _capture->pending();
+}
+
+void OpenGL3RenderBackend::on_shutdown()
+{
+    _gpu_timer.reset();
+    _capture.reset();
+}
+
 std::uint32_t OpenGL3RenderBackend::max_texture_size() const
 {
     GLint value;
@@ -1,5 +1,8 @@
 #pragma once
+#include "OpenGLCapture.h"
+#include "OpenGLGpuTimer.h"
 #include <p3/RenderBackend.h>
+#include <memory>
 #include <vector>
 
 namespace p3 {
@@ -13,6 +16,21 @@ public:
     Texture* create_texture() override;
     RenderTarget* create_render_target(std::uint32_t width, std::uint32_t height) override;
     std::uint32_t max_texture_size() const override;
+
+    void begin_gpu_section() override;
+    void end_gpu_section() override;
+    std::optional<std::chrono::nanoseconds> resolve_gpu_time() override;
+
+    void capture(RenderTarget*, std::uint32_t width, std::uint32_t height, bool bottom_up, CaptureCallback) override;
+    void poll_captures() override;
+    bool capturing() const override;
+
+protected:
+    void on_shutdown() override;
+
+private:
+    std::unique_ptr<OpenGLGpuTimer> _gpu_timer;
+    std::unique_ptr<OpenGLCapture> _capture;
 };
 
 }
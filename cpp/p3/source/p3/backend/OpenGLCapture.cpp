@@ -0,0 +1,147 @@
+#include "OpenGLCapture.h"
+
+#define GLFW_INCLUDE_NONE
+#include <GLFW/glfw3.h>
+#include <glad/gl.h>
+
+#include <p3/log.h>
+#include <p3/platform/event_loop.h>
+
+#include <cstring>
+
+//
+// the generated loader targets GL 3.0, sync objects are loaded here
+#ifndef GL_SYNC_GPU_COMMANDS_COMPLETE
+#define GL_SYNC_GPU_COMMANDS_COMPLETE 0x9117
+#define GL_ALREADY_SIGNALED 0x911A
+#define GL_CONDITION_SATISFIED 0x911C
+#endif
+
+namespace p3 {
+
+namespace {
+
+    //
+    // entry points use the calling convention of gl, e.g. __stdcall on win32
+    using FenceSync = void*(GLAD_API_PTR*)(GLenum, GLbitfield);
+    using ClientWaitSync = GLenum(GLAD_API_PTR*)(void*, GLbitfield, GLuint64);
+    using DeleteSync = void(GLAD_API_PTR*)(void*);
+    FenceSync fence_sync = nullptr;
+    ClientWaitSync client_wait_sync = nullptr;
+    DeleteSync delete_sync = nullptr;
+
+}
+
+OpenGLCapture::OpenGLCapture()
+{
+    GLint major = 0, minor = 0;
+    glGetIntegerv(GL_MAJOR_VERSION, &major);
+    glGetIntegerv(GL_MINOR_VERSION, &minor);
+    if (major > 3 || (major == 3 && minor >= 2) || glfwExtensionSupported("GL_ARB_sync")) {
+        fence_sync = reinterpret_cast<FenceSync>(glfwGetProcAddress("glFenceSync"));
+        client_wait_sync = reinterpret_cast<ClientWaitSync>(glfwGetProcAddress("glClientWaitSync"));
+        delete_sync = reinterpret_cast<DeleteSync>(glfwGetProcAddress("glDeleteSync"));
+    }
+    _fences = fence_sync && client_wait_sync && delete_sync;
+    if (!_fences)
+        log_info("sync objects are not supported, captures may stall");
+}
+
+OpenGLCapture::~OpenGLCapture()
+{
+    for (auto& read : _reads) {
+        if (read.fence)
+            delete_sync(read.fence);
+        _free.push_back(read.buffer);
+    }
+    if (!_reads.empty()) {
+        //
+        // (for python we need to acquire the gil)
+        run_in_external_scope([&] {
+            for (auto& read : _reads)
+                read.callback(Pixels());
+        });
+    }
+    for (auto& buffer : _free)
+        glDeleteBuffers(1, &buffer.id);
+}
+
+OpenGLCapture::Buffer OpenGLCapture::acquire(std::size_t size)
+{
+    for (auto it = _free.begin(); it != _free.end(); ++it) {
+        if (it->size == size) {
+            auto buffer = *it;
+            _free.erase(it);
+            return buffer;
+        }
+    }
+    Buffer buffer { 0, size };
+    glGenBuffers(1, &buffer.id);
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, buffer.id);
+    glBufferData(GL_PIXEL_PACK_BUFFER, GLsizeiptr(size), nullptr, GL_STREAM_READ);
+    log_debug("capture buffer created ({} bytes)", size);
+    return buffer;
+}
+
+void OpenGLCapture::read(unsigned int framebuffer, std::uint32_t width, std::uint32_t height, bool bottom_up, RenderBackend::CaptureCallback callback)
+{
+    auto buffer = acquire(std::size_t(width) * height * 4);
+    GLint previous = 0;
+    glGetIntegerv(GL_READ_FRAMEBUFFER_BINDING, &previous);
+    glBindFramebuffer(GL_READ_FRAMEBUFFER, framebuffer);
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, buffer.id);
+    glPixelStorei(GL_PACK_ALIGNMENT, 1);
+    glReadPixels(0, 0, GLsizei(width), GLsizei(height), GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+    glBindFramebuffer(GL_READ_FRAMEBUFFER, GLuint(previous));
+    _reads.push_back(Read {
+        buffer,
+        _fences ? fence_sync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0) : nullptr,
+        width,
+        height,
+        bottom_up,
+        std::move(callback) });
+}
+
+void OpenGLCapture::poll()
+{
+    while (!_reads.empty()) {
+        auto& read = _reads.front();
+        if (read.fence) {
+            auto const status = client_wait_sync(read.fence, 0, 0);
+            if (status != GL_ALREADY_SIGNALED && status != GL_CONDITION_SATISFIED)
+                return;
+            delete_sync(read.fence);
+        }
+        Pixels pixels(read.width, read.height);
+        glBindBuffer(GL_PIXEL_PACK_BUFFER, read.buffer.id);
+        auto mapped = static_cast<std::uint8_t const*>(
+            glMapBufferRange(GL_PIXEL_PACK_BUFFER, 0, GLsizeiptr(read.buffer.size), GL_MAP_READ_BIT));
+        if (mapped) {
+            //
+            // the one copy out of the mapping also flips bottom up rows
+            auto const stride = std::size_t(read.width) * 4;
+            if (read.bottom_up) {
+                for (std::size_t row = 0; row < read.height; ++row)
+                    std::memcpy(pixels.data.get() + row * stride, mapped + (read.height - 1 - row) * stride, stride);
+            } else {
+                std::memcpy(pixels.data.get(), mapped, pixels.size());
+            }
+            glUnmapBuffer(GL_PIXEL_PACK_BUFFER);
+        } else {
+            log_warn("failed to map capture buffer");
+            pixels = Pixels();
+        }
+        glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+        _free.push_back(read.buffer);
+        if (_free.size() > MaximumFree) {
+            glDeleteBuffers(1, &_free.front().id);
+            _free.erase(_free.begin());
+        }
+        auto callback = std::move(read.callback);
+        _reads.pop_front();
+        callback(std::move(pixels));
+    }
+}
+
+}
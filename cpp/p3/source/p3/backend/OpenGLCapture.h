@@ -0,0 +1,60 @@
+#pragma once
+
+#include <p3/RenderBackend.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <vector>
+
+namespace p3 {
+
+/*
+ * reads framebuffers back through pixel pack buffers. glReadPixels into a
+ * buffer returns immediately, the buffer is mapped once its fence has
+ * signalled. buffers are recycled, hence capturing every frame alternates
+ * between two of them. fences require GL 3.2 or ARB_sync, without them
+ * the buffer is mapped on the next poll, which may wait for the copy.
+ */
+class OpenGLCapture {
+public:
+    /// buffers which are kept for reuse
+    static constexpr std::size_t MaximumFree = 4;
+
+    OpenGLCapture();
+    /// unfinished copies deliver empty pixels
+    ~OpenGLCapture();
+
+    ///
+    /// queues the copy of the framebuffer, the rows are flipped
+    /// if bottom_up, see RenderBackend::RenderTarget::read_pixels
+    void read(unsigned int framebuffer, std::uint32_t width, std::uint32_t height, bool bottom_up, RenderBackend::CaptureCallback);
+
+    /// invokes the callbacks of finished copies, oldest first
+    void poll();
+
+    bool pending() const { return !_reads.empty(); }
+
+private:
+    struct Buffer {
+        unsigned int id = 0;
+        std::size_t size = 0;
+    };
+
+    struct Read {
+        Buffer buffer;
+        void* fence;
+        std::uint32_t width;
+        std::uint32_t height;
+        bool bottom_up;
+        RenderBackend::CaptureCallback callback;
+    };
+
+    Buffer acquire(std::size_t size);
+
+    bool _fences = false;
+    std::vector<Buffer> _free;
+    std::deque<Read> _reads;
+};
+
+}
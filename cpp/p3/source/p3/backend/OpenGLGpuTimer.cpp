@@ -0,0 +1,114 @@
+#include "OpenGLGpuTimer.h"
+
+#define GLFW_INCLUDE_NONE
+#include <GLFW/glfw3.h>
+#include <glad/gl.h>
+
+#include <p3/log.h>
+
+
+//
+// the generated loader targets GL 3.0, timer queries are loaded here
+#ifndef GL_TIME_ELAPSED
+#define GL_TIME_ELAPSED 0x88BF
+#endif
+
+namespace p3 {
+
+namespace {
+
+    //
+    // entry points use the calling convention of gl, e.g. __stdcall on win32
+    using GetQueryObjectui64v = void(GLAD_API_PTR*)(GLuint, GLenum, GLuint64*);
+    GetQueryObjectui64v get_query_object_ui64v = nullptr;
+
+}
+
+OpenGLGpuTimer::OpenGLGpuTimer()
+{
+    GLint major = 0, minor = 0;
+    glGetIntegerv(GL_MAJOR_VERSION, &major);
+    glGetIntegerv(GL_MINOR_VERSION, &minor);
+    if (major > 3 || (major == 3 && minor >= 3) || glfwExtensionSupported("GL_ARB_timer_query"))
+        get_query_object_ui64v = reinterpret_cast<GetQueryObjectui64v>(glfwGetProcAddress("glGetQueryObjectui64v"));
+    _supported = get_query_object_ui64v != nullptr;
+    if (!_supported)
+        log_info("gpu timer queries are not supported");
+}
+
+OpenGLGpuTimer::~OpenGLGpuTimer()
+{
+    for (auto& frame : _frames)
+        if (!frame.queries.empty())
+            glDeleteQueries(GLsizei(frame.queries.size()), frame.queries.data());
+}
+
+void OpenGLGpuTimer::begin_frame()
+{
+    if (!_supported)
+        return;
+    //
+    // resolve finished frames, oldest first
+    for (std::size_t i = 1; i <= Latency; ++i) {
+        auto& frame = _frames[(_current + i) % Latency];
+        if (!frame.pending)
+            continue;
+        GLuint available = 0;
+        glGetQueryObjectuiv(frame.queries[frame.used - 1], GL_QUERY_RESULT_AVAILABLE, &available);
+        if (!available)
+            break;
+        GLuint64 total = 0;
+        for (std::size_t j = 0; j < frame.used; ++j) {
+            GLuint64 elapsed = 0;
+            get_query_object_ui64v(frame.queries[j], GL_QUERY_RESULT, &elapsed);
+            total += elapsed;
+        }
+        _resolved.push_back(std::chrono::nanoseconds(total));
+        frame.pending = false;
+    }
+    _current = (_current + 1) % Latency;
+    //
+    // results which are still not available are dropped
+    auto& frame = _frames[_current];
+    frame.pending = false;
+    frame.used = 0;
+    _depth = 0;
+}
+
+void OpenGLGpuTimer::end_frame()
+{
+    if (!_supported)
+        return;
+    auto& frame = _frames[_current];
+    frame.pending = frame.used > 0;
+}
+
+void OpenGLGpuTimer::begin_section()
+{
+    if (!_supported || _depth++ > 0)
+        return;
+    auto& frame = _frames[_current];
+    if (frame.used == frame.queries.size()) {
+        frame.queries.push_back(0);
+        glGenQueries(1, &frame.queries.back());
+    }
+    glBeginQuery(GL_TIME_ELAPSED, frame.queries[frame.used++]);
+}
+
+void OpenGLGpuTimer::end_section()
+{
+    if (!_supported || _depth == 0 || --_depth > 0)
+        return;
+    glEndQuery(GL_TIME_ELAPSED);
+}
+
+std::optional<std::chrono::nanoseconds> OpenGLGpuTimer::resolve()
+{
+    if (_resolved.empty())
+        return std::nullopt;
+    auto const elapsed = _resolved.front();
+    _resolved.pop_front();
+    return elapsed;
+}
+
+}
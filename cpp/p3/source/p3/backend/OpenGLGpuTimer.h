@@ -0,0 +1,51 @@
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <deque>
+#include <optional>
+#include <vector>
+
+namespace p3 {
+
+/*
+ * measures the gpu time of a frame with GL_TIME_ELAPSED queries around
+ * the sections of the frame. results are read without stalling, frames
+ * later, when they are available. requires GL 3.3 or ARB_timer_query.
+ */
+class OpenGLGpuTimer {
+public:
+    /// frames which may be in flight
+    static constexpr std::size_t Latency = 4;
+
+    OpenGLGpuTimer();
+    ~OpenGLGpuTimer();
+
+    bool supported() const { return _supported; }
+
+    void begin_frame();
+    void end_frame();
+
+    /// sections must not be nested, nested ones are ignored
+    void begin_section();
+    void end_section();
+
+    /// gpu times of the frames which became available, oldest first, one per call
+    std::optional<std::chrono::nanoseconds> resolve();
+
+private:
+    struct Frame {
+        std::vector<unsigned int> queries;
+        std::size_t used = 0;
+        bool pending = false;
+    };
+
+    bool _supported = false;
+    std::array<Frame, Latency> _frames;
+    std::size_t _current = 0;
+    std::size_t _depth = 0;
+    std::deque<std::chrono::nanoseconds> _resolved;
+};
+
+}
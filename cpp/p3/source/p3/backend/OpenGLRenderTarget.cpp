@@ -1,4 +1,5 @@
 #include <glad/gl.h>
+#include <algorithm>
 #include <stdexcept>
 #include <p3/log.h>
 
@@ -103,4 +104,19 @@ namespace p3
         return _height;
     }
 
+    void OpenGLRenderTarget::read_pixels(std::uint8_t* rgba, bool bottom_up)
+    {
+        glBindFramebuffer(GL_READ_FRAMEBUFFER, _framebuffer_id);
+        glPixelStorei(GL_PACK_ALIGNMENT, 1);
+        glReadPixels(0, 0, GLsizei(_width), GLsizei(_height), GL_RGBA, GL_UNSIGNED_BYTE, rgba);
+        glBindFramebuffer(GL_READ_FRAMEBUFFER, 0);
+        if (!bottom_up)
+            return;
+        //
+        // the rows of gl start at the bottom, flip in place
+        auto const stride = std::size_t(_width) * 4;
+        for (std::size_t top = 0, bottom = _height; top + 1 < bottom; ++top, --bottom)
+            std::swap_ranges(rgba + top * stride, rgba + (top + 1) * stride, rgba + (bottom - 1) * stride);
+    }
+
 }
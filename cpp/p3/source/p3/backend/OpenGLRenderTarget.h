@@ -16,6 +16,7 @@ namespace p3
         void release() override;
         std::uint32_t width() const override;
         std::uint32_t height() const override;
+        void read_pixels(std::uint8_t* rgba, bool bottom_up) override;
     
         sk_sp<SkSurface> const& skia_surface() const final override;
 
@@ -0,0 +1,46 @@
+#include "RasterPresenter.h"
+
+#include <glad/gl.h>
+
+namespace p3 {
+
+RasterPresenter::~RasterPresenter()
+{
+    if (_framebuffer)
+        glDeleteFramebuffers(1, &_framebuffer);
+    if (_texture)
+        glDeleteTextures(1, &_texture);
+}
+
+void RasterPresenter::present(SkPixmap const& pixmap)
+{
+    if (!_texture) {
+        glGenTextures(1, &_texture);
+        glGenFramebuffers(1, &_framebuffer);
+    }
+    glBindTexture(GL_TEXTURE_2D, _texture);
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+    glPixelStorei(GL_UNPACK_ROW_LENGTH, int(pixmap.rowBytesAsPixels()));
+    if (pixmap.width() != _width || pixmap.height() != _height) {
+        _width = pixmap.width();
+        _height = pixmap.height();
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+        glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, _width, _height, 0, GL_RGBA, GL_UNSIGNED_BYTE, pixmap.addr());
+    } else {
+        glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, _width, _height, GL_RGBA, GL_UNSIGNED_BYTE, pixmap.addr());
+    }
+    glPixelStorei(GL_UNPACK_ROW_LENGTH, 0);
+    glBindTexture(GL_TEXTURE_2D, 0);
+
+    glBindFramebuffer(GL_READ_FRAMEBUFFER, _framebuffer);
+    glFramebufferTexture2D(GL_READ_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, _texture, 0);
+    glBindFramebuffer(GL_DRAW_FRAMEBUFFER, 0);
+    //
+    // the rows of the pixmap go from top to bottom, gl counts from the
+    // bottom. the blit flips the image by swapping the destination rows
+    glBlitFramebuffer(0, 0, _width, _height, 0, _height, _width, 0, GL_COLOR_BUFFER_BIT, GL_NEAREST);
+    glBindFramebuffer(GL_READ_FRAMEBUFFER, 0);
+}
+
+}
@@ -0,0 +1,30 @@
+#pragma once
+
+#include <include/core/SkPixmap.h>
+
+namespace p3 {
+
+//
+// shows the frames of a raster window. the pixels are uploaded into a
+// texture, which is blitted into the default framebuffer of the current
+// gl context. the context exists only for presenting, raster windows
+// render without gpu
+class RasterPresenter {
+public:
+    RasterPresenter() = default;
+    ~RasterPresenter();
+
+    RasterPresenter(RasterPresenter const&) = delete;
+    RasterPresenter& operator=(RasterPresenter const&) = delete;
+
+    /// blits the rgba pixels, the window swaps the buffers afterwards
+    void present(SkPixmap const&);
+
+private:
+    unsigned int _texture = 0;
+    unsigned int _framebuffer = 0;
+    int _width = 0;
+    int _height = 0;
+};
+
+}
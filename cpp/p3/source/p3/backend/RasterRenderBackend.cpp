@@ -0,0 +1,225 @@
+#include "RasterRenderBackend.h"
+#include "RasterRenderTarget.h"
+#include "RasterTexture.h"
+
+#include <p3/Profiler.h>
+#include <p3/log.h>
+#include <p3/platform/WorkerPool.h>
+
+#include <imgui.h>
+
+#include <include/core/SkCanvas.h>
+#include <include/core/SkImage.h>
+#include <include/core/SkPaint.h>
+#include <include/core/SkPixmap.h>
+
+#include <algorithm>
+#include <cstring>
+#include <thread>
+
+namespace p3 {
+
+namespace {
+
+    //
+    // rows per tile. tiles are handed out one by one, hence uneven
+    // content of the rows is balanced between the threads
+    constexpr int TileHeight = 64;
+
+    SkColor to_sk_color(ImU32 color)
+    {
+        return SkColorSetARGB(
+            (color >> IM_COL32_A_SHIFT) & 0xFF,
+            (color >> IM_COL32_R_SHIFT) & 0xFF,
+            (color >> IM_COL32_G_SHIFT) & 0xFF,
+            (color >> IM_COL32_B_SHIFT) & 0xFF);
+    }
+
+}
+
+RasterRenderBackend::RasterRenderBackend(std::size_t threads)
+{
+    if (threads == 0)
+        threads = std::max(1u, std::thread::hardware_concurrency());
+    _workers = std::make_unique<WorkerPool>(threads - 1);
+}
+
+RasterRenderBackend::~RasterRenderBackend() = default;
+
+void RasterRenderBackend::init()
+{
+    auto& io = ImGui::GetIO();
+    io.BackendRendererName = "p3_raster";
+    io.BackendFlags |= ImGuiBackendFlags_RendererHasVtxOffset;
+    update_font_atlas();
+}
+
+void RasterRenderBackend::new_frame()
+{
+    auto& io = ImGui::GetIO();
+    if (!io.Fonts->IsBuilt() || io.Fonts->TexID != &_font_atlas)
+        update_font_atlas();
+}
+
+void RasterRenderBackend::update_font_atlas()
+{
+    auto& io = ImGui::GetIO();
+    unsigned char* pixels;
+    int width;
+    int height;
+    io.Fonts->GetTexDataAsRGBA32(&pixels, &width, &height);
+    _font_atlas.allocPixels(SkImageInfo::Make(width, height, kRGBA_8888_SkColorType, kUnpremul_SkAlphaType));
+    std::memcpy(_font_atlas.getPixels(), pixels, std::size_t(width) * height * 4);
+    _font_atlas.setImmutable();
+    io.Fonts->SetTexID(&_font_atlas);
+    log_debug("raster font atlas created ({}x{})", width, height);
+}
+
+void RasterRenderBackend::render(UserInterface const&)
+{
+    auto const draw_data = ImGui::GetDrawData();
+    if (!_target || !draw_data)
+        return;
+    prepare(*draw_data);
+    auto const width = int(_target->width());
+    auto const height = int(_target->height());
+    auto const tiles = std::size_t((height + TileHeight - 1) / TileHeight);
+    P3_PROFILE_ZONE("raster.rasterize");
+    _workers->parallel_for(tiles, [&](std::size_t tile) {
+        auto const top = int(tile) * TileHeight;
+        rasterize(SkIRect::MakeLTRB(0, top, width, std::min(height, top + TileHeight)));
+    });
+    _commands.clear();
+}
+
+void RasterRenderBackend::prepare(ImDrawData const& draw_data)
+{
+    P3_PROFILE_ZONE("raster.prepare");
+    auto const offset = draw_data.DisplayPos;
+    auto const scale = draw_data.FramebufferScale;
+    //
+    // SkBitmap::makeShader copies the pixels of mutable bitmaps, e.g. of
+    // render targets and textures. the images wrap the pixels instead,
+    // they are not modified while the frame is rasterized
+    std::vector<std::pair<SkBitmap const*, sk_sp<SkShader>>> shaders;
+    auto shader = [&](SkBitmap const* texture) -> sk_sp<SkShader> {
+        if (!texture)
+            return nullptr;
+        auto it = std::find_if(shaders.begin(), shaders.end(), [&](auto const& item) { return item.first == texture; });
+        if (it == shaders.end()) {
+            auto image = SkImage::MakeFromRaster(texture->pixmap(), nullptr, nullptr);
+            it = shaders.emplace(shaders.end(), texture,
+                image ? image->makeShader(SkTileMode::kClamp, SkTileMode::kClamp) : SkShaders::Empty());
+        }
+        return it->second;
+    };
+    _commands.clear();
+    for (int n = 0; n < draw_data.CmdListsCount; ++n) {
+        auto const& list = *draw_data.CmdLists[n];
+        for (auto const& command : list.CmdBuffer) {
+            if (command.UserCallback) {
+                if (command.UserCallback != ImDrawCallback_ResetRenderState)
+                    command.UserCallback(&list, &command);
+                continue;
+            }
+            auto const clip = SkRect::MakeLTRB(
+                (command.ClipRect.x - offset.x) * scale.x,
+                (command.ClipRect.y - offset.y) * scale.y,
+                (command.ClipRect.z - offset.x) * scale.x,
+                (command.ClipRect.w - offset.y) * scale.y);
+            if (command.ElemCount == 0 || clip.isEmpty())
+                continue;
+            auto const texture = static_cast<SkBitmap const*>(command.TextureId);
+            _commands.push_back(DrawCommand {
+                make_vertices(list, command, texture, offset, scale),
+                shader(texture),
+                clip });
+        }
+    }
+}
+
+void RasterRenderBackend::rasterize(SkIRect const& tile)
+{
+    SkPixmap pixmap;
+    if (!_target->bitmap().pixmap().extractSubset(&pixmap, tile))
+        return;
+    auto canvas = SkCanvas::MakeRasterDirect(pixmap.info(), pixmap.writable_addr(), pixmap.rowBytes());
+    canvas->clear(SK_ColorTRANSPARENT);
+    canvas->translate(-SkIntToScalar(tile.x()), -SkIntToScalar(tile.y()));
+    auto const bounds = SkRect::Make(tile);
+    SkPaint paint;
+    paint.setFilterQuality(kLow_SkFilterQuality);
+    for (auto const& command : _commands) {
+        auto clip = command.clip;
+        if (!clip.intersect(bounds) || !clip.intersects(command.vertices->bounds()))
+            continue;
+        canvas->save();
+        canvas->clipRect(clip);
+        paint.setShader(command.shader);
+        canvas->drawVertices(command.vertices, SkBlendMode::kModulate, paint);
+        canvas->restore();
+    }
+}
+
+//
+// skia takes 16 bit indices, larger ranges are expanded to a plain
+// triangle list
+sk_sp<SkVertices> RasterRenderBackend::make_vertices(
+    ImDrawList const& list,
+    ImDrawCmd const& command,
+    SkBitmap const* texture,
+    ImVec2 offset,
+    ImVec2 scale)
+{
+    auto const* indices = list.IdxBuffer.Data + command.IdxOffset;
+    auto const* vertices = list.VtxBuffer.Data + command.VtxOffset;
+    auto const index_count = int(command.ElemCount);
+    auto const range = std::minmax_element(indices, indices + index_count);
+    auto const first = int(*range.first);
+    auto const indexed = int(*range.second) - first < 0xFFFF;
+    auto const vertex_count = indexed ? int(*range.second) - first + 1 : index_count;
+
+    auto const u = texture ? float(texture->width()) : 0.f;
+    auto const v = texture ? float(texture->height()) : 0.f;
+    SkVertices::Builder builder(SkVertices::kTriangles_VertexMode, vertex_count, indexed ? index_count : 0,
+        SkVertices::kHasTexCoords_BuilderFlag | SkVertices::kHasColors_BuilderFlag);
+    auto positions = builder.positions();
+    auto coordinates = builder.texCoords();
+    auto colors = builder.colors();
+    for (int i = 0; i < vertex_count; ++i) {
+        auto const& vertex = vertices[indexed ? first + i : int(indices[i])];
+        positions[i] = SkPoint::Make((vertex.pos.x - offset.x) * scale.x, (vertex.pos.y - offset.y) * scale.y);
+        coordinates[i] = SkPoint::Make(vertex.uv.x * u, vertex.uv.y * v);
+        colors[i] = to_sk_color(vertex.col);
+    }
+    if (indexed) {
+        auto rebased = builder.indices();
+        for (int i = 0; i < index_count; ++i)
+            rebased[i] = std::uint16_t(int(indices[i]) - first);
+    }
+    return builder.detach();
+}
+
+void RasterRenderBackend::bind(RasterRenderTarget* target)
+{
+    _target = target;
+}
+
+RenderBackend::Texture* RasterRenderBackend::create_texture()
+{
+    _textures.push_back(std::make_unique<RasterTexture>());
+    return _textures.back().get();
+}
+
+RenderBackend::RenderTarget* RasterRenderBackend::create_render_target(std::uint32_t width, std::uint32_t height)
+{
+    _render_targets.push_back(std::make_unique<RasterRenderTarget>(*this, width, height));
+    return _render_targets.back().get();
+}
+
+std::uint32_t RasterRenderBackend::max_texture_size() const
+{
+    return 16384;
+}
+
+}
@@ -0,0 +1,76 @@
+#pragma once
+
+#include <p3/RenderBackend.h>
+
+#include <include/core/SkBitmap.h>
+#include <include/core/SkRect.h>
+#include <include/core/SkShader.h>
+#include <include/core/SkVertices.h>
+
+#include <memory>
+#include <vector>
+
+struct ImDrawCmd;
+struct ImDrawData;
+struct ImDrawList;
+struct ImVec2;
+
+namespace p3 {
+
+class RasterRenderTarget;
+class WorkerPool;
+
+//
+// renders without gpu. the imgui draw data is rasterized by skia into the
+// bound raster render target, render layers draw into raster surfaces.
+// the target is split into horizontal tiles which are rasterized in
+// parallel, every tile replays the draw commands clipped to itself
+class RasterRenderBackend final : public RenderBackend {
+public:
+    ///
+    /// threads rasterizing tiles, including the rendering thread.
+    /// zero uses the hardware concurrency
+    explicit RasterRenderBackend(std::size_t threads = 0);
+    ~RasterRenderBackend();
+
+    void init() override;
+    void new_frame() override;
+    void render(UserInterface const&) override;
+
+    Texture* create_texture() override;
+    RenderTarget* create_render_target(std::uint32_t width, std::uint32_t height) override;
+    std::uint32_t max_texture_size() const override;
+
+    ///
+    /// the target of render(), called by the target on bind and release
+    void bind(RasterRenderTarget*);
+
+    ///
+    /// copies the vertices referenced by the command, relative to the
+    /// display offset and scaled to the framebuffer. texture coordinates
+    /// are in pixels of the texture
+    static sk_sp<SkVertices> make_vertices(
+        ImDrawList const&,
+        ImDrawCmd const&,
+        SkBitmap const* texture,
+        ImVec2 offset,
+        ImVec2 scale);
+
+private:
+    struct DrawCommand {
+        sk_sp<SkVertices> vertices;
+        sk_sp<SkShader> shader;
+        SkRect clip;
+    };
+
+    void update_font_atlas();
+    void prepare(ImDrawData const&);
+    void rasterize(SkIRect const& tile);
+
+    std::unique_ptr<WorkerPool> _workers;
+    RasterRenderTarget* _target = nullptr;
+    SkBitmap _font_atlas;
+    std::vector<DrawCommand> _commands;
+};
+
+}
@@ -0,0 +1,62 @@
+#include "RasterRenderTarget.h"
+#include "RasterRenderBackend.h"
+
+#include <p3/log.h>
+
+#include <stdexcept>
+
+namespace p3 {
+
+RasterRenderTarget::RasterRenderTarget(RasterRenderBackend& backend, std::uint32_t width, std::uint32_t height)
+    : _backend(&backend)
+{
+    if (!_bitmap.tryAllocPixels(SkImageInfo::Make(int(width), int(height), kRGBA_8888_SkColorType, kPremul_SkAlphaType)))
+        throw std::runtime_error("failed to create render target, out of memory");
+    _bitmap.eraseColor(SK_ColorTRANSPARENT);
+    _skia_surface = SkSurface::MakeRasterDirect(_bitmap.pixmap());
+    log_debug("raster render target created ({}x{})", width, height);
+}
+
+unsigned int RasterRenderTarget::framebuffer_id() const
+{
+    return 0;
+}
+
+RenderBackend::TextureId RasterRenderTarget::texture_id() const
+{
+    return const_cast<SkBitmap*>(&_bitmap);
+}
+
+void RasterRenderTarget::bind()
+{
+    _backend->bind(this);
+}
+
+void RasterRenderTarget::release()
+{
+    _backend->bind(nullptr);
+}
+
+std::uint32_t RasterRenderTarget::width() const
+{
+    return std::uint32_t(_bitmap.width());
+}
+
+std::uint32_t RasterRenderTarget::height() const
+{
+    return std::uint32_t(_bitmap.height());
+}
+
+void RasterRenderTarget::read_pixels(std::uint8_t* rgba, bool)
+{
+    //
+    // the rows of the bitmap always start at the top
+    _bitmap.readPixels(_bitmap.info(), rgba, std::size_t(_bitmap.width()) * 4, 0, 0);
+}
+
+sk_sp<SkSurface> const& RasterRenderTarget::skia_surface() const
+{
+    return _skia_surface;
+}
+
+}
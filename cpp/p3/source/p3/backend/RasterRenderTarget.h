@@ -0,0 +1,36 @@
+#pragma once
+
+#include <p3/RenderBackend.h>
+
+#include <include/core/SkBitmap.h>
+
+namespace p3 {
+
+class RasterRenderBackend;
+
+//
+// skia draws directly into the bitmap, which is also the texture of the
+// target. binding makes it the destination of the imgui draw data
+class RasterRenderTarget final : public RenderBackend::RenderTarget {
+public:
+    RasterRenderTarget(RasterRenderBackend&, std::uint32_t width, std::uint32_t height);
+
+    unsigned int framebuffer_id() const override;
+    RenderBackend::TextureId texture_id() const override;
+    void bind() override;
+    void release() override;
+    std::uint32_t width() const override;
+    std::uint32_t height() const override;
+    void read_pixels(std::uint8_t* rgba, bool bottom_up) override;
+
+    sk_sp<SkSurface> const& skia_surface() const override;
+
+    SkBitmap const& bitmap() const { return _bitmap; }
+
+private:
+    RasterRenderBackend* _backend;
+    SkBitmap _bitmap;
+    sk_sp<SkSurface> _skia_surface;
+};
+
+}
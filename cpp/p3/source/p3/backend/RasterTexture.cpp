@@ -0,0 +1,23 @@
+#include "RasterTexture.h"
+
+#include <cstring>
+
+namespace p3 {
+
+RenderBackend::TextureId RasterTexture::id() const
+{
+    return const_cast<SkBitmap*>(&_bitmap);
+}
+
+void RasterTexture::update(
+    std::size_t width,
+    std::size_t height,
+    std::uint8_t const* rgba_data)
+{
+    if (std::size_t(_bitmap.width()) != width || std::size_t(_bitmap.height()) != height)
+        _bitmap.allocPixels(SkImageInfo::Make(int(width), int(height), kRGBA_8888_SkColorType, kUnpremul_SkAlphaType));
+    std::memcpy(_bitmap.getPixels(), rgba_data, width * height * 4);
+    _bitmap.notifyPixelsChanged();
+}
+
+}
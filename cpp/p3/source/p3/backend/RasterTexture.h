@@ -0,0 +1,24 @@
+#pragma once
+
+#include <p3/RenderBackend.h>
+
+#include <include/core/SkBitmap.h>
+
+namespace p3 {
+
+//
+// the id of raster textures and render targets points to their bitmap
+class RasterTexture final : public RenderBackend::Texture {
+public:
+    RenderBackend::TextureId id() const override;
+
+    void update(
+        std::size_t width,
+        std::size_t height,
+        std::uint8_t const* rgba_data) override;
+
+private:
+    SkBitmap _bitmap;
+};
+
+}
@@ -9,8 +9,11 @@ namespace p3
     class Color;
     class ColorEdit;
     class ComboBox;
+    class DataTable;
     class EventLoop;
     class Layout;
+    class ListView;
+    class Loader;
     class Image;
     template<typename T> class InputScalar;
     class InputText;
@@ -20,17 +23,20 @@ namespace p3
     class Node;
     class Plot;
     class Popup;
+    class Profiler;
     class ProgressBar;
     class ScrollArea;
     template<typename T> class Slider;
     class Spacer;
-    class StyleBlock;
+    struct StyleBlock;
+    class StyleSheet;
     class Tab;
     class Table;
     class Text;
     class Texture;
     class ToolTip;
     class UserInterface;
+    class VirtualList;
     class Theme;
     class Window;
 }
@@ -0,0 +1,107 @@
+#include "CallbackStatistics.h"
+
+#include <p3/Node.h>
+#include <p3/log.h>
+
+#include <algorithm>
+
+namespace p3 {
+
+namespace {
+
+    std::string describe(Node const* node)
+    {
+        if (!node)
+            return {};
+        auto const& label = node->label();
+        return label ? node->element_name() + " \"" + label.value() + "\"" : node->element_name();
+    }
+
+}
+
+void CallbackStatistics::record(Node const* node, char const* signal, Duration duration)
+{
+    std::lock_guard<std::mutex> l(_mutex);
+    ++_calls;
+    _total += duration;
+    auto const slow = _warning_threshold && duration > _warning_threshold.value();
+    //
+    // names are only resolved for callbacks which make it into the table
+    if (!slow && (_size == 0 || (_slowest.size() == _size && duration <= _slowest.back().duration)))
+        return;
+    auto name = describe(node);
+    signal = signal ? signal : "";
+    if (slow)
+        log_warn("slow callback {} {} took {:.1f}ms", name.empty() ? "(unknown)" : name, signal,
+            std::chrono::duration<double, std::milli>(duration).count());
+    if (_size == 0 || (_slowest.size() == _size && duration <= _slowest.back().duration))
+        return;
+    auto it = std::find_if(_slowest.begin(), _slowest.end(), [&](auto const& entry) {
+        return entry.signal == signal && entry.node == name;
+    });
+    if (it == _slowest.end())
+        it = _slowest.insert(_slowest.end(), Entry { std::move(name), signal, duration });
+    else if (it->duration < duration)
+        it->duration = duration;
+    else
+        return;
+    std::stable_sort(_slowest.begin(), _slowest.end(), [](auto const& a, auto const& b) {
+        return a.duration > b.duration;
+    });
+    if (_slowest.size() > _size)
+        _slowest.resize(_size);
+}
+
+std::vector<CallbackStatistics::Entry> CallbackStatistics::slowest() const
+{
+    std::lock_guard<std::mutex> l(_mutex);
+    return _slowest;
+}
+
+void CallbackStatistics::set_size(std::size_t size)
+{
+    std::lock_guard<std::mutex> l(_mutex);
+    _size = size;
+    if (_slowest.size() > _size)
+        _slowest.resize(_size);
+}
+
+std::size_t CallbackStatistics::size() const
+{
+    std::lock_guard<std::mutex> l(_mutex);
+    return _size;
+}
+
+void CallbackStatistics::set_warning_threshold(std::optional<Duration> warning_threshold)
+{
+    std::lock_guard<std::mutex> l(_mutex);
+    _warning_threshold = warning_threshold;
+}
+
+std::optional<CallbackStatistics::Duration> CallbackStatistics::warning_threshold() const
+{
+    std::lock_guard<std::mutex> l(_mutex);
+    return _warning_threshold;
+}
+
+std::size_t CallbackStatistics::calls() const
+{
+    std::lock_guard<std::mutex> l(_mutex);
+    return _calls;
+}
+
+CallbackStatistics::Duration CallbackStatistics::total() const
+{
+    std::lock_guard<std::mutex> l(_mutex);
+    return _total;
+}
+
+void CallbackStatistics::reset()
+{
+    std::lock_guard<std::mutex> l(_mutex);
+    _slowest.clear();
+    _calls = 0;
+    _total = Duration {};
+}
+
+}
@@ -0,0 +1,58 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace p3 {
+
+class Node;
+
+/*
+ * execution times of the callbacks dispatched by the event loop. keeps
+ * the slowest handlers, each identified by its node and signal, and
+ * optionally warns about callbacks exceeding a threshold.
+ */
+class CallbackStatistics {
+public:
+    using Clock = std::chrono::high_resolution_clock;
+    using Duration = Clock::duration;
+
+    struct Entry {
+        /// element name and label of the node, empty if unknown
+        std::string node;
+        std::string signal;
+        /// the slowest execution
+        Duration duration;
+    };
+
+    void record(Node const*, char const* signal, Duration);
+
+    /// the slowest handlers, in descending order
+    std::vector<Entry> slowest() const;
+
+    void set_size(std::size_t);
+    std::size_t size() const;
+
+    void set_warning_threshold(std::optional<Duration>);
+    std::optional<Duration> warning_threshold() const;
+
+    /// all recorded executions
+    std::size_t calls() const;
+    Duration total() const;
+
+    void reset();
+
+private:
+    mutable std::mutex _mutex;
+    std::size_t _size = 20;
+    std::optional<Duration> _warning_threshold = std::nullopt;
+    std::vector<Entry> _slowest;
+    std::size_t _calls = 0;
+    Duration _total {};
+};
+
+}
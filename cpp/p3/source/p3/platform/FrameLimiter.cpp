@@ -0,0 +1,45 @@
+#include "FrameLimiter.h"
+
+#include <stdexcept>
+
+namespace p3 {
+
+void FrameLimiter::set_frame_rate(std::optional<double> frame_rate)
+{
+    if (frame_rate && frame_rate.value() <= 0.)
+        throw std::invalid_argument("frame rate must be positive");
+    _period = frame_rate
+        ? std::optional<Duration>(std::chrono::duration_cast<Duration>(std::chrono::duration<double>(1. / frame_rate.value())))
+        : std::nullopt;
+    _deadline = TimePoint {};
+}
+
+std::optional<double> FrameLimiter::frame_rate() const
+{
+    if (!_period)
+        return std::nullopt;
+    return 1. / std::chrono::duration<double>(_period.value()).count();
+}
+
+void FrameLimiter::start_frame(TimePoint now)
+{
+    if (!_period)
+        return;
+    //
+    // keep the phase, unless more than a whole frame was missed
+    _deadline += _period.value();
+    if (_deadline < now)
+        _deadline = now + _period.value();
+}
+
+void FrameLimiter::wait_until(TimePoint time_point)
+{
+    struct {
+        TimePoint now() const { return Clock::now(); }
+        void sleep_until(TimePoint time_point) const { std::this_thread::sleep_until(time_point); }
+        void yield() const { std::this_thread::yield(); }
+    } waiter;
+    wait_until(time_point, waiter);
+}
+
+}
@@ -0,0 +1,58 @@
+#pragma once
+
+#include <chrono>
+#include <optional>
+#include <thread>
+
+namespace p3 {
+
+/*
+ * paces frames to a target frame rate on the steady clock. deadlines
+ * advance by whole periods, hence the rate does not drift. waiting is
+ * hybrid: the thread sleeps while the deadline is far away and spins
+ * for the last part, since sleeping is not precise enough.
+ */
+class FrameLimiter {
+public:
+    using Clock = std::chrono::steady_clock;
+    using Duration = Clock::duration;
+    using TimePoint = Clock::time_point;
+
+    /// remaining time for which waiting is done by spinning
+    static constexpr std::chrono::microseconds SpinThreshold { 2000 };
+
+    void set_frame_rate(std::optional<double>);
+    std::optional<double> frame_rate() const;
+
+    std::optional<Duration> period() const { return _period; }
+
+    /// the earliest start of the next frame
+    TimePoint deadline() const { return _deadline; }
+
+    /// to be called when a frame starts
+    void start_frame(TimePoint now = Clock::now());
+
+    /// sleep and spin until the given time point
+    static void wait_until(TimePoint);
+
+    ///
+    /// the same on the time of a waiter, which provides now(),
+    /// sleep_until(TimePoint) and yield(), e.g. a simulated clock
+    template <typename Waiter>
+    static void wait_until(TimePoint, Waiter&);
+
+private:
+    std::optional<Duration> _period = std::nullopt;
+    TimePoint _deadline {};
+};
+
+template <typename Waiter>
+void FrameLimiter::wait_until(TimePoint time_point, Waiter& waiter)
+{
+    if (time_point - waiter.now() > SpinThreshold)
+        waiter.sleep_until(time_point - SpinThreshold);
+    while (waiter.now() < time_point)
+        waiter.yield();
+}
+
+}
@@ -0,0 +1,126 @@
+#include "FrameStatistics.h"
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+namespace p3 {
+
+FrameStatistics::FrameStatistics(std::size_t window)
+    : _window(window)
+{
+    if (window == 0)
+        throw std::invalid_argument("window must not be empty");
+}
+
+void FrameStatistics::add_frame(Duration cpu_time, std::optional<Duration> interval, std::optional<Duration> period)
+{
+    ++_frames;
+    _cpu.add(cpu_time, _window);
+    if (!interval || !period || period.value() <= Duration::zero())
+        return;
+    //
+    // half a period of tolerance for jitter
+    auto const periods = std::llround(double(interval.value().count()) / double(period.value().count()));
+    if (interval.value() > period.value() + period.value() / 2) {
+        ++_late_frames;
+        _dropped_frames += std::size_t(std::max(1ll, periods - 1));
+    }
+}
+
+void FrameStatistics::add_gpu_time(Duration gpu_time)
+{
+    _gpu.add(gpu_time, _window);
+}
+
+FrameStatistics::Summary FrameStatistics::cpu() const
+{
+    return _cpu.summary();
+}
+
+FrameStatistics::Summary FrameStatistics::gpu() const
+{
+    return _gpu.summary();
+}
+
+void FrameStatistics::set_window(std::size_t window)
+{
+    if (window == 0)
+        throw std::invalid_argument("window must not be empty");
+    _window = window;
+    _cpu.resize(window);
+    _gpu.resize(window);
+}
+
+void FrameStatistics::reset()
+{
+    _cpu.clear();
+    _gpu.clear();
+    _frames = _late_frames = _dropped_frames = 0;
+}
+
+std::size_t FrameStatistics::Series::bucket(Duration duration)
+{
+    //
+    // bucket i holds the times in (i * width, (i + 1) * width]
+    if (duration <= Duration::zero())
+        return 0;
+    return std::min(std::size_t((duration - Duration(1)) / BucketWidth), BucketCount);
+}
+
+void FrameStatistics::Series::add(Duration duration, std::size_t window)
+{
+    if (_values.size() < window) {
+        _values.push_back(duration);
+    } else {
+        --_histogram[bucket(_values[_next])];
+        _values[_next] = duration;
+        _next = (_next + 1) % window;
+    }
+    ++_histogram[bucket(duration)];
+}
+
+void FrameStatistics::Series::resize(std::size_t window)
+{
+    //
+    // oldest value first, then keep the latest values
+    std::rotate(_values.begin(), _values.begin() + _next, _values.end());
+    _next = 0;
+    if (_values.size() <= window)
+        return;
+    for (auto it = _values.begin(); it != _values.end() - window; ++it)
+        --_histogram[bucket(*it)];
+    _values.erase(_values.begin(), _values.end() - window);
+}
+
+FrameStatistics::Summary FrameStatistics::Series::summary() const
+{
+    Summary summary;
+    summary.count = _values.size();
+    if (_values.empty())
+        return summary;
+    summary.max = *std::max_element(_values.begin(), _values.end());
+    auto percentile = [&](double p) {
+        auto const rank = std::size_t(std::ceil(p * double(summary.count)));
+        std::size_t cumulative = 0;
+        for (std::size_t i = 0; i < BucketCount; ++i) {
+            cumulative += _histogram[i];
+            if (cumulative >= rank)
+                return std::min(BucketWidth * Duration::rep(i + 1), summary.max);
+        }
+        return summary.max;
+    };
+    summary.p50 = percentile(0.50);
+    summary.p95 = percentile(0.95);
+    summary.p99 = percentile(0.99);
+    return summary;
+}
+
+void FrameStatistics::Series::clear()
+{
+    _values.clear();
+    _next = 0;
+    std::fill(_histogram.begin(), _histogram.end(), 0);
+}
+
+}
@@ -0,0 +1,76 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+namespace p3 {
+
+/*
+ * frame times over a sliding window of frames. the times are counted in
+ * a histogram with buckets of 50us up to 100ms, percentiles are the upper
+ * bounds of the buckets. late frames missed their vertical blank or frame
+ * limiter deadline, dropped frames count the presents which were missed.
+ */
+class FrameStatistics {
+public:
+    using Duration = std::chrono::nanoseconds;
+
+    static constexpr Duration BucketWidth = std::chrono::microseconds(50);
+    static constexpr std::size_t BucketCount = 2000;
+
+    struct Summary {
+        std::size_t count = 0;
+        Duration p50 {};
+        Duration p95 {};
+        Duration p99 {};
+        Duration max {};
+    };
+
+    explicit FrameStatistics(std::size_t window = 600);
+
+    ///
+    /// the interval to the previous present is given only if the frame
+    /// was due right after the previous one, the period if known
+    void add_frame(Duration cpu_time, std::optional<Duration> interval, std::optional<Duration> period);
+    void add_gpu_time(Duration);
+
+    Summary cpu() const;
+    Summary gpu() const;
+
+    std::size_t frames() const { return _frames; }
+    std::size_t late_frames() const { return _late_frames; }
+    std::size_t dropped_frames() const { return _dropped_frames; }
+
+    void set_window(std::size_t);
+    std::size_t window() const { return _window; }
+
+    void reset();
+
+private:
+    class Series {
+    public:
+        void add(Duration, std::size_t window);
+        void resize(std::size_t window);
+        Summary summary() const;
+        void clear();
+
+    private:
+        static std::size_t bucket(Duration);
+
+        std::vector<Duration> _values;
+        std::size_t _next = 0;
+        std::vector<std::uint32_t> _histogram = std::vector<std::uint32_t>(BucketCount + 1, 0);
+    };
+
+    std::size_t _window;
+    Series _cpu;
+    Series _gpu;
+    std::size_t _frames = 0;
+    std::size_t _late_frames = 0;
+    std::size_t _dropped_frames = 0;
+};
+
+}
@@ -0,0 +1,92 @@
+#include "MappedFile.h"
+
+#include <stdexcept>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace p3 {
+
+#ifdef _WIN32
+
+MappedFile::MappedFile(std::filesystem::path const& path)
+{
+    _file = CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (_file == INVALID_HANDLE_VALUE) {
+        _file = nullptr;
+        throw std::runtime_error("failed to open \"" + path.string() + "\"");
+    }
+    LARGE_INTEGER size;
+    if (!GetFileSizeEx(_file, &size)) {
+        CloseHandle(_file);
+        throw std::runtime_error("failed to read size of \"" + path.string() + "\"");
+    }
+    _size = std::size_t(size.QuadPart);
+    //
+    // empty files can't be mapped
+    if (_size == 0)
+        return;
+    _mapping = CreateFileMappingW(_file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (_mapping)
+        _data = static_cast<std::uint8_t const*>(MapViewOfFile(_mapping, FILE_MAP_READ, 0, 0, 0));
+    if (!_data) {
+        if (_mapping)
+            CloseHandle(_mapping);
+        CloseHandle(_file);
+        throw std::runtime_error("failed to map \"" + path.string() + "\"");
+    }
+}
+
+MappedFile::~MappedFile()
+{
+    if (_data)
+        UnmapViewOfFile(_data);
+    if (_mapping)
+        CloseHandle(_mapping);
+    if (_file)
+        CloseHandle(_file);
+}
+
+#else
+
+MappedFile::MappedFile(std::filesystem::path const& path)
+{
+    auto const file = ::open(path.c_str(), O_RDONLY);
+    if (file < 0)
+        throw std::runtime_error("failed to open \"" + path.string() + "\"");
+    struct stat status;
+    if (::fstat(file, &status) != 0) {
+        ::close(file);
+        throw std::runtime_error("failed to read size of \"" + path.string() + "\"");
+    }
+    _size = std::size_t(status.st_size);
+    if (_size != 0) {
+        auto data = ::mmap(nullptr, _size, PROT_READ, MAP_PRIVATE, file, 0);
+        if (data == MAP_FAILED) {
+            ::close(file);
+            throw std::runtime_error("failed to map \"" + path.string() + "\"");
+        }
+        _data = static_cast<std::uint8_t const*>(data);
+    }
+    //
+    // the mapping stays valid without the descriptor
+    ::close(file);
+}
+
+MappedFile::~MappedFile()
+{
+    if (_data)
+        ::munmap(const_cast<std::uint8_t*>(_data), _size);
+}
+
+#endif
+
+}
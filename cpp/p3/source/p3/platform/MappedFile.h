@@ -0,0 +1,32 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+
+namespace p3 {
+
+//
+// read only mapping of a whole file, the pages are loaded on demand
+class MappedFile {
+public:
+    /// throws std::runtime_error if the file can't be mapped
+    explicit MappedFile(std::filesystem::path const&);
+    ~MappedFile();
+
+    MappedFile(MappedFile const&) = delete;
+    MappedFile& operator=(MappedFile const&) = delete;
+
+    std::uint8_t const* data() const { return _data; }
+    std::size_t size() const { return _size; }
+
+private:
+    std::uint8_t const* _data = nullptr;
+    std::size_t _size = 0;
+#ifdef _WIN32
+    void* _file = nullptr;
+    void* _mapping = nullptr;
+#endif
+};
+
+}
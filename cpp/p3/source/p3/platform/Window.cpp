@@ -11,8 +11,12 @@
 #include "event_loop.h"
 
 #include <backends/imgui_impl_glfw.h>
+#include <p3/Profiler.h>
 #include <p3/UserInterface.h>
 #include <p3/backend/OpenGL3RenderBackend.h>
+#include <p3/backend/RasterPresenter.h>
+#include <p3/backend/RasterRenderBackend.h>
+#include <p3/backend/RasterRenderTarget.h>
 #include <p3/log.h>
 
 #include <algorithm>
@@ -20,16 +24,29 @@
 #include <imgui_internal.h>
 #include <implot.h>
 #include <thread>
+#include <utility>
 
 // window -> eventloop : obligaroty
 // eventloop -> window : weak
 
 namespace p3 {
 
-Window::Window(std::string title, std::size_t width, std::size_t height)
+Window::Window(std::string title, std::size_t width, std::size_t height, bool offscreen, Renderer renderer)
     : Node("MainWindow")
-    , _render_backend(std::make_shared<OpenGL3RenderBackend>())
+    , _renderer(renderer)
 {
+    if (_renderer == Renderer::Raster)
+        _render_backend = std::make_shared<RasterRenderBackend>();
+    else
+        _render_backend = std::make_shared<OpenGL3RenderBackend>();
+
+    //
+    // the loop is needed before any node asks for a redraw
+    _event_loop = EventLoop::current();
+    if (!_event_loop)
+        log_fatal("failed to create window, missing active event loop");
+    _event_loop->add_observer(this);
+
     _user_interface = std::make_shared<UserInterface>();
     Node::add(_user_interface);
     _user_interface->set_parent(this);
@@ -37,23 +54,31 @@ Window::Window(std::string title, std::size_t width, std::size_t height)
     ImPlot::SetCurrentContext(&_user_interface->im_plot_context());
     log_debug("window created");
 
-    _event_loop = EventLoop::current();
-    _event_loop->add_observer(this);
-
-    if (!_event_loop)
-        log_fatal("failed to create window, missing active event loop");
-
+    offscreen = offscreen || _event_loop->headless();
+    if (offscreen) {
+        glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE);
+        glfwWindowHint(GLFW_FOCUS_ON_SHOW, GLFW_FALSE);
+    }
+    //
+    // visible raster windows need a context for presenting only
+    if (_renderer == Renderer::Raster && offscreen)
+        glfwWindowHint(GLFW_CLIENT_API, GLFW_NO_API);
     _glfw_window = std::shared_ptr<GLFWwindow>(
         glfwCreateWindow(int(width), int(height), title.c_str(), nullptr, nullptr),
         glfwDestroyWindow);
+    glfwDefaultWindowHints();
 
     if (!_glfw_window)
         throw std::runtime_error("failed to create glfw window");
 
     glfwSetWindowUserPointer(_glfw_window.get(), this);
-    glfwMakeContextCurrent(_glfw_window.get());
-    gladLoadGL(glfwGetProcAddress);
-    glfwSwapInterval(_vsync ? 1 : 0);
+    if (_renderer == Renderer::Raster && !offscreen)
+        _presenter = std::make_unique<RasterPresenter>();
+    if (has_context()) {
+        glfwMakeContextCurrent(_glfw_window.get());
+        gladLoadGL(glfwGetProcAddress);
+        glfwSwapInterval(_vsync ? 1 : 0);
+    }
 
     glfwSetMouseButtonCallback(_glfw_window.get(), GlfwMouseButtonCallback);
     glfwSetScrollCallback(_glfw_window.get(), GlfwScrollCallback);
@@ -61,23 +86,47 @@ Window::Window(std::string title, std::size_t width, std::size_t height)
     glfwSetCharCallback(_glfw_window.get(), GlfwCharCallback);
     glfwSetFramebufferSizeCallback(_glfw_window.get(), GlfwFramebufferSizeCallback);
     glfwSetWindowCloseCallback(_glfw_window.get(), GlfwWindowCloseCallback);
+    glfwSetWindowFocusCallback(_glfw_window.get(), GlfwWindowFocusCallback);
+    glfwSetCursorEnterCallback(_glfw_window.get(), GlfwCursorEnterCallback);
+    glfwSetCursorPosCallback(_glfw_window.get(), GlfwCursorPosCallback);
 
     glfwGetCursorPos(_glfw_window.get(), &_window_state.mouse[0], &_window_state.mouse[1]);
     glfwGetFramebufferSize(_glfw_window.get(), &_window_state.framebuffer_size.width, &_window_state.framebuffer_size.height);
 
     _render_backend->init();
     log_debug("maximum texture size: {}", _render_backend->max_texture_size());
-    ImGui_ImplGlfw_InitForOpenGL(_glfw_window.get(), false);
-    //
-    // TODO: hook and route!
-    glfwSetWindowFocusCallback(_glfw_window.get(), ImGui_ImplGlfw_WindowFocusCallback);
-    glfwSetCursorEnterCallback(_glfw_window.get(), ImGui_ImplGlfw_CursorEnterCallback);
-    glfwSetCursorPosCallback(_glfw_window.get(), ImGui_ImplGlfw_CursorPosCallback);
+    if (offscreen) {
+        _offscreen_target = _render_backend->create_render_target(std::uint32_t(width), std::uint32_t(height));
+        _window_state.framebuffer_size = Size { int(width), int(height) };
+        _render_on_demand = true;
+        set_vsync(false);
+    }
+    if (_renderer == Renderer::OpenGL)
+        ImGui_ImplGlfw_InitForOpenGL(_glfw_window.get(), false);
+    else
+        ImGui_ImplGlfw_InitForOther(_glfw_window.get(), false);
     glfwSetMonitorCallback(ImGui_ImplGlfw_MonitorCallback);
+    update_refresh_period();
+    //
+    // the first frame
+    redraw();
 }
 
 Window::~Window()
 {
+    //
+    // captures of a frame which is never rendered
+    if (!_captures.empty()) {
+        run_in_external_scope([&] {
+            for (auto& promise : _captures)
+                promise.set_exception(std::make_exception_ptr(std::runtime_error("window was closed")));
+        });
+        _captures.clear();
+    }
+    if (_presenter) {
+        make_context_current();
+        _presenter.reset();
+    }
     log_debug("shutdown render backend");
     _render_backend->shutdown();
     log_debug("destroying window");
@@ -89,13 +138,65 @@ void Window::on_work_processed(EventLoop&)
 {
     //
     // removing this can crash the application
-    glfwMakeContextCurrent(_glfw_window.get());
+    make_context_current();
+    //
+    // finished captures resolve their promises (for python with the gil)
+    if (_render_backend->capturing()) {
+        run_in_external_scope([&] { _render_backend->poll_captures(); });
+        if (_render_backend->capturing())
+            schedule_wakeup(EventLoop::Clock::now() + CapturePollInterval);
+    }
 
     if (!_user_interface)
         return;
     ImGui::SetCurrentContext(&_user_interface->im_gui_context());
     ImPlot::SetCurrentContext(&_user_interface->im_plot_context());
 
+    if (_render_on_demand && !_damaged && _settle_frames == 0)
+        return;
+    if (_idle_timeout && _idle_timer.time() > _idle_timeout.value()) {
+        auto const elapsed = _frame_timer.time();
+        if (elapsed < _idle_frame_time) {
+            //
+            // the loop does not wake up periodically, ask for the idle frame
+            schedule_wakeup(EventLoop::Clock::now()
+                + std::chrono::duration_cast<EventLoop::Duration>(_idle_frame_time - elapsed));
+            return;
+        }
+    }
+    //
+    // sleep in the loop while the frame is far away, spin for the rest
+    auto const deadline = frame_deadline();
+    auto const remaining = deadline - FrameLimiter::Clock::now();
+    if (remaining > FrameLimiter::SpinThreshold) {
+        schedule_wakeup(EventLoop::Clock::now()
+            + std::chrono::duration_cast<EventLoop::Duration>(remaining - FrameLimiter::SpinThreshold));
+        return;
+    }
+    FrameLimiter::wait_until(deadline);
+    render_frame();
+}
+
+void Window::frame()
+{
+    make_context_current();
+    if (!_user_interface)
+        return;
+    ImGui::SetCurrentContext(&_user_interface->im_gui_context());
+    ImPlot::SetCurrentContext(&_user_interface->im_plot_context());
+    render_frame();
+}
+
+void Window::render_frame()
+{
+    P3_PROFILE_ZONE("window.frame");
+    auto const frame_start = FrameLimiter::Clock::now();
+    _frame_limiter.start_frame(frame_start);
+    //
+    // late latching, take the input which arrived while waiting
+    if (_low_latency)
+        glfwPollEvents();
+
     MousePosition mouse_position;
     glfwGetCursorPos(_glfw_window.get(), &(mouse_position[0]), &mouse_position[1]);
     Context::MouseMove mouse_move = std::nullopt;
@@ -107,27 +208,99 @@ void Window::on_work_processed(EventLoop&)
         std::swap(_window_state.mouse, mouse_position);
     }
     if (mouse_move)
-        _idle_timer.reset();
+        on_input();
+    auto const input_time = std::exchange(_input_time, std::nullopt);
 
-    if (_idle_timeout) {
-        if (_idle_timer.time() > _idle_timeout.value() && _frame_timer.time() < _idle_frame_time) {
-            return;
-        }
-    }
     _frame_timer.reset();
+    _damaged = false;
+    if (_settle_frames > 0)
+        --_settle_frames;
     if (_user_interface) {
         _render_backend->new_frame();
-        glClear(GL_COLOR_BUFFER_BIT);
+        if (_renderer == Renderer::OpenGL)
+            glClear(GL_COLOR_BUFFER_BIT);
         ImGui_ImplGlfw_NewFrame();
+        if (_offscreen_target) {
+            //
+            // the hidden window may have another size, e.g. on hidpi screens
+            auto& io = ImGui::GetIO();
+            io.DisplaySize = ImVec2(float(_window_state.framebuffer_size.width), float(_window_state.framebuffer_size.height));
+            io.DisplayFramebufferScale = ImVec2(1.f, 1.f);
+        }
+        if (_presenter)
+            update_present_target();
         {
             _render_backend->gc(); // needs to be locked/synchonized
             Context context(*_user_interface, *_render_backend, mouse_move);
             _user_interface->render(context, float(_window_state.framebuffer_size.width), float(_window_state.framebuffer_size.height), false);
+            context.dispatch_mouse_events();
+        }
+        if (auto target = frame_target()) {
+            //
+            // nodes with own render targets release them to the default
+            // framebuffer while rendering, hence bind the window target late
+            target->bind();
+            if (_renderer == Renderer::OpenGL)
+                glClear(GL_COLOR_BUFFER_BIT);
+        } else {
+            glViewport(0, 0, _window_state.framebuffer_size.width, _window_state.framebuffer_size.height);
         }
-        glViewport(0, 0, _window_state.framebuffer_size.width, _window_state.framebuffer_size.height);
-        if (_user_interface)
+        if (_user_interface) {
+            P3_PROFILE_ZONE("imgui.submit");
             _render_backend->render(*_user_interface);
-        glfwSwapBuffers(_glfw_window.get());
+        }
+        for (auto& promise : _captures) {
+            _render_backend->capture(frame_target(),
+                std::uint32_t(_window_state.framebuffer_size.width),
+                std::uint32_t(_window_state.framebuffer_size.height),
+                true,
+                RenderBackend::resolve(std::move(promise)));
+        }
+        _captures.clear();
+        auto const cpu_time = FrameLimiter::Clock::now() - frame_start;
+        //
+        // in low latency mode the swap is synchronized, such that the
+        // time of the vertical blank is known for the next frame
+        if (_low_latency && _renderer == Renderer::OpenGL)
+            glFinish();
+        auto const render_time = FrameLimiter::Clock::now() - frame_start;
+        _render_time = std::max(render_time, _render_time - (_render_time - render_time) / 16);
+        if (_offscreen_target) {
+            _offscreen_target->release();
+        } else {
+            P3_PROFILE_ZONE("window.swap");
+            if (_presenter) {
+                _present_target->release();
+                _presenter->present(static_cast<RasterRenderTarget*>(_present_target)->bitmap().pixmap());
+            }
+            glfwSwapBuffers(_glfw_window.get());
+            if (_low_latency)
+                glFinish();
+        }
+        auto const previous_present_time = std::exchange(_present_time, FrameLimiter::Clock::now());
+        //
+        // the interval only tells about late frames if this frame was
+        // due right after the previous one
+        auto const period = _frame_limiter.period()
+            ? _frame_limiter.period()
+            : (_vsync ? std::optional<FrameLimiter::Duration>(_refresh_period) : std::nullopt);
+        _frame_statistics.add_frame(cpu_time,
+            _frame_due && previous_present_time != FrameLimiter::TimePoint {}
+                ? std::optional<FrameLimiter::Duration>(_present_time - previous_present_time)
+                : std::nullopt,
+            period);
+        while (auto gpu_time = _render_backend->resolve_gpu_time())
+            _frame_statistics.add_gpu_time(gpu_time.value());
+        if (input_time) {
+            auto const latency = std::chrono::duration<double>(_present_time - input_time.value()).count();
+            _input_latency = _input_latency == 0. ? latency : 0.9 * _input_latency + 0.1 * latency;
+        }
+        //
+        // active items (dragging, text input) animate without further input
+        if (ImGui::IsAnyItemActive())
+            _settle_frames = std::max(_settle_frames, 1);
+        if (_settle_frames > 0)
+            _event_loop->wake_up();
     }
     if (!_key_release_events.empty()) {
         for (auto& e : _key_release_events)
@@ -135,6 +308,7 @@ void Window::on_work_processed(EventLoop&)
         _key_release_events.clear();
         redraw();
     }
+    _frame_due = _damaged || _settle_frames > 0;
 }
 
 void Window::set_title(std::string title)
@@ -158,7 +332,10 @@ void Window::set_user_interface(std::shared_ptr<UserInterface> user_interface)
         ImGui::SetCurrentContext(&_user_interface->im_gui_context());
         ImPlot::SetCurrentContext(&_user_interface->im_plot_context());
         // _render_backend = std::make_shared < OpenGL3RenderBackend>();
-        ImGui_ImplGlfw_InitForOpenGL(_glfw_window.get(), false);
+        if (_renderer == Renderer::OpenGL)
+            ImGui_ImplGlfw_InitForOpenGL(_glfw_window.get(), false);
+        else
+            ImGui_ImplGlfw_InitForOther(_glfw_window.get(), false);
         _render_backend->init();
         log_debug("done");
     }
@@ -174,8 +351,34 @@ bool Window::closed() const
     return glfwWindowShouldClose(_glfw_window.get());
 }
 
+bool Window::offscreen() const
+{
+    return _offscreen_target != nullptr;
+}
+
+void Window::read_pixels(std::uint8_t* rgba)
+{
+    if (!_offscreen_target)
+        throw std::runtime_error("pixels can only be read from offscreen windows");
+    make_context_current();
+    _offscreen_target->read_pixels(rgba, true);
+}
+
+void Window::capture(Promise<Pixels> promise)
+{
+    _captures.push_back(std::move(promise));
+    redraw();
+}
+
+Window::Renderer Window::renderer() const
+{
+    return _renderer;
+}
+
 Window::Size Window::framebuffer_size() const
 {
+    if (_offscreen_target)
+        return _window_state.framebuffer_size;
     Size size;
     glfwGetFramebufferSize(_glfw_window.get(), &size.width, &size.height);
     return size;
@@ -223,7 +426,8 @@ void Window::set_video_mode(std::optional<VideoMode> mode)
             nullptr,
             _position.x, _position.y, _size.width, _size.height, 0);
     }
-    glfwSwapInterval(_vsync ? 1 : 0);
+    set_vsync(_vsync);
+    update_refresh_period();
 }
 
 Window::Position Window::position() const
@@ -250,6 +454,13 @@ Window::Size Window::size() const
 
 void Window::set_size(Size size)
 {
+    if (_offscreen_target) {
+        make_context_current();
+        _render_backend->delete_render_target(_offscreen_target);
+        _offscreen_target = _render_backend->create_render_target(std::uint32_t(size.width), std::uint32_t(size.height));
+        _window_state.framebuffer_size = size;
+        redraw();
+    }
     if (glfwGetWindowMonitor(_glfw_window.get()))
         _size = std::move(size);
     else
@@ -275,7 +486,8 @@ std::vector<Monitor> Window::monitors() const
 void Window::set_vsync(bool vsync)
 {
     _vsync = vsync;
-    glfwSwapInterval(_vsync ? 1 : 0);
+    if (has_context())
+        glfwSwapInterval(_vsync ? 1 : 0);
 }
 
 bool Window::vsync() const
@@ -283,10 +495,64 @@ bool Window::vsync() const
     return _vsync;
 }
 
+bool Window::has_context() const
+{
+    //
+    // offscreen raster windows have no context
+    return _renderer == Renderer::OpenGL || _presenter;
+}
+
+void Window::make_context_current()
+{
+    if (has_context())
+        glfwMakeContextCurrent(_glfw_window.get());
+}
+
+RenderBackend::RenderTarget* Window::frame_target() const
+{
+    return _offscreen_target ? _offscreen_target : _present_target;
+}
+
+void Window::update_present_target()
+{
+    //
+    // raster windows render into a target of the framebuffer size, which
+    // is presented after rendering. minimized windows keep the last one
+    auto const width = std::uint32_t(_window_state.framebuffer_size.width);
+    auto const height = std::uint32_t(_window_state.framebuffer_size.height);
+    if (width == 0 || height == 0)
+        return;
+    if (_present_target && _present_target->width() == width && _present_target->height() == height)
+        return;
+    if (_present_target)
+        _render_backend->delete_render_target(_present_target);
+    _present_target = _render_backend->create_render_target(width, height);
+}
+
+void Window::on_input()
+{
+    if (!_input_time)
+        _input_time = FrameLimiter::Clock::now();
+    _idle_timer.reset();
+    _settle_frames = SettleFrames;
+    redraw();
+}
+
+void Window::schedule_wakeup(EventLoop::TimePoint time_point)
+{
+    if (_wakeup && _wakeup.value() <= time_point)
+        return;
+    _wakeup = time_point;
+    _event_loop->call_at(time_point, Event::create([weak_self = weak_from_this()]() {
+        if (auto self = std::static_pointer_cast<Window>(weak_self.lock()))
+            self->_wakeup = std::nullopt;
+    }));
+}
+
 void Window::GlfwMouseButtonCallback(GLFWwindow* window, int button, int action, int mods)
 {
     auto self = static_cast<Window*>(glfwGetWindowUserPointer(window));
-    self->_idle_timer.reset();
+    self->on_input();
     ImGui_ImplGlfw_MouseButtonCallback(window, button, action, mods);
 }
 
@@ -295,13 +561,17 @@ void Window::GlfwWindowCloseCallback(GLFWwindow* window)
     auto self = static_cast<Window*>(glfwGetWindowUserPointer(window));
     log_debug("closing window");
     if (self->_close_callback) {
-        self->_event_loop->call_at(EventLoop::Clock::now(), Event::create(self->_close_callback));
+        self->_event_loop->call_at(EventLoop::Clock::now(), Event::create([weak_self = self->weak_from_this()]() {
+            auto self = std::static_pointer_cast<Window>(weak_self.lock());
+            if (self && self->_close_callback)
+                self->_close_callback();
+        }));
     }
 }
 
 void Window::GlfwScrollCallback(GLFWwindow* window, double xoffset, double yoffset)
 {
-    static_cast<Window*>(glfwGetWindowUserPointer(window))->_idle_timer.reset();
+    static_cast<Window*>(glfwGetWindowUserPointer(window))->on_input();
     ImGui_ImplGlfw_ScrollCallback(window, xoffset, yoffset);
 }
 
@@ -319,27 +589,42 @@ void Window::GlfwKeyCallback(GLFWwindow* glfw_window, int key, int scancode, int
                          }),
             events.end());
         ImGui_ImplGlfw_KeyCallback(glfw_window, key, scancode, action, mods);
-        window->_idle_timer.reset();
+        window->on_input();
     }
 }
 
 void Window::GlfwCharCallback(GLFWwindow* window, unsigned int c)
 {
-    static_cast<Window*>(glfwGetWindowUserPointer(window))->_idle_timer.reset();
+    static_cast<Window*>(glfwGetWindowUserPointer(window))->on_input();
     ImGui_ImplGlfw_CharCallback(window, c);
 }
 
 void Window::GlfwFramebufferSizeCallback(GLFWwindow* window, int w, int h)
 {
     auto self = static_cast<Window*>(glfwGetWindowUserPointer(window));
+    if (self->_offscreen_target)
+        return;
     self->_window_state.framebuffer_size.width = w;
     self->_window_state.framebuffer_size.height = h;
-    self->_idle_timer.reset();
+    self->on_input();
 }
 
 void Window::GlfwCursorPosCallback(GLFWwindow* window, double x, double y)
 {
-    static_cast<Window*>(glfwGetWindowUserPointer(window))->_idle_timer.reset();
+    static_cast<Window*>(glfwGetWindowUserPointer(window))->on_input();
+    ImGui_ImplGlfw_CursorPosCallback(window, x, y);
+}
+
+void Window::GlfwWindowFocusCallback(GLFWwindow* window, int focused)
+{
+    static_cast<Window*>(glfwGetWindowUserPointer(window))->on_input();
+    ImGui_ImplGlfw_WindowFocusCallback(window, focused);
+}
+
+void Window::GlfwCursorEnterCallback(GLFWwindow* window, int entered)
+{
+    static_cast<Window*>(glfwGetWindowUserPointer(window))->on_input();
+    ImGui_ImplGlfw_CursorEnterCallback(window, entered);
 }
 
 void Window::set_idle_timeout(std::optional<Seconds> idle_timeout)
@@ -362,6 +647,78 @@ Window::Seconds Window::idle_frame_time() const
     return _idle_frame_time;
 }
 
+FrameLimiter::TimePoint Window::frame_deadline() const
+{
+    auto deadline = _frame_limiter.deadline();
+    if (_low_latency) {
+        //
+        // start as late as possible to be ready for the next present
+        auto const period = _frame_limiter.period().value_or(_refresh_period);
+        deadline = std::max(deadline, _present_time + period - _render_time - LatencyMargin);
+    }
+    return deadline;
+}
+
+void Window::update_refresh_period()
+{
+    auto monitor = glfwGetWindowMonitor(_glfw_window.get());
+    if (!monitor)
+        monitor = glfwGetPrimaryMonitor();
+    auto mode = monitor ? glfwGetVideoMode(monitor) : nullptr;
+    if (mode && mode->refreshRate > 0)
+        _refresh_period = std::chrono::duration_cast<FrameLimiter::Duration>(
+            std::chrono::duration<double>(1. / mode->refreshRate));
+}
+
+void Window::set_target_frame_rate(std::optional<double> frame_rate)
+{
+    _frame_limiter.set_frame_rate(frame_rate);
+    redraw();
+}
+
+std::optional<double> Window::target_frame_rate() const
+{
+    return _frame_limiter.frame_rate();
+}
+
+void Window::set_low_latency(bool low_latency)
+{
+    _low_latency = low_latency;
+    update_refresh_period();
+    redraw();
+}
+
+bool Window::low_latency() const
+{
+    return _low_latency;
+}
+
+double Window::input_latency() const
+{
+    return _input_latency;
+}
+
+FrameStatistics& Window::frame_statistics()
+{
+    return _frame_statistics;
+}
+
+FrameStatistics const& Window::frame_statistics() const
+{
+    return _frame_statistics;
+}
+
+void Window::set_render_on_demand(bool render_on_demand)
+{
+    _render_on_demand = render_on_demand;
+    redraw();
+}
+
+bool Window::render_on_demand() const
+{
+    return _render_on_demand;
+}
+
 Monitor Window::monitor() const
 {
     auto handle = glfwGetWindowMonitor(_glfw_window.get());
@@ -399,8 +756,9 @@ double Monitor::dpi() const
 void Window::redraw()
 {
     //
-    // wake up the loop if sleeping
-    glfwPostEmptyEvent();
+    // wake up the loop if sleeping, once per frame
+    if (!_damaged.exchange(true))
+        _event_loop->wake_up();
 }
 
 void Window::set_needs_update()
@@ -1,15 +1,19 @@
+#include "FrameLimiter.h"
+#include "FrameStatistics.h"
 #include "Monitor.h"
 #include "Timer.h"
 #include "event_loop.h"
 
 #include <p3/Context.h>
 #include <p3/Node.h>
+#include <p3/Promise.h>
 #include <p3/Theme.h>
 
 #include <imgui.h>
 
 #include <atomic>
 #include <chrono>
+#include <cstdint>
 #include <functional>
 #include <memory>
 #include <optional>
@@ -24,6 +28,7 @@ class EventLoop;
 class ChildWindow;
 class MenuBar;
 class Popup;
+class RasterPresenter;
 class RenderBackend;
 
 class Window
@@ -45,7 +50,19 @@ public:
         int height;
     };
 
-    Window(std::string title, std::size_t width, std::size_t height);
+    ///
+    /// raster windows render on the cpu. visible raster windows create a
+    /// gl context only to present the frames, offscreen ones create none
+    enum class Renderer {
+        OpenGL,
+        Raster
+    };
+
+    ///
+    /// offscreen windows are invisible and render into a framebuffer object
+    /// of the given size. they render on demand and do not swap. on a loop
+    /// without display every window is offscreen
+    Window(std::string title, std::size_t width, std::size_t height, bool offscreen = false, Renderer = Renderer::OpenGL);
     ~Window();
 
     //
@@ -58,9 +75,24 @@ public:
     void set_user_interface(std::shared_ptr<UserInterface>);
     std::shared_ptr<UserInterface> user_interface() const;
 
+    ///
+    /// renders a frame now, regardless of pacing and render on demand
     void frame();
     bool closed() const;
 
+    bool offscreen() const;
+    Renderer renderer() const;
+
+    ///
+    /// copies the last frame of an offscreen window into rgba, which must
+    /// hold width * height * 4 bytes. rows are ordered from top to bottom
+    void read_pixels(std::uint8_t* rgba);
+
+    ///
+    /// captures the next frame. the pixels are read back without stalling
+    /// the pipeline, the promise is resolved frames later
+    void capture(Promise<Pixels>);
+
     std::optional<VideoMode> video_mode() const;
     void set_video_mode(std::optional<VideoMode>);
 
@@ -88,6 +120,32 @@ public:
     double frames_per_second() const;
     double time_till_enter_idle_mode() const;
 
+    ///
+    /// if enabled, frames are only rendered when input arrived, a node was
+    /// invalidated or redraw() was called. otherwise every wakeup of the
+    /// event loop renders a frame
+    void set_render_on_demand(bool);
+    bool render_on_demand() const;
+
+    ///
+    /// frames are paced to this rate, in addition to vsync
+    void set_target_frame_rate(std::optional<double>);
+    std::optional<double> target_frame_rate() const;
+
+    ///
+    /// in low latency mode the window waits as long as possible before it
+    /// samples input and renders, such that the frame is just ready when
+    /// it needs to be presented
+    void set_low_latency(bool);
+    bool low_latency() const;
+
+    /// smoothed time in seconds from input till the frame is presented
+    double input_latency() const;
+
+    /// cpu and gpu frame times, late and dropped frames
+    FrameStatistics& frame_statistics();
+    FrameStatistics const& frame_statistics() const;
+
     void redraw() override;
     void set_needs_update() override final;
 
@@ -100,7 +158,15 @@ private:
     bool _vsync = true;
     std::string _title;
 
+    Renderer _renderer;
     std::shared_ptr<RenderBackend> _render_backend;
+    RenderBackend::RenderTarget* _offscreen_target = nullptr;
+    //
+    // target and presenter of visible raster windows
+    RenderBackend::RenderTarget* _present_target = nullptr;
+    std::unique_ptr<RasterPresenter> _presenter;
+    std::vector<Promise<Pixels>> _captures;
+    static constexpr std::chrono::milliseconds CapturePollInterval { 1 };
 
     struct
     {
@@ -119,6 +185,41 @@ private:
     std::optional<Seconds> _idle_timeout = std::nullopt;
     Seconds _idle_frame_time = Seconds(1);
 
+    //
+    // imgui needs a few frames to settle after input, e.g. for
+    // popups which are measured in the frame before they appear
+    static constexpr int SettleFrames = 3;
+
+    bool _render_on_demand = false;
+    std::atomic<bool> _damaged { false };
+    int _settle_frames = 0;
+    std::optional<EventLoop::TimePoint> _wakeup = std::nullopt;
+
+    //
+    // frame pacing. the render time is an estimate which follows
+    // increases immediately and decreases slowly
+    static constexpr std::chrono::microseconds LatencyMargin { 1000 };
+
+    FrameLimiter _frame_limiter;
+    bool _low_latency = false;
+    FrameLimiter::Duration _refresh_period = std::chrono::microseconds(16667);
+    FrameLimiter::Duration _render_time {};
+    FrameLimiter::TimePoint _present_time {};
+    std::optional<FrameLimiter::TimePoint> _input_time = std::nullopt;
+    double _input_latency = 0.;
+    FrameStatistics _frame_statistics;
+    bool _frame_due = false;
+
+    bool has_context() const;
+    void make_context_current();
+    RenderBackend::RenderTarget* frame_target() const;
+    void update_present_target();
+    void render_frame();
+    void on_input();
+    void schedule_wakeup(EventLoop::TimePoint);
+    void update_refresh_period();
+    FrameLimiter::TimePoint frame_deadline() const;
+
 private:
     static void GlfwMouseButtonCallback(GLFWwindow* window, int button, int action, int mods);
     static void GlfwScrollCallback(GLFWwindow* window, double xoffset, double yoffset);
@@ -127,6 +228,8 @@ private:
     static void GlfwFramebufferSizeCallback(GLFWwindow* window, int, int);
     static void GlfwCursorPosCallback(GLFWwindow* window, double, double);
     static void GlfwWindowCloseCallback(GLFWwindow* window);
+    static void GlfwWindowFocusCallback(GLFWwindow* window, int focused);
+    static void GlfwCursorEnterCallback(GLFWwindow* window, int entered);
 
     struct KeyReleaseEvent {
         int key;
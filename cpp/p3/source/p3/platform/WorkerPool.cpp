@@ -0,0 +1,77 @@
+#include "WorkerPool.h"
+
+namespace p3 {
+
+WorkerPool::WorkerPool(std::size_t threads)
+{
+    _threads.reserve(threads);
+    for (std::size_t i = 0; i < threads; ++i)
+        _threads.emplace_back([this]() { run(); });
+}
+
+WorkerPool::~WorkerPool()
+{
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _stopped = true;
+    }
+    _wake_up.notify_all();
+    for (auto& thread : _threads)
+        thread.join();
+}
+
+void WorkerPool::parallel_for(std::size_t count, std::function<void(std::size_t)> const& f)
+{
+    std::lock_guard<std::mutex> call_lock(_call_mutex);
+    if (_threads.empty() || count < 2) {
+        for (std::size_t i = 0; i < count; ++i)
+            f(i);
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _task = &f;
+        _count = count;
+        _next = 0;
+        _pending = count;
+        ++_generation;
+    }
+    _wake_up.notify_all();
+    auto const finished = work();
+    std::unique_lock<std::mutex> lock(_mutex);
+    _pending -= finished;
+    //
+    // workers which woke up late must leave before the next call
+    // resets the counter
+    _done.wait(lock, [&] { return _pending == 0 && _active == 0; });
+}
+
+void WorkerPool::run()
+{
+    std::uint64_t generation = 0;
+    std::unique_lock<std::mutex> lock(_mutex);
+    while (true) {
+        _wake_up.wait(lock, [&] { return _stopped || _generation != generation; });
+        if (_stopped)
+            return;
+        generation = _generation;
+        ++_active;
+        lock.unlock();
+        auto const finished = work();
+        lock.lock();
+        --_active;
+        _pending -= finished;
+        if (_pending == 0 && _active == 0)
+            _done.notify_one();
+    }
+}
+
+std::size_t WorkerPool::work()
+{
+    std::size_t finished = 0;
+    for (auto i = _next++; i < _count; i = _next++, ++finished)
+        (*_task)(i);
+    return finished;
+}
+
+}
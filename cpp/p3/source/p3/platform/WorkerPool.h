@@ -0,0 +1,51 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace p3 {
+
+/*
+ * persistent threads for data parallel work, such that a call does not
+ * pay for thread creation. parallel_for hands out the indices one by one,
+ * the calling thread takes part. calls are serialized.
+ */
+class WorkerPool {
+public:
+    /// additional threads, zero runs everything on the calling thread
+    explicit WorkerPool(std::size_t threads);
+    ~WorkerPool();
+
+    WorkerPool(WorkerPool const&) = delete;
+    WorkerPool& operator=(WorkerPool const&) = delete;
+
+    std::size_t thread_count() const { return _threads.size(); }
+
+    ///
+    /// calls f(0) .. f(count - 1) on the workers and the calling thread
+    void parallel_for(std::size_t count, std::function<void(std::size_t)> const& f);
+
+private:
+    void run();
+    std::size_t work();
+
+    std::mutex _call_mutex;
+    std::vector<std::thread> _threads;
+    std::mutex _mutex;
+    std::condition_variable _wake_up;
+    std::condition_variable _done;
+    bool _stopped = false;
+    std::uint64_t _generation = 0;
+    std::size_t _active = 0;
+    std::size_t _pending = 0;
+    std::function<void(std::size_t)> const* _task = nullptr;
+    std::size_t _count = 0;
+    std::atomic<std::size_t> _next { 0 };
+};
+
+}
@@ -1,191 +1,385 @@
-#include "event_loop.h"
-
-#define NOMINMAX
-#include "Window.h"
-
-#define GLFW_INCLUDE_NONE
-#pragma warning(push)
-#pragma warning(disable : 4005)
-#include <GLFW/glfw3.h>
-#include <glad/gl.h>
-#pragma warning(pop)
-
-#include <p3/log.h>
-
-#include <algorithm>
-#include <iostream>
-
-namespace {
-
-struct event_comparator {
-    template <typename T>
-    bool operator()(const T& l, const T& r) const { return l.first > r.first; }
-};
-
-}
-
-namespace p3 {
-
-std::function<void(std::function<void()>)> run_in_external_scope = [](std::function<void()> callback) {
-    callback();
-};
-
-namespace {
-    thread_local EventLoop* thread_local_event_loop = nullptr;
-    thread_local std::thread::id thread_id;
-}
-
-std::shared_ptr<EventLoop> EventLoop::current()
-{
-    if (thread_local_event_loop == nullptr)
-        return nullptr;
-    return thread_local_event_loop->shared_from_this();
-}
-
-EventLoop::EventLoop()
-{
-    thread_local_event_loop = this;
-    thread_id = std::this_thread::get_id();
-    //
-    // assumes that the event loop belongs to the current thread
-    if (!glfwInit())
-        log_fatal("could not init glfw");
-    //
-    // terminate on error
-    glfwSetErrorCallback([](int code, char const* text) {
-        log_warn("glfw error, code={}, text=\"{}\"", code, text);
-    });
-}
-
-EventLoop::~EventLoop()
-{
-    close();
-    glfwTerminate();
-}
-
-class FunctionalEvent : public Event {
-public:
-    FunctionalEvent(std::function<void()> function)
-        : _function(std::move(function))
-    {
-    }
-
-    virtual void operator()()
-    {
-        _function();
-    };
-
-private:
-    std::function<void()> _function;
-};
-
-std::unique_ptr<Event> Event::create(std::function<void()> function)
-{
-    return std::make_unique<FunctionalEvent>(std::move(function));
-}
-
-void EventLoop::run_forever()
-{
-    {
-        std::lock_guard<std::mutex> l(_mutex);
-        if (_closed)
-            throw std::runtime_error("loop was closed already");
-        _stopped = false;
-    }
-    while (true) {
-        EventLoop::Work work;
-        double timeout = 0.5;
-        {
-            std::lock_guard<std::mutex> l(_mutex);
-
-            if (_stopped)
-                break;
-            auto now = Clock::now();
-            while (!_queue.empty()) {
-                auto diff = _queue.front().first - now;
-                if (diff <= Duration::zero()) {
-                    work.push_back(std::move(_queue.front().second));
-                    std::pop_heap(_queue.begin(), _queue.end(), event_comparator());
-                    _queue.pop_back();
-                } else {
-                    auto duration = _queue.front().first - now;
-                    auto seconds = std::chrono::duration<double>(duration).count();
-                    timeout = std::max(0., std::min(timeout, seconds));
-                    break;
-                }
-            }
-        }
-        //
-        // without lock do..
-        if (work.empty()) {
-            //
-            // wait for 500ms or less time
-            glfwWaitEventsTimeout(timeout);
-        } else {
-            //
-            // (for python we need to acquire the gil)
-            run_in_external_scope([&] {
-                for (auto& item : work) {
-                    try {
-                        (*item)();
-                    } catch (std::exception& e) {
-                        log_error("error: {}", e.what());
-                        throw;
-                    }
-                }
-                work.clear();
-            });
-            glfwPollEvents();
-        }
-        //
-        // render..
-        for (auto observer : _observer)
-            observer->on_work_processed(*this);
-    }
-}
-
-void EventLoop::call_at(TimePoint time_point, std::unique_ptr<Event> event)
-{
-    {
-        std::lock_guard<std::mutex> l(_mutex);
-        if (_closed)
-            throw std::runtime_error("cannot schedule task on a closed loop");
-        _queue.emplace_back(time_point, std::move(event));
-        std::push_heap(_queue.begin(), _queue.end(), event_comparator());
-    }
-    //
-    // https://stackoverflow.com/questions/17101922/do-i-have-to-acquire-lock-before-calling-condition-variable-notify-one
-    glfwPostEmptyEvent();
-    // auto tid = std::this_thread::get_id();
-}
-
-void EventLoop::close()
-{
-    EventLoop::Queue temp;
-    log_debug("closing event loop");
-    {
-        std::lock_guard<std::mutex> l(_mutex);
-        if (!_stopped)
-            log_fatal("cannot close a running loop");
-        std::swap(_queue, temp);
-        _closed = true;
-    }
-    if (!temp.empty()) {
-        run_in_external_scope([&] {
-            temp.clear();
-        });
-    }
-}
-
-void EventLoop::stop()
-{
-    {
-        std::lock_guard<std::mutex> l(_mutex);
-        _stopped = true;
-    }
-    //
-    // make sure thread will process the change of the flag
-    glfwPostEmptyEvent();
-}
-
-}
+#include "event_loop.h"
+
+#define NOMINMAX
+#include "Window.h"
+
+#define GLFW_INCLUDE_NONE
+#pragma warning(push)
+#pragma warning(disable : 4005)
+#include <GLFW/glfw3.h>
+#include <glad/gl.h>
+#pragma warning(pop)
+
+#include <p3/Profiler.h>
+#include <p3/log.h>
+
+#include <algorithm>
+#include <array>
+#include <cstdlib>
+#include <iostream>
+#include <new>
+
+namespace p3 {
+
+std::function<void(std::function<void()>)> run_in_external_scope = [](std::function<void()> callback) {
+    callback();
+};
+
+namespace {
+    thread_local EventLoop* thread_local_event_loop = nullptr;
+    thread_local std::thread::id thread_id;
+}
+
+std::shared_ptr<EventLoop> EventLoop::current()
+{
+    if (thread_local_event_loop == nullptr)
+        return nullptr;
+    return thread_local_event_loop->shared_from_this();
+}
+
+EventLoop::EventLoop()
+{
+    thread_local_event_loop = this;
+    thread_id = std::this_thread::get_id();
+#if defined(GLFW_PLATFORM_NULL) && defined(__linux__)
+    //
+    // servers and ci machines without display, windows are offscreen and
+    // their contexts are created by osmesa (llvmpipe)
+    if (!std::getenv("DISPLAY") && !std::getenv("WAYLAND_DISPLAY"))
+        glfwInitHint(GLFW_PLATFORM, GLFW_PLATFORM_NULL);
+#endif
+    //
+    // assumes that the event loop belongs to the current thread
+    if (!glfwInit())
+        log_fatal("could not init glfw");
+#if defined(GLFW_PLATFORM_NULL)
+    _headless = glfwGetPlatform() == GLFW_PLATFORM_NULL;
+    if (_headless)
+        log_info("no display, running headless");
+#endif
+    //
+    // terminate on error
+    glfwSetErrorCallback([](int code, char const* text) {
+        log_warn("glfw error, code={}, text=\"{}\"", code, text);
+    });
+}
+
+EventLoop::~EventLoop()
+{
+    close();
+    glfwTerminate();
+}
+
+namespace {
+
+    //
+    // free lists for size classes of 64, 128, 256 and 512 bytes. the lists
+    // are intrusive, a free block stores the pointer to the next one.
+    // each thread keeps its own lists and exchanges batches of blocks with
+    // the shared lists, hence the mutex is taken once per batch only.
+    // larger events and blocks beyond the limit go to the heap
+    class EventPool {
+    public:
+        static constexpr std::size_t ClassCount = 4;
+        static constexpr std::size_t MinimumSize = 64;
+        static constexpr std::size_t MaximumFree = 1024;
+        static constexpr std::size_t BatchSize = 32;
+
+        struct Block {
+            Block* next;
+        };
+        struct FreeList {
+            Block* head = nullptr;
+            std::size_t count = 0;
+
+            void push(Block* block)
+            {
+                block->next = head;
+                head = block;
+                ++count;
+            }
+
+            Block* pop()
+            {
+                auto block = head;
+                head = block->next;
+                --count;
+                return block;
+            }
+        };
+        using FreeLists = std::array<FreeList, ClassCount>;
+
+        static std::size_t size_class(std::size_t size)
+        {
+            std::size_t index = 0;
+            while (index < ClassCount && (MinimumSize << index) < size)
+                ++index;
+            return index;
+        }
+
+        /// moves a batch of shared blocks to the list of a thread
+        void refill(std::size_t index, FreeList& list)
+        {
+            std::lock_guard<std::mutex> l(_mutex);
+            auto& shared = _free[index];
+            while (shared.head && list.count < BatchSize)
+                list.push(shared.pop());
+        }
+
+        /// returns blocks of a thread, blocks beyond the limit are freed
+        void release(std::size_t index, FreeList& list, std::size_t count)
+        {
+            FreeList batch;
+            while (list.head && batch.count < count)
+                batch.push(list.pop());
+            {
+                std::lock_guard<std::mutex> l(_mutex);
+                auto& shared = _free[index];
+                while (batch.head && shared.count < MaximumFree)
+                    shared.push(batch.pop());
+            }
+            while (batch.head)
+                ::operator delete(batch.pop());
+        }
+
+    private:
+        std::mutex _mutex;
+        FreeLists _free;
+    };
+
+    //
+    // never destroyed, events may outlive static destruction
+    EventPool& event_pool()
+    {
+        static auto pool = new EventPool();
+        return *pool;
+    }
+
+    //
+    // events may be destroyed by a thread after its cache, the
+    // shared lists are used directly then
+    thread_local bool thread_cache_destroyed = false;
+
+    class ThreadCache {
+    public:
+        ~ThreadCache()
+        {
+            for (std::size_t index = 0; index < EventPool::ClassCount; ++index)
+                event_pool().release(index, _free[index], _free[index].count);
+            thread_cache_destroyed = true;
+        }
+
+        void* allocate(std::size_t index)
+        {
+            auto& free = _free[index];
+            if (!free.head)
+                event_pool().refill(index, free);
+            if (free.head)
+                return free.pop();
+            return ::operator new(EventPool::MinimumSize << index);
+        }
+
+        void deallocate(void* pointer, std::size_t index)
+        {
+            auto& free = _free[index];
+            free.push(new (pointer) EventPool::Block);
+            //
+            // events are created by producers and destroyed by the loop,
+            // the surplus of the consuming thread flows back in batches
+            if (free.count >= 2 * EventPool::BatchSize)
+                event_pool().release(index, free, EventPool::BatchSize);
+        }
+
+    private:
+        EventPool::FreeLists _free;
+    };
+
+    ThreadCache* thread_cache()
+    {
+        if (thread_cache_destroyed)
+            return nullptr;
+        thread_local ThreadCache cache;
+        return &cache;
+    }
+
+}
+
+void* Event::operator new(std::size_t size)
+{
+    auto index = EventPool::size_class(size);
+    if (index == EventPool::ClassCount)
+        return ::operator new(size);
+    if (auto cache = thread_cache())
+        return cache->allocate(index);
+    return ::operator new(EventPool::MinimumSize << index);
+}
+
+void Event::operator delete(void* pointer, std::size_t size)
+{
+    auto index = EventPool::size_class(size);
+    if (index == EventPool::ClassCount) {
+        ::operator delete(pointer);
+    } else if (auto cache = thread_cache()) {
+        cache->deallocate(pointer, index);
+    } else {
+        EventPool::FreeList list;
+        list.push(new (pointer) EventPool::Block);
+        event_pool().release(index, list, 1);
+    }
+}
+
+void EventLoop::run_forever()
+{
+    if (_closed)
+        throw std::runtime_error("loop was closed already");
+    _stopped = false;
+
+    std::vector<Event*> expired;
+    EventLoop::Work work;
+    while (!_stopped) {
+        //
+        // reset before receiving, producers posting from now on wake us up
+        _signalled = false;
+        receive();
+        _timers.expire(Clock::now(), expired);
+        if (expired.empty()) {
+            //
+            // sleep until the next timer is due. without any timer the loop
+            // only wakes up for input, posted events or redraw requests
+            wait(_timers.next_expiry());
+        } else {
+            std::sort(expired.begin(), expired.end(), [](Event const* a, Event const* b) {
+                return a->_time != b->_time ? a->_time < b->_time : a->_sequence < b->_sequence;
+            });
+            for (auto event : expired)
+                work.emplace_back(event);
+            expired.clear();
+            //
+            // (for python we need to acquire the gil)
+            run_in_external_scope([&] {
+                P3_PROFILE_ZONE("event_loop.dispatch");
+                for (auto& item : work) {
+                    P3_PROFILE_ZONE("event");
+                    auto const begin = Clock::now();
+                    try {
+                        (*item)();
+                    } catch (std::exception& e) {
+                        log_error("error: {}", e.what());
+                        throw;
+                    }
+                    if (item->_self_timed)
+                        continue;
+                    auto const node = item->_node.lock();
+                    _callback_statistics.record(node.get(), item->_signal, Clock::now() - begin);
+                }
+                work.clear();
+            });
+            glfwPollEvents();
+        }
+        //
+        // render..
+        for (auto observer : _observer)
+            observer->on_work_processed(*this);
+    }
+}
+
+void EventLoop::call_at(TimePoint time_point, std::unique_ptr<Event> event)
+{
+    if (_closed)
+        throw std::runtime_error("cannot schedule task on a closed loop");
+    auto raw = event.release();
+    raw->_time = time_point;
+    raw->_sequence = _sequence.fetch_add(1, std::memory_order_relaxed);
+    auto head = _inbox.load(std::memory_order_relaxed);
+    do {
+        raw->_next = head;
+    } while (!_inbox.compare_exchange_weak(head, raw, std::memory_order_release, std::memory_order_relaxed));
+    if (!_signalled.exchange(true))
+        wake_up();
+}
+
+void EventLoop::wait(std::optional<TimePoint> until)
+{
+    if (!_headless) {
+        if (!until) {
+            glfwWaitEvents();
+        } else {
+            auto seconds = std::chrono::duration<double>(until.value() - Clock::now()).count();
+            if (seconds > 0.)
+                glfwWaitEventsTimeout(seconds);
+            else
+                glfwPollEvents();
+        }
+        return;
+    }
+    std::unique_lock<std::mutex> lock(_wake_up_mutex);
+    if (until)
+        _wake_up_condition.wait_until(lock, until.value(), [&] { return _woken_up; });
+    else
+        _wake_up_condition.wait(lock, [&] { return _woken_up; });
+    _woken_up = false;
+}
+
+void EventLoop::wake_up()
+{
+    if (!_headless) {
+        glfwPostEmptyEvent();
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock(_wake_up_mutex);
+        _woken_up = true;
+    }
+    _wake_up_condition.notify_one();
+}
+
+void EventLoop::receive()
+{
+    auto event = _inbox.exchange(nullptr, std::memory_order_acquire);
+    while (event) {
+        auto next = event->_next;
+        _timers.insert(event->_time, event);
+        event = next;
+    }
+}
+
+EventLoop::Queue EventLoop::queue()
+{
+    receive();
+    Queue queue;
+    queue.reserve(_timers.size());
+    _timers.for_each([&](Event const& event) {
+        queue.emplace_back(event._time, &event);
+    });
+    std::sort(queue.begin(), queue.end(), [](auto const& a, auto const& b) {
+        return a.first != b.first ? a.first < b.first : a.second->_sequence < b.second->_sequence;
+    });
+    return queue;
+}
+
+void EventLoop::close()
+{
+    log_debug("closing event loop");
+    if (!_stopped)
+        log_fatal("cannot close a running loop");
+    _closed = true;
+    receive();
+    std::vector<Event*> events;
+    _timers.clear(events);
+    if (!events.empty()) {
+        run_in_external_scope([&] {
+            for (auto event : events)
+                delete event;
+        });
+    }
+}
+
+void EventLoop::stop()
+{
+    _stopped = true;
+    //
+    // make sure thread will process the change of the flag
+    wake_up();
+}
+
+}
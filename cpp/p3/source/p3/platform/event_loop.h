@@ -1,87 +1,188 @@
-#pragma once
-
-#include <functional>
-#include <vector>
-
-#include <algorithm>
-#include <chrono>
-#include <condition_variable>
-#include <memory>
-#include <mutex>
-#include <queue>
-
-namespace p3 {
-
-extern std::function<void(std::function<void()>)> run_in_external_scope;
-
-class Event {
-public:
-    virtual ~Event() { }
-    virtual void operator()() = 0;
-    static std::unique_ptr<Event> create(std::function<void()>);
-};
-
-/*
- * each window requires an event loop. this loop can be shared
- * by multiple windows.
- */
-class EventLoop : public std::enable_shared_from_this<EventLoop> {
-public:
-    using Clock = std::chrono::high_resolution_clock;
-    using Duration = Clock::duration;
-    using TimePoint = Clock::time_point;
-    using ScheduledEvent = std::pair<TimePoint, std::unique_ptr<Event>>;
-    using Queue = std::vector<ScheduledEvent>;
-    using Work = std::vector<std::unique_ptr<Event>>;
-
-    class Observer;
-    void add_observer(Observer* observer) { _observer.push_back(observer); }
-    void remove_observer(Observer* observer)
-    {
-        _observer.erase(std::remove_if(_observer.begin(),
-                            _observer.end(), [&](auto item) {
-                                return item == observer;
-                            }),
-            _observer.end());
-    }
-
-    EventLoop();
-    ~EventLoop();
-
-    void call_at(TimePoint, std::unique_ptr<Event>);
-
-    ///
-    /// If stop() is called while run_forever() is running, the loop will 
-    /// run the current batch of callbacks and then exit.void stop();
-    void stop();
-
-    ///
-    // the loop must not be running when this function is called.
-    /// Any pending callbacks will be discarded.
-    void close();
-
-    /// 
-    /// run until stopped / closed
-    void run_forever();
-
-    Queue const& queue() const { return _queue; }
-
-    static std::shared_ptr<EventLoop> current();
-
-private:
-    std::mutex _mutex;
-    Queue _queue;
-
-    bool _stopped = true;
-    bool _closed = false;
-
-    std::vector<Observer*> _observer;
-};
-
-class EventLoop::Observer {
-public:
-    virtual ~Observer() = default;
-    virtual void on_work_processed(EventLoop&) = 0;
-};
-
-}
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <type_traits>
+#include <vector>
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <queue>
+
+#include "CallbackStatistics.h"
+#include "timer_wheel.h"
+
+namespace p3 {
+
+class Node;
+
+extern std::function<void(std::function<void()>)> run_in_external_scope;
+
+class Event {
+public:
+    virtual ~Event() { }
+    virtual void operator()() = 0;
+
+    //
+    // events are allocated from size class pools and recycled through
+    // per thread free lists. the callable is stored inline, hence posting
+    // a small callback does not touch the heap once the pools are warmed up
+    static void* operator new(std::size_t);
+    static void operator delete(void*, std::size_t);
+
+    template <typename F>
+    static std::unique_ptr<Event> create(F&&);
+
+    ///
+    /// the node and signal which caused this event, the execution
+    /// time is attributed to them. the signal must be a literal
+    void set_origin(std::weak_ptr<Node> node, char const* signal)
+    {
+        _node = std::move(node);
+        _signal = signal;
+    }
+
+    ///
+    /// the event records the execution times of the handlers it calls
+    /// itself, e.g. a batch of mouse events. the loop does not record it
+    void set_self_timed() { _self_timed = true; }
+
+private:
+    friend class EventLoop;
+    friend class TimerWheel;
+
+    std::weak_ptr<Node> _node;
+    char const* _signal = nullptr;
+    bool _self_timed = false;
+
+    //
+    // intrusive links for the inbox and the timer wheel of the loop
+    Event* _next = nullptr;
+    std::chrono::high_resolution_clock::time_point _time;
+    std::uint64_t _sequence = 0;
+};
+
+template <typename F>
+class CallableEvent final : public Event {
+public:
+    explicit CallableEvent(F f)
+        : _f(std::move(f))
+    {
+    }
+
+    void operator()() override { _f(); }
+
+private:
+    F _f;
+};
+
+template <typename F>
+std::unique_ptr<Event> Event::create(F&& f)
+{
+    return std::make_unique<CallableEvent<std::decay_t<F>>>(std::forward<F>(f));
+}
+
+/*
+ * each window requires an event loop. this loop can be shared
+ * by multiple windows.
+ */
+class EventLoop : public std::enable_shared_from_this<EventLoop> {
+public:
+    using Clock = std::chrono::high_resolution_clock;
+    using Duration = Clock::duration;
+    using TimePoint = Clock::time_point;
+    using Queue = std::vector<std::pair<TimePoint, Event const*>>;
+    using Work = std::vector<std::unique_ptr<Event>>;
+
+    class Observer;
+    void add_observer(Observer* observer) { _observer.push_back(observer); }
+    void remove_observer(Observer* observer)
+    {
+        _observer.erase(std::remove_if(_observer.begin(),
+                            _observer.end(), [&](auto item) {
+                                return item == observer;
+                            }),
+            _observer.end());
+    }
+
+    EventLoop();
+    ~EventLoop();
+
+    ///
+    /// thread safe and lock free. events are pushed to an inbox, the loop
+    /// moves them into its timer wheel. a wakeup is posted only if the
+    /// loop was not signalled already since it last checked the inbox.
+    void call_at(TimePoint, std::unique_ptr<Event>);
+
+    ///
+    /// If stop() is called while run_forever() is running, the loop will 
+    /// run the current batch of callbacks and then exit.void stop();
+    void stop();
+
+    ///
+    // the loop must not be running when this function is called.
+    /// Any pending callbacks will be discarded.
+    void close();
+
+    /// 
+    /// run until stopped / closed
+    void run_forever();
+
+    ///
+    /// the scheduled events, ordered by time. must be called by the
+    /// thread running the loop, since it receives the inbox
+    Queue queue();
+
+    static std::shared_ptr<EventLoop> current();
+
+    ///
+    /// thread safe. wakes up the loop if it waits for events
+    void wake_up();
+
+    ///
+    /// true if glfw runs on its null platform, which is chosen on linux if
+    /// there is no display. only offscreen windows can be created then
+    bool headless() const { return _headless; }
+
+    /// execution times of the dispatched events
+    CallbackStatistics& callback_statistics() { return _callback_statistics; }
+
+private:
+    void receive();
+    void wait(std::optional<TimePoint>);
+
+    //
+    // intrusive stack of incoming events (multiple producers, one consumer)
+    std::atomic<Event*> _inbox { nullptr };
+    std::atomic<bool> _signalled { false };
+    std::atomic<std::uint64_t> _sequence { 0 };
+    TimerWheel _timers;
+
+    std::atomic<bool> _stopped { true };
+    std::atomic<bool> _closed { false };
+
+    std::vector<Observer*> _observer;
+    CallbackStatistics _callback_statistics;
+
+    //
+    // waiting for events returns immediately on the null platform of
+    // glfw, the loop sleeps on a condition variable instead
+    bool _headless = false;
+    std::mutex _wake_up_mutex;
+    std::condition_variable _wake_up_condition;
+    bool _woken_up = false;
+};
+
+class EventLoop::Observer {
+public:
+    virtual ~Observer() = default;
+    virtual void on_work_processed(EventLoop&) = 0;
+};
+
+}
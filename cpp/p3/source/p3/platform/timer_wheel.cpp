@@ -0,0 +1,186 @@
+#include "timer_wheel.h"
+#include "event_loop.h"
+
+#include <algorithm>
+#include <limits>
+#include <utility>
+
+namespace p3 {
+
+namespace {
+
+    auto const resolution = std::chrono::duration_cast<TimerWheel::Clock::duration>(TimerWheel::Resolution).count();
+
+    constexpr TimerWheel::Tick level_span(std::size_t level)
+    {
+        return TimerWheel::Tick(1) << (TimerWheel::SlotBits * level);
+    }
+
+}
+
+TimerWheel::TimerWheel(TimePoint origin)
+    : _origin(origin)
+{
+}
+
+TimerWheel::~TimerWheel()
+{
+    std::vector<Event*> events;
+    clear(events);
+    for (auto event : events)
+        delete event;
+}
+
+Event* TimerWheel::next(Event const* event)
+{
+    return event->_next;
+}
+
+void TimerWheel::push(Event*& list, Event* event)
+{
+    event->_next = list;
+    list = event;
+}
+
+TimerWheel::Tick TimerWheel::ceil_tick(TimePoint time_point) const
+{
+    if (time_point <= _origin)
+        return 0;
+    auto const count = (time_point - _origin).count();
+    return Tick((count + resolution - 1) / resolution);
+}
+
+TimerWheel::Tick TimerWheel::floor_tick(TimePoint time_point) const
+{
+    if (time_point <= _origin)
+        return 0;
+    return Tick((time_point - _origin).count() / resolution);
+}
+
+TimerWheel::TimePoint TimerWheel::time_of(Tick tick) const
+{
+    return _origin + Clock::duration(Clock::duration::rep(tick) * resolution);
+}
+
+void TimerWheel::insert(TimePoint time_point, Event* event)
+{
+    event->_time = time_point;
+    ++_size;
+    place(event);
+}
+
+void TimerWheel::place(Event* event)
+{
+    auto const tick = ceil_tick(event->_time);
+    if (tick <= _current) {
+        push(_expired, event);
+        return;
+    }
+    auto const delta = tick - _current;
+    for (std::size_t level = 0; level < Levels; ++level) {
+        if (delta < level_span(level + 1)) {
+            auto const index = (tick >> (SlotBits * level)) & (Slots - 1);
+            push(_slots[level][index], event);
+            ++_pending;
+            return;
+        }
+    }
+    push(_overflow, event);
+    ++_pending;
+}
+
+void TimerWheel::cascade(Event*& list)
+{
+    auto event = std::exchange(list, nullptr);
+    while (event) {
+        auto next = event->_next;
+        --_pending;
+        place(event);
+        event = next;
+    }
+}
+
+void TimerWheel::expire(TimePoint now, std::vector<Event*>& expired)
+{
+    auto const target = floor_tick(now);
+    while (_current < target) {
+        //
+        // nothing in the wheel, skip the idle ticks
+        if (_pending == 0) {
+            _current = target;
+            break;
+        }
+        ++_current;
+        for (std::size_t level = 1; level < Levels; ++level) {
+            if (_current & (level_span(level) - 1))
+                break;
+            cascade(_slots[level][(_current >> (SlotBits * level)) & (Slots - 1)]);
+        }
+        if ((_current & (level_span(Levels) - 1)) == 0)
+            cascade(_overflow);
+        auto& slot = _slots[0][_current & (Slots - 1)];
+        while (slot) {
+            auto event = slot;
+            slot = event->_next;
+            --_pending;
+            push(_expired, event);
+        }
+    }
+    for (auto event = std::exchange(_expired, nullptr); event;) {
+        auto next = event->_next;
+        event->_next = nullptr;
+        expired.push_back(event);
+        --_size;
+        event = next;
+    }
+}
+
+std::optional<TimerWheel::TimePoint> TimerWheel::next_expiry() const
+{
+    if (_expired)
+        return time_of(_current);
+    if (_pending == 0)
+        return std::nullopt;
+    auto best = std::numeric_limits<Tick>::max();
+    for (std::size_t i = 1; i <= Slots; ++i) {
+        auto const tick = _current + i;
+        if (_slots[0][tick & (Slots - 1)]) {
+            best = tick;
+            break;
+        }
+    }
+    //
+    // for higher levels the wheel wakes up when the slot cascades
+    for (std::size_t level = 1; level < Levels; ++level) {
+        auto const base = _current >> (SlotBits * level);
+        for (std::size_t i = 1; i <= Slots; ++i) {
+            if (_slots[level][(base + i) & (Slots - 1)]) {
+                best = std::min(best, (base + i) << (SlotBits * level));
+                break;
+            }
+        }
+    }
+    if (_overflow)
+        best = std::min(best, ((_current >> (SlotBits * Levels)) + 1) << (SlotBits * Levels));
+    return time_of(best);
+}
+
+void TimerWheel::clear(std::vector<Event*>& events)
+{
+    auto collect = [&](Event*& list) {
+        for (auto event = std::exchange(list, nullptr); event;) {
+            auto next = event->_next;
+            event->_next = nullptr;
+            events.push_back(event);
+            event = next;
+        }
+    };
+    collect(_expired);
+    for (auto& level : _slots)
+        for (auto& slot : level)
+            collect(slot);
+    collect(_overflow);
+    _size = _pending = 0;
+}
+
+}
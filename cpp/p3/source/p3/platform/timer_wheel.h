@@ -0,0 +1,87 @@
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+namespace p3 {
+
+class Event;
+
+/*
+ * hierarchical timer wheel with ticks of one millisecond. four levels of
+ * 64 slots cover about 4.6 hours, later events wait in an overflow list.
+ * inserting and expiring are O(1), events cascade down to lower levels
+ * as time advances. the wheel owns the events, links them intrusively
+ * and is not thread safe: it belongs to the thread running the loop.
+ */
+class TimerWheel {
+public:
+    using Clock = std::chrono::high_resolution_clock;
+    using TimePoint = Clock::time_point;
+    using Tick = std::uint64_t;
+
+    static constexpr std::chrono::milliseconds Resolution { 1 };
+    static constexpr std::size_t Levels = 4;
+    static constexpr std::size_t SlotBits = 6;
+    static constexpr std::size_t Slots = std::size_t(1) << SlotBits;
+
+    explicit TimerWheel(TimePoint origin = Clock::now());
+    ~TimerWheel();
+
+    TimerWheel(TimerWheel const&) = delete;
+    TimerWheel& operator=(TimerWheel const&) = delete;
+
+    /// takes ownership of the event, due at the given time
+    void insert(TimePoint, Event*);
+
+    /// advance to now and append all events due to expired
+    void expire(TimePoint now, std::vector<Event*>& expired);
+
+    /// the earliest time at which expire may yield events
+    std::optional<TimePoint> next_expiry() const;
+
+    /// remove all events, ownership goes to the caller
+    void clear(std::vector<Event*>& events);
+
+    std::size_t size() const { return _size; }
+
+    template <typename F>
+    void for_each(F&& f) const
+    {
+        for (auto event = _expired; event; event = next(event))
+            f(*event);
+        for (auto const& level : _slots)
+            for (auto slot : level)
+                for (auto event = slot; event; event = next(event))
+                    f(*event);
+        for (auto event = _overflow; event; event = next(event))
+            f(*event);
+    }
+
+private:
+    static Event* next(Event const*);
+    static void push(Event*& list, Event*);
+
+    Tick ceil_tick(TimePoint) const;
+    Tick floor_tick(TimePoint) const;
+    TimePoint time_of(Tick) const;
+
+    void place(Event*);
+    void cascade(Event*& list);
+
+    TimePoint _origin;
+    Tick _current = 0;
+    /// all events, including the expired ones
+    std::size_t _size = 0;
+    /// events in slots and overflow
+    std::size_t _pending = 0;
+    std::array<std::array<Event*, Slots>, Levels> _slots {};
+    Event* _overflow = nullptr;
+    Event* _expired = nullptr;
+};
+
+}
@@ -23,7 +23,7 @@ void Button::render_impl(Context& context, float width, float height)
     if (ImGui::Button(imgui_label().c_str(), size)
         && _on_click
         && !disabled()) {
-        postpone([f = _on_click]() { f(); });
+        postpone("on_click", [f = _on_click]() { f(); });
     }
     if (_background_color)
         ImGui::PopStyleColor();
@@ -27,7 +27,7 @@ void Collapsible::render_impl(Context& context, float width, float height)
     auto collapsed = !ImGui::CollapsingHeader(imgui_label().c_str());
     if (collapsed != _collapsed) {
         if (_content) {
-            postpone([content = _content, collapsed]() {
+            postpone("collapse", [content = _content, collapsed]() {
                 content->set_visible(!collapsed);
             });
         }
@@ -27,7 +27,7 @@ void ColorEdit::render_impl(Context&, float width, float height)
             std::uint8_t(_value[2] * 255.f),
             std::uint8_t(_value[3] * 255.f));
         if (_on_change) {
-            postpone([color = _color, f = _on_change]() {
+            postpone("on_change", [color = _color, f = _on_change]() {
                 f(std::move(color));
             });
         }
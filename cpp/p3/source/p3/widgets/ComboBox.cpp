@@ -26,7 +26,7 @@ void ComboBox::render_impl(Context&, float width, float height)
             ImGui::PushID((void*)&_options[i]);
             if (ImGui::Selectable(_options[i].c_str(), i == _selected_index)) {
                 if (_on_change)
-                    postpone([f = _on_change, index = int(i)]() { f(index); });
+                    postpone("on_change", [f = _on_change, index = int(i)]() { f(index); });
                 _selected_index = int(i);
             }
             ImGui::PopID();
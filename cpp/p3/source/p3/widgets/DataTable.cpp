@@ -0,0 +1,464 @@
+#include "DataTable.h"
+#include "DataTableIndex.h"
+#include <p3/Context.h>
+#include <p3/constant.h>
+#include <p3/log.h>
+#include <p3/platform/event_loop.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <type_traits>
+
+#include <fmt/format.h>
+#include <imgui.h>
+#include <imgui_internal.h>
+
+namespace p3 {
+
+namespace {
+
+    //
+    // cells are formatted into a fixed buffer, longer values are truncated
+    constexpr std::size_t CellCapacity = 256;
+
+    template <typename T>
+    std::size_t format_to(char* buffer, std::size_t capacity, std::string_view spec, T const& value)
+    {
+        try {
+            auto result = fmt::format_to_n(buffer, capacity, spec, value);
+            return std::min(std::size_t(result.size), capacity);
+        } catch (fmt::format_error const&) {
+            static constexpr char error[] = "#format";
+            auto size = std::min(sizeof(error) - 1, capacity);
+            std::memcpy(buffer, error, size);
+            return size;
+        }
+    }
+
+    template <typename T>
+    int three_way(T const& a, T const& b)
+    {
+        //
+        // nan is greater than any number, keeps the ordering strict weak
+        if constexpr (std::is_floating_point_v<T>) {
+            if (std::isnan(a) || std::isnan(b))
+                return int(std::isnan(a)) - int(std::isnan(b));
+        }
+        return a < b ? -1 : (b < a ? 1 : 0);
+    }
+
+    //
+    // the owner (e.g. python) may change the memory of a source in place,
+    // the index is built from copies taken on the owning thread
+    std::shared_ptr<DataTable::Source const> snapshot(std::shared_ptr<DataTable::Source> const& source)
+    {
+        if (!source)
+            return nullptr;
+        auto copy = source->snapshot();
+        return copy ? copy : source;
+    }
+
+}
+
+bool DataTable::Source::contains(std::size_t row, std::string_view text) const
+{
+    char buffer[CellCapacity];
+    auto size = format(row, "{}", buffer, CellCapacity);
+    return std::string_view(buffer, size).find(text) != std::string_view::npos;
+}
+
+template <typename T>
+T DataTable::Span<T>::value(std::size_t row) const
+{
+    T result;
+    std::memcpy(&result, _data + row * _stride, sizeof(T));
+    return result;
+}
+
+template <typename T>
+std::size_t DataTable::Span<T>::format(std::size_t row, std::string_view spec, char* buffer, std::size_t capacity) const
+{
+    return format_to(buffer, capacity, spec, value(row));
+}
+
+template <typename T>
+int DataTable::Span<T>::compare(std::size_t a, std::size_t b) const
+{
+    return three_way(value(a), value(b));
+}
+
+template <typename T>
+std::shared_ptr<DataTable::Source const> DataTable::Span<T>::snapshot() const
+{
+    auto values = std::make_shared<std::vector<T>>(_size);
+    for (std::size_t row = 0; row < _size; ++row)
+        (*values)[row] = value(row);
+    return std::make_shared<Span<T>>(values->data(), _size, sizeof(T), values);
+}
+
+template class DataTable::Span<std::int8_t>;
+template class DataTable::Span<std::uint8_t>;
+template class DataTable::Span<std::int16_t>;
+template class DataTable::Span<std::uint16_t>;
+template class DataTable::Span<std::int32_t>;
+template class DataTable::Span<std::uint32_t>;
+template class DataTable::Span<std::int64_t>;
+template class DataTable::Span<std::uint64_t>;
+template class DataTable::Span<float>;
+template class DataTable::Span<double>;
+
+DataTable::Strings::Strings(std::vector<std::string_view> values, std::shared_ptr<void> guard)
+    : Source(std::move(guard))
+    , _values(std::move(values))
+{
+}
+
+DataTable::Strings::Strings(std::vector<std::string> values)
+    : Strings(std::make_shared<std::vector<std::string>>(std::move(values)))
+{
+}
+
+DataTable::Strings::Strings(std::shared_ptr<std::vector<std::string>> owner)
+    : Source(owner)
+    , _values(owner->begin(), owner->end())
+{
+}
+
+std::size_t DataTable::Strings::format(std::size_t row, std::string_view spec, char* buffer, std::size_t capacity) const
+{
+    return format_to(buffer, capacity, spec, _values[row]);
+}
+
+int DataTable::Strings::compare(std::size_t a, std::size_t b) const
+{
+    return _values[a].compare(_values[b]);
+}
+
+bool DataTable::Strings::contains(std::size_t row, std::string_view text) const
+{
+    return _values[row].find(text) != std::string_view::npos;
+}
+
+DataTable::FixedStrings::FixedStrings(char const* data, std::size_t size, std::size_t width, std::size_t stride, std::shared_ptr<void> guard)
+    : Source(std::move(guard))
+    , _data(data)
+    , _size(size)
+    , _width(width)
+    , _stride(stride)
+{
+}
+
+std::string_view DataTable::FixedStrings::value(std::size_t row) const
+{
+    auto begin = _data + row * _stride;
+    auto end = std::find(begin, begin + _width, '\0');
+    return std::string_view(begin, std::size_t(end - begin));
+}
+
+std::shared_ptr<DataTable::Source const> DataTable::FixedStrings::snapshot() const
+{
+    auto values = std::make_shared<std::vector<char>>(_size * _width);
+    for (std::size_t row = 0; row < _size; ++row)
+        std::memcpy(values->data() + row * _width, _data + row * _stride, _width);
+    return std::make_shared<FixedStrings>(values->data(), _size, _width, _width, values);
+}
+
+std::size_t DataTable::FixedStrings::format(std::size_t row, std::string_view spec, char* buffer, std::size_t capacity) const
+{
+    return format_to(buffer, capacity, spec, value(row));
+}
+
+int DataTable::FixedStrings::compare(std::size_t a, std::size_t b) const
+{
+    return value(a).compare(value(b));
+}
+
+bool DataTable::FixedStrings::contains(std::size_t row, std::string_view text) const
+{
+    return value(row).find(text) != std::string_view::npos;
+}
+
+DataTable::DataTable()
+    : Node("DataTable")
+    , _index_builder(std::make_unique<DataTableIndex>())
+{
+}
+
+DataTable::~DataTable() = default;
+
+void DataTable::Column::set_source(std::shared_ptr<Source> source)
+{
+    _source = std::move(source);
+    if (auto table = _table.lock()) {
+        table->update_index();
+        table->set_needs_update();
+    }
+}
+
+void DataTable::set_columns(std::vector<std::shared_ptr<Column>> columns)
+{
+    if (std::find(columns.begin(), columns.end(), nullptr) != columns.end())
+        throw std::invalid_argument("columns must not be null");
+    for (auto& column : _columns)
+        if (column->_table.lock().get() == this)
+            column->_table.reset();
+    _columns = std::move(columns);
+    //
+    // empty if the table is not owned by a shared pointer
+    auto self = std::static_pointer_cast<DataTable>(weak_from_this().lock());
+    for (auto& column : _columns)
+        column->_table = self;
+    update_index();
+    set_needs_update();
+}
+
+std::vector<std::shared_ptr<DataTable::Column>> DataTable::columns() const
+{
+    return _columns;
+}
+
+std::size_t DataTable::row_count() const
+{
+    std::size_t count = 0;
+    for (auto const& column : _columns)
+        if (column->source())
+            count = std::max(count, column->source()->size());
+    return count;
+}
+
+int DataTable::freezed_columns() const
+{
+    return _freezed_columns;
+}
+
+void DataTable::set_freezed_columns(int freezed_columns)
+{
+    _freezed_columns = freezed_columns;
+}
+
+int DataTable::freezed_rows() const
+{
+    return _freezed_rows;
+}
+
+void DataTable::set_freezed_rows(int freezed_rows)
+{
+    _freezed_rows = freezed_rows;
+}
+
+bool DataTable::resizeable() const
+{
+    return _resizeable;
+}
+
+void DataTable::set_resizeable(bool resizeable)
+{
+    _resizeable = resizeable;
+}
+
+bool DataTable::reorderable() const
+{
+    return _reorderable;
+}
+
+void DataTable::set_reorderable(bool reorderable)
+{
+    _reorderable = reorderable;
+}
+
+bool DataTable::sortable() const
+{
+    return _sortable;
+}
+
+void DataTable::set_sortable(bool sortable)
+{
+    _sortable = sortable;
+}
+
+std::vector<DataTable::SortSpec> const& DataTable::sort_specs() const
+{
+    return _sort_specs;
+}
+
+void DataTable::set_sort_specs(std::vector<SortSpec> sort_specs)
+{
+    _sort_specs = std::move(sort_specs);
+    update_index();
+}
+
+std::string const& DataTable::filter() const
+{
+    return _filter;
+}
+
+void DataTable::set_filter(std::string filter)
+{
+    if (filter == _filter)
+        return;
+    _filter = std::move(filter);
+    update_index();
+}
+
+std::shared_ptr<DataTable::Index const> const& DataTable::index() const
+{
+    return _index;
+}
+
+bool DataTable::indexing() const
+{
+    return _index_builder->busy();
+}
+
+DataTable::OnIndexChange DataTable::on_index_change() const
+{
+    return _on_index_change;
+}
+
+void DataTable::set_on_index_change(OnIndexChange on_index_change)
+{
+    _on_index_change = std::move(on_index_change);
+}
+
+void DataTable::update_index()
+{
+    auto const request_id = ++_index_request;
+    if (_sort_specs.empty() && _filter.empty()) {
+        _index_builder->cancel();
+        set_index(nullptr);
+        return;
+    }
+
+    DataTableIndex::Request request;
+    request.row_count = row_count();
+    for (auto const& spec : _sort_specs)
+        if (spec.column < _columns.size())
+            request.keys.push_back({ snapshot(_columns[spec.column]->source()), spec.descending });
+    request.filter = _filter;
+    if (!_filter.empty())
+        for (auto const& column : _columns)
+            request.filter_sources.push_back(snapshot(column->source()));
+
+    //
+    // without a loop there is no frame boundary to wait for
+    auto loop = EventLoop::current();
+    if (!loop) {
+        auto index = DataTableIndex::build(request);
+        set_index(std::make_shared<Index const>(std::move(index.value())));
+        return;
+    }
+    //
+    // the finished index is handed over to the loop, which applies it
+    // between two frames. results of outdated requests are dropped
+    _index_builder->rebuild(std::move(request),
+        [weak_loop = std::weak_ptr<EventLoop>(loop), weak_self = weak_from_this(), request_id](std::shared_ptr<Index const> index) {
+            auto loop = weak_loop.lock();
+            if (!loop)
+                return;
+            try {
+                loop->call_at(EventLoop::Clock::now(), Event::create([weak_self, index, request_id]() {
+                    auto self = std::static_pointer_cast<DataTable>(weak_self.lock());
+                    if (self && self->_index_request == request_id)
+                        self->set_index(std::move(index));
+                }));
+            } catch (std::exception const& e) {
+                log_warn("could not hand over table index: {}", e.what());
+            }
+        });
+}
+
+void DataTable::set_index(std::shared_ptr<Index const> index)
+{
+    if (!index && !_index)
+        return;
+    _index = std::move(index);
+    redraw();
+    //
+    // may be called while rendering, hence the callback is postponed
+    if (_on_index_change) {
+        if (EventLoop::current())
+            postpone("on_index_change", _on_index_change);
+        else
+            _on_index_change();
+    }
+}
+
+void DataTable::render_impl(Context& context, float width, float height)
+{
+    if (_columns.empty())
+        return;
+
+    ImGuiTableFlags flags = ImGuiTableFlags_RowBg
+        | ImGuiTableFlags_BordersOuterH
+        | ImGuiTableFlags_BordersOuterV
+        | ImGuiTableFlags_BordersInnerV
+        | ImGuiTableFlags_ScrollX
+        | ImGuiTableFlags_ScrollY;
+
+    if (_resizeable)
+        flags |= ImGuiTableFlags_Resizable;
+    if (_reorderable)
+        flags |= ImGuiTableFlags_Reorderable;
+    if (_sortable)
+        flags |= ImGuiTableFlags_Sortable | ImGuiTableFlags_SortMulti | ImGuiTableFlags_SortTristate;
+
+    if (!ImGui::BeginTable(imgui_label().c_str(), int(_columns.size()), flags, ImVec2(width, height)))
+        return;
+
+    ImGui::TableSetupScrollFreeze(_freezed_columns, _freezed_rows);
+    for (auto& column : _columns) {
+        ImGuiTableColumnFlags flags = ImGuiTableColumnFlags_None;
+        float width = 0.f;
+        if (column->width()) {
+            flags |= ImGuiTableColumnFlags_WidthFixed;
+            width = context.to_actual(column->width().value());
+        }
+        ImGui::TableSetupColumn(column->title().c_str(), flags, width);
+    }
+    ImGui::TableHeadersRow();
+
+    if (_sortable) {
+        auto specs = ImGui::TableGetSortSpecs();
+        if (specs && specs->SpecsDirty) {
+            std::vector<SortSpec> sort_specs;
+            for (int i = 0; i < specs->SpecsCount; ++i)
+                sort_specs.push_back({ std::size_t(specs->Specs[i].ColumnIndex),
+                    specs->Specs[i].SortDirection == ImGuiSortDirection_Descending });
+            specs->SpecsDirty = false;
+            set_sort_specs(std::move(sort_specs));
+        }
+    }
+
+    //
+    // rows outside of the clip rect are skipped by the clipper,
+    // hence the cost per frame scales with the visible cells only
+    char buffer[CellCapacity];
+    ImGuiListClipper clipper;
+    clipper.Begin(int(_index ? _index->size() : row_count()));
+    while (clipper.Step()) {
+        for (int item = clipper.DisplayStart; item < clipper.DisplayEnd; ++item) {
+            auto const row = _index ? std::size_t((*_index)[item]) : std::size_t(item);
+            ImGui::TableNextRow();
+            for (int index = 0; index < int(_columns.size()); ++index) {
+                auto const& source = _columns[index]->source();
+                if (!source || row >= source->size())
+                    continue;
+                ImGui::TableSetColumnIndex(index);
+                auto size = source->format(row, _columns[index]->format(), buffer, CellCapacity);
+                ImGui::TextUnformatted(buffer, buffer + size);
+            }
+        }
+    }
+    ImGui::EndTable();
+}
+
+void DataTable::update_content()
+{
+    auto const em = ImGui::GetCurrentContext()->FontSize;
+    _automatic_width = _automatic_height = DefaultItemWidthEm * em;
+}
+
+}
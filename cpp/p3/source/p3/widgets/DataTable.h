@@ -0,0 +1,225 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <p3/Node.h>
+
+namespace p3 {
+
+class DataTableIndex;
+
+//
+// table for large, columnar data. in contrast to Table, cells are not
+// nodes. each column refers to a source which formats a value on demand,
+// only the cells intersecting the clip rect are formatted and drawn.
+class DataTable : public Node {
+public:
+    DataTable();
+    ~DataTable();
+
+    //
+    // read only view on the values of a column. sources do not copy the
+    // data, the guard keeps the owner of the memory (e.g. a numpy array) alive.
+    class Source {
+    public:
+        explicit Source(std::shared_ptr<void> guard = nullptr)
+            : _guard(std::move(guard))
+        {
+        }
+        virtual ~Source() = default;
+
+        virtual std::size_t size() const = 0;
+
+        /// formats the value of the row into the buffer, returns the number of chars written
+        virtual std::size_t format(std::size_t row, std::string_view spec, char* buffer, std::size_t capacity) const = 0;
+
+        /// three way comparison of two rows, used for sorting
+        virtual int compare(std::size_t a, std::size_t b) const = 0;
+
+        /// substring test on the default representation, used for filtering
+        virtual bool contains(std::size_t row, std::string_view text) const;
+
+        ///
+        /// a copy owning its values if the memory may be changed by its owner
+        /// (e.g. a numpy array), otherwise null. sorting works on a copy,
+        /// comparisons must not change while sorting
+        virtual std::shared_ptr<Source const> snapshot() const { return nullptr; }
+
+        std::shared_ptr<void> const& guard() const { return _guard; }
+
+    private:
+        std::shared_ptr<void> _guard;
+    };
+
+    //
+    // strided view on numbers, stride is given in bytes
+    template <typename T>
+    class Span : public Source {
+    public:
+        Span(T const* data, std::size_t size, std::size_t stride = sizeof(T), std::shared_ptr<void> guard = nullptr)
+            : Source(std::move(guard))
+            , _data(reinterpret_cast<char const*>(data))
+            , _size(size)
+            , _stride(stride)
+        {
+        }
+
+        std::size_t size() const override { return _size; }
+        std::size_t format(std::size_t row, std::string_view spec, char* buffer, std::size_t capacity) const override;
+        int compare(std::size_t a, std::size_t b) const override;
+        std::shared_ptr<Source const> snapshot() const override;
+
+    private:
+        T value(std::size_t row) const;
+
+        char const* _data;
+        std::size_t _size;
+        std::size_t _stride;
+    };
+
+    //
+    // view on strings. the vector of views is built once,
+    // the characters are owned by the guard
+    class Strings : public Source {
+    public:
+        Strings(std::vector<std::string_view> values, std::shared_ptr<void> guard);
+        explicit Strings(std::vector<std::string> values);
+
+        std::size_t size() const override { return _values.size(); }
+        std::size_t format(std::size_t row, std::string_view spec, char* buffer, std::size_t capacity) const override;
+        int compare(std::size_t a, std::size_t b) const override;
+        bool contains(std::size_t row, std::string_view text) const override;
+
+    private:
+        explicit Strings(std::shared_ptr<std::vector<std::string>>);
+
+        std::vector<std::string_view> _values;
+    };
+
+    //
+    // view on zero padded, fixed width strings (e.g. numpy "S" arrays)
+    class FixedStrings : public Source {
+    public:
+        FixedStrings(char const* data, std::size_t size, std::size_t width, std::size_t stride, std::shared_ptr<void> guard = nullptr);
+
+        std::size_t size() const override { return _size; }
+        std::size_t format(std::size_t row, std::string_view spec, char* buffer, std::size_t capacity) const override;
+        int compare(std::size_t a, std::size_t b) const override;
+        bool contains(std::size_t row, std::string_view text) const override;
+        std::shared_ptr<Source const> snapshot() const override;
+
+    private:
+        std::string_view value(std::size_t row) const;
+
+        char const* _data;
+        std::size_t _size;
+        std::size_t _width;
+        std::size_t _stride;
+    };
+
+    //
+    // column specification. the format spec uses fmt syntax, e.g. "{:.3f}"
+    class Column {
+    public:
+        std::string const& title() const { return _title; }
+        void set_title(std::string title) { _title = std::move(title); }
+
+        std::optional<Length> const& width() const { return _width; }
+        void set_width(std::optional<Length> width) { _width = std::move(width); }
+
+        std::string const& format() const { return _format; }
+        void set_format(std::string format) { _format = std::move(format); }
+
+        std::shared_ptr<Source> const& source() const { return _source; }
+        /// the table showing this column is re-indexed and redrawn
+        void set_source(std::shared_ptr<Source>);
+
+    private:
+        friend class DataTable;
+
+        std::string _title;
+        std::optional<Length> _width;
+        std::string _format = "{}";
+        std::shared_ptr<Source> _source;
+        std::weak_ptr<DataTable> _table;
+    };
+
+    /// throws std::invalid_argument if a column is null
+    void set_columns(std::vector<std::shared_ptr<Column>>);
+    std::vector<std::shared_ptr<Column>> columns() const;
+
+    /// length of the longest column
+    std::size_t row_count() const;
+
+    struct SortSpec {
+        std::size_t column = 0;
+        bool descending = false;
+    };
+
+    /// sortable by clicking the headers (shift for multiple columns)
+    bool sortable() const;
+    void set_sortable(bool);
+
+    std::vector<SortSpec> const& sort_specs() const;
+    void set_sort_specs(std::vector<SortSpec>);
+
+    /// shows only rows where any column contains the filter text
+    std::string const& filter() const;
+    void set_filter(std::string);
+
+    //
+    // the index maps displayed rows to rows of the sources. it is built on a
+    // worker thread and replaced between frames, null means identity
+    using Index = std::vector<std::uint32_t>;
+    using OnIndexChange = std::function<void()>;
+
+    std::shared_ptr<Index const> const& index() const;
+
+    /// true while the index is being built
+    bool indexing() const;
+
+    /// rebuild the index, e.g. after the data of a column changed
+    void update_index();
+
+    OnIndexChange on_index_change() const;
+    void set_on_index_change(OnIndexChange);
+
+    int freezed_columns() const;
+    void set_freezed_columns(int);
+
+    int freezed_rows() const;
+    void set_freezed_rows(int);
+
+    bool resizeable() const;
+    void set_resizeable(bool);
+
+    bool reorderable() const;
+    void set_reorderable(bool);
+
+    void render_impl(Context&, float width, float height) override;
+    void update_content() override;
+
+private:
+    void set_index(std::shared_ptr<Index const>);
+
+    std::vector<std::shared_ptr<Column>> _columns;
+    int _freezed_columns = 0;
+    int _freezed_rows = 1;
+    bool _resizeable = false;
+    bool _reorderable = false;
+    bool _sortable = false;
+    std::vector<SortSpec> _sort_specs;
+    std::string _filter;
+    std::shared_ptr<Index const> _index;
+    std::uint64_t _index_request = 0;
+    std::unique_ptr<DataTableIndex> _index_builder;
+    OnIndexChange _on_index_change;
+};
+
+}
@@ -0,0 +1,218 @@
+#include "DataTableIndex.h"
+
+#include <p3/platform/WorkerPool.h>
+
+#include <algorithm>
+#include <limits>
+#include <numeric>
+
+namespace p3 {
+
+namespace {
+
+    //
+    // rows per chunk below which no additional thread is spawned
+    constexpr std::size_t MinimumChunk = 1 << 14;
+
+    std::size_t chunk_count(std::size_t size)
+    {
+        std::size_t concurrency = std::max(1u, std::thread::hardware_concurrency());
+        return std::clamp<std::size_t>(size / MinimumChunk, 1, concurrency);
+    }
+
+    //
+    // without a pool, e.g. for a synchronous build, chunks run one after another
+    void parallel_for(WorkerPool* pool, std::size_t count, std::function<void(std::size_t)> const& f)
+    {
+        if (pool)
+            pool->parallel_for(count, f);
+        else
+            for (std::size_t i = 0; i < count; ++i)
+                f(i);
+    }
+
+    //
+    // chunks are sorted in parallel, then merged pairwise in parallel rounds
+    template <typename Less>
+    bool parallel_sort(WorkerPool* pool, DataTableIndex::Index& items, Less const& less, std::function<bool()> const& cancelled)
+    {
+        auto const size = items.size();
+        auto const chunks = chunk_count(size);
+        std::vector<std::size_t> bounds(chunks + 1);
+        for (std::size_t i = 0; i <= chunks; ++i)
+            bounds[i] = size * i / chunks;
+        parallel_for(pool, chunks, [&](std::size_t i) {
+            std::sort(items.begin() + bounds[i], items.begin() + bounds[i + 1], less);
+        });
+        DataTableIndex::Index buffer(size);
+        while (bounds.size() > 2) {
+            if (cancelled())
+                return false;
+            auto const last = bounds.size() - 1;
+            auto const pairs = (last + 1) / 2;
+            parallel_for(pool, pairs, [&](std::size_t i) {
+                auto first = items.begin() + bounds[2 * i];
+                auto middle = items.begin() + bounds[std::min(2 * i + 1, last)];
+                auto end = items.begin() + bounds[std::min(2 * i + 2, last)];
+                std::merge(first, middle, middle, end, buffer.begin() + bounds[2 * i], less);
+            });
+            std::vector<std::size_t> merged;
+            merged.reserve(pairs + 1);
+            for (std::size_t i = 0; i < pairs; ++i)
+                merged.push_back(bounds[2 * i]);
+            merged.push_back(bounds.back());
+            bounds = std::move(merged);
+            items.swap(buffer);
+        }
+        return !cancelled();
+    }
+
+    bool filter_match(DataTableIndex::Request const& request, std::size_t row)
+    {
+        for (auto const& source : request.filter_sources)
+            if (source && row < source->size() && source->contains(row, request.filter))
+                return true;
+        return false;
+    }
+
+}
+
+DataTableIndex::DataTableIndex()
+    : _thread([this]() { run(); })
+{
+}
+
+DataTableIndex::~DataTableIndex()
+{
+    {
+        std::lock_guard<std::mutex> l(_mutex);
+        _closed = true;
+        ++_generation;
+    }
+    _condition.notify_all();
+    _thread.join();
+}
+
+void DataTableIndex::rebuild(Request request, Callback callback)
+{
+    std::optional<std::pair<Request, Callback>> replaced;
+    std::vector<std::pair<Request, Callback>> retired;
+    {
+        std::lock_guard<std::mutex> l(_mutex);
+        ++_generation;
+        std::swap(replaced, _scheduled);
+        _scheduled.emplace(std::move(request), std::move(callback));
+        std::swap(retired, _retired);
+    }
+    _condition.notify_all();
+}
+
+void DataTableIndex::cancel()
+{
+    std::optional<std::pair<Request, Callback>> replaced;
+    std::vector<std::pair<Request, Callback>> retired;
+    {
+        std::lock_guard<std::mutex> l(_mutex);
+        ++_generation;
+        std::swap(replaced, _scheduled);
+        std::swap(retired, _retired);
+    }
+    _condition.notify_all();
+}
+
+bool DataTableIndex::busy() const
+{
+    std::lock_guard<std::mutex> l(_mutex);
+    return _scheduled || _running;
+}
+
+void DataTableIndex::wait()
+{
+    std::unique_lock<std::mutex> l(_mutex);
+    _condition.wait(l, [&]() { return !_scheduled && !_running; });
+}
+
+void DataTableIndex::run()
+{
+    while (true) {
+        std::pair<Request, Callback> work;
+        std::uint64_t generation;
+        {
+            std::unique_lock<std::mutex> l(_mutex);
+            _condition.wait(l, [&]() { return _closed || _scheduled; });
+            if (_closed)
+                return;
+            work = std::move(_scheduled.value());
+            _scheduled.reset();
+            generation = _generation;
+            _running = true;
+        }
+        //
+        // the threads are created with the first build which is large enough
+        if (!_pool && chunk_count(work.first.row_count) > 1)
+            _pool = std::make_unique<WorkerPool>(std::max(1u, std::thread::hardware_concurrency()) - 1);
+        auto index = build(work.first, [&]() { return _generation != generation; }, _pool.get());
+        if (index && work.second)
+            work.second(std::make_shared<Index const>(std::move(index.value())));
+        {
+            std::lock_guard<std::mutex> l(_mutex);
+            _running = false;
+            _retired.push_back(std::move(work));
+        }
+        _condition.notify_all();
+    }
+}
+
+std::optional<DataTableIndex::Index> DataTableIndex::build(Request const& request, std::function<bool()> cancelled, WorkerPool* pool)
+{
+    if (!cancelled)
+        cancelled = []() { return false; };
+    auto const row_count = std::min<std::size_t>(request.row_count, std::numeric_limits<std::uint32_t>::max());
+
+    Index index;
+    if (request.filter.empty()) {
+        index.resize(row_count);
+        std::iota(index.begin(), index.end(), std::uint32_t(0));
+    } else {
+        auto const chunks = chunk_count(row_count);
+        std::vector<Index> matches(chunks);
+        parallel_for(pool, chunks, [&](std::size_t i) {
+            auto const end = row_count * (i + 1) / chunks;
+            for (auto row = row_count * i / chunks; row < end; ++row)
+                if (filter_match(request, row))
+                    matches[i].push_back(std::uint32_t(row));
+        });
+        for (auto const& chunk : matches)
+            index.insert(index.end(), chunk.begin(), chunk.end());
+    }
+    if (cancelled())
+        return std::nullopt;
+
+    std::vector<SortKey> keys;
+    for (auto const& key : request.keys)
+        if (key.source)
+            keys.push_back(key);
+    if (keys.empty())
+        return index;
+    //
+    // rows a column does not cover are placed last,
+    // ties are resolved by the row to keep the sort stable
+    auto less = [&keys](std::uint32_t a, std::uint32_t b) {
+        for (auto const& key : keys) {
+            auto const size = key.source->size();
+            if ((a < size) != (b < size))
+                return a < size;
+            if (a >= size)
+                continue;
+            auto const comparison = key.source->compare(a, b);
+            if (comparison != 0)
+                return key.descending ? comparison > 0 : comparison < 0;
+        }
+        return a < b;
+    };
+    if (!parallel_sort(pool, index, less, cancelled))
+        return std::nullopt;
+    return index;
+}
+
+}
@@ -0,0 +1,87 @@
+#pragma once
+
+#include <p3/widgets/DataTable.h>
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace p3 {
+
+class WorkerPool;
+
+//
+// builds permutations of the rows of a data table on a worker thread.
+// rows are filtered by a substring and sorted by multiple keys using a
+// parallel merge sort on a persistent pool. the sources are read by the
+// workers and must not change while building, the table passes snapshots
+// taken on its own thread. scheduling a new build cancels the running one.
+class DataTableIndex {
+public:
+    using Index = std::vector<std::uint32_t>;
+
+    struct SortKey {
+        std::shared_ptr<DataTable::Source const> source;
+        bool descending = false;
+    };
+
+    struct Request {
+        std::size_t row_count = 0;
+        std::vector<SortKey> keys;
+        /// rows are kept if any of the filter sources contains the filter text
+        std::string filter;
+        std::vector<std::shared_ptr<DataTable::Source const>> filter_sources;
+    };
+
+    /// invoked on the worker thread with the finished index
+    using Callback = std::function<void(std::shared_ptr<Index const>)>;
+
+    DataTableIndex();
+    ~DataTableIndex();
+
+    DataTableIndex(DataTableIndex const&) = delete;
+    DataTableIndex& operator=(DataTableIndex const&) = delete;
+
+    void rebuild(Request, Callback);
+
+    /// cancel the running and the scheduled build
+    void cancel();
+
+    /// true while a build is scheduled or running
+    bool busy() const;
+
+    /// block until no build is scheduled or running
+    void wait();
+
+    ///
+    /// build synchronously, returns nothing if cancelled.
+    /// chunks are processed in parallel by the pool, if given
+    static std::optional<Index> build(Request const&, std::function<bool()> cancelled = nullptr, WorkerPool* pool = nullptr);
+
+private:
+    void run();
+
+    mutable std::mutex _mutex;
+    std::condition_variable _condition;
+    std::optional<std::pair<Request, Callback>> _scheduled;
+    //
+    // finished work may hold the last reference to a source (and its python
+    // guard), hence it is released by the owning thread, never by the worker
+    std::vector<std::pair<Request, Callback>> _retired;
+    std::atomic<std::uint64_t> _generation { 0 };
+    bool _running = false;
+    bool _closed = false;
+    //
+    // used by the worker thread only, created on demand
+    std::unique_ptr<WorkerPool> _pool;
+    std::thread _thread;
+};
+
+}
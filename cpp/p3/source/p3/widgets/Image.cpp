@@ -28,7 +28,7 @@ void Image::render_impl(Context& context, float width, float height)
     auto id = reinterpret_cast<ImTextureID>(_texture->use(context));
     ImGui::Image(id, size);
     if (ImGui::IsItemClicked() && _on_click && !disabled())
-        postpone([f = _on_click]() {
+        postpone("on_click", [f = _on_click]() {
             f();
         });
     update_status();
@@ -40,7 +40,7 @@ inline void InputScalar<DataType>::render_impl(Context&, float width, float heig
         _format ? _format.value().c_str() : nullptr,
         0);
     if (changed && _on_change && !disabled())
-        postpone([f = _on_change, value = _value]() {
+        postpone("on_change", [f = _on_change, value = _value]() {
             f(value);
         });
     update_status();
@@ -27,7 +27,7 @@ void InputText::render_impl(Context&, float width, float height)
     if (_hint) {
         if (ImGui::InputTextWithHint(imgui_label().c_str(), _hint.value().c_str(), _value.data(), _size))
             if (_on_change)
-                postpone(_on_change);
+                postpone("on_change", _on_change);
     } else {
         if (_multi_line) {
             ImVec2 size(width, height);
@@ -40,13 +40,13 @@ void InputText::render_impl(Context&, float width, float height)
                     InputText::Callback,
                     this)) {
                 if (_on_change)
-                    postpone(_on_change);
+                    postpone("on_change", _on_change);
             }
         } else {
             if (ImGui::InputText(imgui_label().c_str(), _value.data(), _value.capacity(),
                     ImGuiInputTextFlags_CallbackResize, InputText::Callback, this))
                 if (_on_change)
-                    postpone(_on_change);
+                    postpone("on_change", _on_change);
         }
     }
     if (ImGui::IsItemActivated()) {
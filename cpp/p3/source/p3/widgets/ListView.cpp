@@ -0,0 +1,243 @@
+#include "ListView.h"
+
+#include <p3/Context.h>
+#include <p3/constant.h>
+#include <p3/platform/event_loop.h>
+
+#include <imgui.h>
+#include <imgui_internal.h>
+
+#include <algorithm>
+#include <cmath>
+
+namespace p3 {
+
+ListView::ListView()
+    : Node("ListView")
+{
+}
+
+void ListView::update_content()
+{
+    auto const rows = (_item_count + _columns - 1) / _columns;
+    _automatic_width = DefaultItemWidthEm * ImGui::GetCurrentContext()->FontSize;
+    _automatic_height = float(rows) * Context::current().to_actual(_item_height);
+}
+
+void ListView::render_impl(Context& context, float width, float height)
+{
+    auto const origin = ImGui::GetCursorPos();
+    auto const item_height = Context::current().to_actual(_item_height);
+    auto const item_width = width / float(_columns);
+    auto const rows = (_item_count + _columns - 1) / _columns;
+
+    std::size_t first = 0;
+    std::size_t last = 0;
+    if (item_height > 0.f && _factory && _bind) {
+        auto const& clip_rect = ImGui::GetCurrentWindow()->ClipRect;
+        auto const top = ImGui::GetCursorScreenPos().y;
+        auto const first_row = std::size_t(std::max(0.f, std::floor((clip_rect.Min.y - top) / item_height)));
+        auto const last_row = std::size_t(std::max(0.f, std::ceil((clip_rect.Max.y - top) / item_height)));
+        last = std::min(std::min(last_row, rows) * _columns, _item_count);
+        //
+        // scrolled past a partial last row
+        first = std::min(std::min(first_row, rows) * _columns, last);
+    }
+
+    //
+    // release widgets of items that left the viewport
+    _visible.assign(last - first, nullptr);
+    for (auto& slot : _slots) {
+        if (!slot.item)
+            continue;
+        if (slot.item.value() < first || slot.item.value() >= last)
+            slot.item.reset();
+        else
+            _visible[slot.item.value() - first] = &slot;
+    }
+
+    //
+    // bind the items that entered the viewport, reuse free widgets first.
+    // factory and bind may call back into python, do this in one batch
+    auto missing = std::count(_visible.begin(), _visible.end(), nullptr);
+    if (missing) {
+        run_in_external_scope([&]() {
+            auto free = _slots.begin();
+            for (auto item = first; item < last; ++item) {
+                if (_visible[item - first])
+                    continue;
+                while (free != _slots.end() && free->item)
+                    ++free;
+                if (free == _slots.end()) {
+                    auto node = _factory();
+                    if (!node)
+                        return;
+                    Node::add(node);
+                    _slots.push_back(Slot { std::move(node), std::nullopt });
+                    free = std::prev(_slots.end());
+                }
+                free->item = item;
+                _bind(free->node, item);
+            }
+        });
+    }
+    //
+    // pointers are invalidated if the pool has grown or was trimmed
+    if (trim_pool(last - first) || missing) {
+        _visible.assign(last - first, nullptr);
+        for (auto& slot : _slots)
+            if (slot.item)
+                _visible[slot.item.value() - first] = &slot;
+    }
+
+    for (auto slot : _visible) {
+        if (!slot)
+            continue;
+        //
+        // widgets added or bound in this frame are measured before they
+        // are rendered, the update pass of this frame is already over
+        slot->node->update_restyle(context, false);
+        auto const item = slot->item.value();
+        auto const row = item / _columns;
+        auto const column = item % _columns;
+        ImGui::SetCursorPos(ImVec2(origin.x + float(column) * item_width, origin.y + float(row) * item_height));
+        ImGui::GetCurrentWindow()->DC.CurrLineTextBaseOffset = 0;
+        slot->node->render(context, item_width, item_height, true);
+    }
+
+    //
+    // extend the content region by the full height of the list
+    ImGui::SetCursorPos(ImVec2(origin.x, origin.y + std::max(height, float(rows) * item_height)));
+    render_absolute(context);
+}
+
+std::size_t ListView::item_count() const
+{
+    return _item_count;
+}
+
+void ListView::set_item_count(std::size_t item_count)
+{
+    if (_item_count == item_count)
+        return;
+    _item_count = item_count;
+    set_needs_update();
+}
+
+Length const& ListView::item_height() const
+{
+    return _item_height;
+}
+
+void ListView::set_item_height(Length item_height)
+{
+    _item_height = std::move(item_height);
+    set_needs_update();
+}
+
+std::size_t ListView::columns() const
+{
+    return _columns;
+}
+
+void ListView::set_columns(std::size_t columns)
+{
+    _columns = std::max(std::size_t(1), columns);
+    set_needs_update();
+}
+
+ListView::Factory ListView::factory() const
+{
+    return _factory;
+}
+
+void ListView::set_factory(Factory factory)
+{
+    _factory = std::move(factory);
+    clear_pool();
+}
+
+ListView::Bind ListView::bind() const
+{
+    return _bind;
+}
+
+void ListView::set_bind(Bind bind)
+{
+    _bind = std::move(bind);
+    invalidate_items();
+}
+
+ListView::Release ListView::release() const
+{
+    return _release;
+}
+
+void ListView::set_release(Release release)
+{
+    _release = std::move(release);
+}
+
+void ListView::invalidate_items()
+{
+    for (auto& slot : _slots)
+        slot.item.reset();
+    set_needs_repaint();
+}
+
+std::size_t ListView::pool_size() const
+{
+    return _slots.size();
+}
+
+bool ListView::trim_pool(std::size_t visible)
+{
+    //
+    // keep enough free widgets for scrolling by a viewport,
+    // widgets beyond are released, e.g. after shrinking the view
+    auto const capacity = 2 * visible + _columns;
+    if (_slots.size() <= capacity)
+        return false;
+    std::vector<std::shared_ptr<Node>> released;
+    auto free = _slots.size() - capacity;
+    _slots.erase(std::remove_if(_slots.begin(), _slots.end(), [&](auto& slot) {
+        if (free == 0 || slot.item)
+            return false;
+        --free;
+        released.push_back(std::move(slot.node));
+        return true;
+    }),
+        _slots.end());
+    if (released.empty())
+        return false;
+    run_in_external_scope([&]() {
+        for (auto& node : released) {
+            Node::remove(node);
+            if (_release)
+                _release(std::move(node));
+        }
+        released.clear();
+    });
+    return true;
+}
+
+void ListView::clear_pool()
+{
+    auto slots = std::move(_slots);
+    _slots.clear();
+    _visible.clear();
+    if (slots.empty())
+        return;
+    //
+    // release may call back into python, the widgets may be owned by it
+    run_in_external_scope([&]() {
+        for (auto& slot : slots) {
+            Node::remove(slot.node);
+            if (_release)
+                _release(std::move(slot.node));
+        }
+        slots.clear();
+    });
+}
+
+}
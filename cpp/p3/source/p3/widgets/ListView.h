@@ -0,0 +1,74 @@
+#pragma once
+
+#include <p3/Node.h>
+
+#include <functional>
+#include <optional>
+
+namespace p3 {
+
+//
+// model driven list/grid. the application provides the number of items,
+// a factory for item widgets and a bind function that assigns an item
+// to a widget. only the items intersecting the clip rect of the current
+// window are bound. widgets of items leaving the viewport are recycled,
+// hence the number of nodes scales with the viewport, not with the model.
+// the pool is capped at twice the visible items, released widgets are
+// passed to the release function, e.g. to drop references to them.
+class ListView : public Node {
+public:
+    using Factory = std::function<std::shared_ptr<Node>()>;
+    using Bind = std::function<void(std::shared_ptr<Node>, std::size_t)>;
+    using Release = std::function<void(std::shared_ptr<Node>)>;
+
+    ListView();
+
+    void update_content() override;
+    void render_impl(Context&, float width, float height) override;
+
+    std::size_t item_count() const;
+    void set_item_count(std::size_t);
+
+    Length const& item_height() const;
+    void set_item_height(Length);
+
+    std::size_t columns() const;
+    void set_columns(std::size_t);
+
+    Factory factory() const;
+    void set_factory(Factory);
+
+    Bind bind() const;
+    void set_bind(Bind);
+
+    /// called for each widget removed from the pool
+    Release release() const;
+    void set_release(Release);
+
+    /// rebind all visible items, e.g. if the model changed
+    void invalidate_items();
+
+    /// number of (recycled) item widgets
+    std::size_t pool_size() const;
+
+private:
+    struct Slot {
+        std::shared_ptr<Node> node;
+        std::optional<std::size_t> item;
+    };
+
+    /// releases free widgets exceeding twice the visible items
+    bool trim_pool(std::size_t visible);
+    void clear_pool();
+
+    std::size_t _item_count = 0;
+    Length _item_height = 2.f | em;
+    std::size_t _columns = 1;
+    Factory _factory;
+    Bind _bind;
+    Release _release;
+    std::vector<Slot> _slots;
+    std::vector<Slot*> _visible;
+};
+
+}
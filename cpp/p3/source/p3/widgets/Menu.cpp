@@ -24,7 +24,7 @@ void Menu::render_impl(Context& context, float width, float height)
         if (!_opened) {
             _opened = true;
             if (_on_open)
-                postpone(_on_open);
+                postpone("on_open", _on_open);
         }
         for (auto& node : children())
             node->render(context, width, height);
@@ -32,7 +32,7 @@ void Menu::render_impl(Context& context, float width, float height)
     } else if (_opened) {
         _opened = false;
         if (_on_close)
-            postpone(_on_close);
+            postpone("on_close", _on_close);
     }
     update_status();
 }
@@ -24,9 +24,9 @@ void MenuItem::render_impl(Context&, float width, float height)
             _shortcut ? _shortcut.value().c_str() : nullptr,
             _checkable ? &_value : nullptr, _enabled)) {
         if (_on_click)
-            postpone(_on_click);
+            postpone("on_click", _on_click);
         if (_checkable && _on_change)
-            postpone([f = _on_change, value = _value]() {
+            postpone("on_change", [f = _on_change, value = _value]() {
                 f(value);
             });
     }
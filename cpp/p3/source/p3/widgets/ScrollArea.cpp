@@ -65,7 +65,7 @@ void ScrollArea::render_impl(Context& context, float width, float height)
     if (content_region != _content_region) {
         _content_region = std::move(content_region);
         if (_on_content_region_changed)
-            postpone([f = _on_content_region_changed, rect = _content_region]() {
+            postpone("on_content_region_changed", [f = _on_content_region_changed, rect = _content_region]() {
                 f(rect);
             });
     }
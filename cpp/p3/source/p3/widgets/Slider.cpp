@@ -55,7 +55,7 @@ inline void Slider<DataType>::render_impl(Context&, float width, float height)
             _format ? _format.value().c_str() : nullptr);
     }
     if (changed && _on_change && !disabled())
-        postpone([f = _on_change, value = _value]() {
+        postpone("on_change", [f = _on_change, value = _value]() {
             f(value);
         });
     update_status();
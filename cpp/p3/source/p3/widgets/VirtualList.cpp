@@ -0,0 +1,163 @@
+#include "VirtualList.h"
+
+#include <p3/Context.h>
+
+#include <imgui.h>
+#include <imgui_internal.h>
+
+#include <algorithm>
+
+namespace p3 {
+
+VirtualList::VirtualList()
+    : Node("VirtualList")
+{
+}
+
+void VirtualList::update_content()
+{
+    auto const spacing = _spacing
+        ? Context::current().to_actual(_spacing.value())
+        : ImGui::GetStyle().ItemSpacing.y;
+    if (spacing != _actual_spacing || _heights.size() != children().size()) {
+        _actual_spacing = spacing;
+        _rebuild = true;
+    }
+    if (_rebuild) {
+        rebuild();
+    } else {
+        auto widest_shrank = false;
+        for (auto child : _resized) {
+            auto it = _indices.find(child);
+            if (it == _indices.end())
+                continue;
+            auto const index = it->second;
+            auto const absolute = std::lower_bound(_absolute.begin(), _absolute.end(), index);
+            auto const was_absolute = absolute != _absolute.end() && *absolute == index;
+            if (child->position() == Position::Absolute && !was_absolute)
+                _absolute.insert(absolute, index);
+            else if (child->position() != Position::Absolute && was_absolute)
+                _absolute.erase(absolute);
+            float width;
+            _heights.set(index, measure(*child, width));
+            widest_shrank = widest_shrank || (width < _widths[index] && _widths[index] >= _automatic_width);
+            _widths[index] = width;
+            _automatic_width = std::max(_automatic_width, width);
+        }
+        //
+        // O(n), but only if the widest child became narrower
+        if (widest_shrank)
+            _automatic_width = _widths.empty() ? 0.f : *std::max_element(_widths.begin(), _widths.end());
+    }
+    _resized.clear();
+    _automatic_height = std::max(0.f, float(_heights.total()) - _actual_spacing);
+}
+
+void VirtualList::children_changed()
+{
+    _rebuild = true;
+}
+
+void VirtualList::child_resized(Node& child)
+{
+    if (_rebuild)
+        return;
+    //
+    // e.g. a restyle of the whole list, one pass is cheaper than
+    // looking up and updating each child
+    if (2 * _resized.size() >= children().size()) {
+        _rebuild = true;
+        _resized.clear();
+        return;
+    }
+    _resized.push_back(&child);
+}
+
+double VirtualList::measure(Node const& child, float& width) const
+{
+    if (!child.visible() || child.position() == Position::Absolute) {
+        width = 0.f;
+        return 0.;
+    }
+    width = child.contextual_width(0);
+    return child.contextual_height(0) + _actual_spacing;
+}
+
+void VirtualList::rebuild()
+{
+    auto const& children = this->children();
+    std::vector<double> heights;
+    heights.reserve(children.size());
+    _widths.resize(children.size());
+    _indices.clear();
+    _indices.reserve(children.size());
+    _absolute.clear();
+    _automatic_width = 0.f;
+    for (std::size_t i = 0; i < children.size(); ++i) {
+        heights.push_back(measure(*children[i], _widths[i]));
+        _automatic_width = std::max(_automatic_width, _widths[i]);
+        _indices.emplace(children[i].get(), i);
+        if (children[i]->position() == Position::Absolute)
+            _absolute.push_back(i);
+    }
+    _heights.assign(std::move(heights));
+    _rebuild = false;
+}
+
+void VirtualList::render_impl(Context& context, float width, float height)
+{
+    auto const& children = this->children();
+    auto const origin = ImGui::GetCursorPos();
+    _visible_range = { 0, 0 };
+    //
+    // children and index are out of sync until the next update pass
+    if (_heights.size() == children.size()) {
+        auto const& clip_rect = ImGui::GetCurrentWindow()->ClipRect;
+        auto const top = double(ImGui::GetCursorScreenPos().y);
+        auto const bottom = double(clip_rect.Max.y) - top;
+        auto index = _heights.find(std::max(0., double(clip_rect.Min.y) - top));
+        auto y = _heights.prefix(index);
+        _visible_range[0] = index;
+        for (; index < children.size() && y < bottom; ++index) {
+            auto const& child = children[index];
+            auto const item_height = _heights.value(index);
+            if (child->visible() && child->position() != Position::Absolute) {
+                ImGui::SetCursorPos(ImVec2(origin.x, origin.y + float(y)));
+                ImGui::GetCurrentWindow()->DC.CurrLineTextBaseOffset = 0;
+                child->render(context, width, float(item_height) - _actual_spacing, true);
+            }
+            y += item_height;
+        }
+        _visible_range[1] = index;
+    }
+    //
+    // extend the content region by the full height of the list
+    ImGui::SetCursorPos(ImVec2(origin.x, origin.y + height));
+    //
+    // like Node::render_absolute, without a pass over all children
+    if (!parent() || _heights.size() != children.size())
+        return;
+    for (auto index : _absolute) {
+        auto const& child = children[index];
+        auto const avail = ImGui::GetContentRegionAvail();
+        child->render(context, child->contextual_width(avail.x), child->contextual_height(avail.y));
+    }
+}
+
+std::optional<Length> const& VirtualList::spacing() const
+{
+    return _spacing;
+}
+
+void VirtualList::set_spacing(std::optional<Length> spacing)
+{
+    _spacing = std::move(spacing);
+    set_needs_update();
+}
+
+VirtualList::Range const& VirtualList::visible_range() const
+{
+    return _visible_range;
+}
+
+}
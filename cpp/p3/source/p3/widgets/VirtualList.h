@@ -0,0 +1,59 @@
+#pragma once
+
+#include <p3/FenwickTree.h>
+#include <p3/Node.h>
+
+#include <array>
+#include <optional>
+#include <unordered_map>
+#include <vector>
+
+namespace p3 {
+
+//
+// vertical list that only renders the children intersecting the clip
+// rect of the current window, e.g. of an enclosing ScrollArea. the
+// heights of the children are kept in a prefix-sum index, the first
+// visible child is found by a binary search. absolutely positioned
+// children are kept apart and always rendered.
+class VirtualList : public Node {
+public:
+    using Range = std::array<std::size_t, 2>;
+
+    VirtualList();
+
+    void update_content() override;
+    void render_impl(Context&, float width, float height) override;
+
+    std::optional<Length> const& spacing() const;
+    void set_spacing(std::optional<Length>);
+
+    /// [begin, end) of the children rendered in the last frame
+    Range const& visible_range() const;
+
+protected:
+    void children_changed() override;
+    void child_resized(Node&) override;
+
+private:
+    /// height including the spacing, zero for hidden and absolute children
+    double measure(Node const&, float& width) const;
+    void rebuild();
+
+    std::optional<Length> _spacing = std::nullopt;
+    float _actual_spacing = 0.f;
+    FenwickTree<double> _heights;
+    std::vector<float> _widths;
+    //
+    // children resized since the last update, updated in O(log n) each.
+    // adding or removing children, or resizing most of them, rebuilds
+    // the index in O(n)
+    std::unordered_map<Node const*, std::size_t> _indices;
+    std::vector<Node const*> _resized;
+    /// sorted indices of the absolutely positioned children
+    std::vector<std::size_t> _absolute;
+    bool _rebuild = true;
+    Range _visible_range { 0, 0 };
+};
+
+}
@@ -27,7 +27,7 @@ void CheckBox::render_impl(Context& context, float width, float height)
     if (changed && !disabled()) {
         _value = value;
         if (_on_change) {
-            postpone([f = _on_change, value = value]() {
+            postpone("on_change", [f = _on_change, value = value]() {
                 f(value);
             });
         }
@@ -46,7 +46,7 @@ void ChildWindow::render_impl(Context& context, float width, float height)
     ImGui::End();
 
     if (_on_close && !open)
-        postpone([f = _on_close]() {
+        postpone("on_close", [f = _on_close]() {
             f();
         });
     update_status();
@@ -0,0 +1,51 @@
+#include "headless.h"
+
+#include <p3/Context.h>
+#include <p3/UserInterface.h>
+#include <p3/backend/RasterRenderBackend.h>
+#include <p3/platform/event_loop.h>
+
+#include <imgui.h>
+#include <implot.h>
+
+namespace p3::tests {
+
+Headless::Headless(std::size_t width, std::size_t height, std::size_t threads)
+    : _width(width)
+    , _height(height)
+    , _event_loop(std::make_shared<EventLoop>())
+{
+    _user_interface = std::make_shared<UserInterface>(width, height);
+    ImGui::SetCurrentContext(&_user_interface->im_gui_context());
+    ImPlot::SetCurrentContext(&_user_interface->im_plot_context());
+    _render_backend = std::make_shared<RasterRenderBackend>(threads);
+    _render_backend->init();
+    _target = _render_backend->create_render_target(std::uint32_t(width), std::uint32_t(height));
+    //
+    // no platform backend, the display is fixed
+    auto& io = ImGui::GetIO();
+    io.DisplaySize = ImVec2(float(width), float(height));
+    io.DeltaTime = 1.f / 60.f;
+}
+
+Headless::~Headless()
+{
+    _render_backend->shutdown();
+}
+
+void Headless::frame()
+{
+    ImGui::SetCurrentContext(&_user_interface->im_gui_context());
+    ImPlot::SetCurrentContext(&_user_interface->im_plot_context());
+    _render_backend->new_frame();
+    _render_backend->gc();
+    {
+        Context context(*_user_interface, *_render_backend, std::nullopt);
+        _user_interface->render(context, float(_width), float(_height), false);
+    }
+    _target->bind();
+    _render_backend->render(*_user_interface);
+    _target->release();
+}
+
+}
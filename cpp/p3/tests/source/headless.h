@@ -0,0 +1,44 @@
+#pragma once
+
+#include <p3/RenderBackend.h>
+
+#include <cstddef>
+#include <memory>
+
+namespace p3 {
+
+class EventLoop;
+class RasterRenderBackend;
+class UserInterface;
+
+namespace tests {
+
+    /*
+     * a user interface rendered by the raster backend, hence no window
+     * and no gpu are needed. frame() does the update pass, renders and
+     * rasterizes the draw data into the target
+     */
+    class Headless {
+    public:
+        /// threads rasterizing the tiles, see RasterRenderBackend
+        Headless(std::size_t width = 640, std::size_t height = 480, std::size_t threads = 1);
+        ~Headless();
+
+        UserInterface& user_interface() const { return *_user_interface; }
+        RasterRenderBackend& render_backend() const { return *_render_backend; }
+        RenderBackend::RenderTarget& target() const { return *_target; }
+
+        void frame();
+
+    private:
+        std::size_t _width;
+        std::size_t _height;
+        std::shared_ptr<EventLoop> _event_loop;
+        std::shared_ptr<UserInterface> _user_interface;
+        std::shared_ptr<RasterRenderBackend> _render_backend;
+        RenderBackend::RenderTarget* _target = nullptr;
+    };
+
+}
+
+}
@@ -0,0 +1,81 @@
+#include <catch2/catch.hpp>
+
+#include <p3/platform/event_loop.h>
+
+#include <thread>
+
+namespace p3::tests {
+
+using namespace std::chrono_literals;
+
+TEST_CASE("callback_statistics_keeps_slowest_handlers", "[p3]")
+{
+    CallbackStatistics statistics;
+    statistics.set_size(2);
+    statistics.record(nullptr, "a", 3ms);
+    statistics.record(nullptr, "b", 1ms);
+    statistics.record(nullptr, "a", 2ms);
+    statistics.record(nullptr, "c", 5ms);
+    statistics.record(nullptr, "b", 4ms);
+
+    auto slowest = statistics.slowest();
+    REQUIRE(slowest.size() == 2);
+    REQUIRE(slowest[0].signal == "c");
+    REQUIRE(slowest[0].duration == 5ms);
+    REQUIRE(slowest[1].signal == "b");
+    REQUIRE(slowest[1].duration == 4ms);
+    REQUIRE(statistics.calls() == 5);
+    REQUIRE(statistics.total() == 15ms);
+
+    statistics.reset();
+    REQUIRE(statistics.slowest().empty());
+    REQUIRE(statistics.calls() == 0);
+}
+
+TEST_CASE("event_loop_records_callback_times", "[p3]")
+{
+    EventLoop loop;
+    auto fast = Event::create([]() {});
+    fast->set_origin({}, "fast");
+    auto slow = Event::create([&]() {
+        std::this_thread::sleep_for(5ms);
+        loop.stop();
+    });
+    slow->set_origin({}, "slow");
+    loop.call_at(EventLoop::Clock::now(), std::move(fast));
+    loop.call_at(EventLoop::Clock::now(), std::move(slow));
+    loop.run_forever();
+
+    auto slowest = loop.callback_statistics().slowest();
+    REQUIRE(slowest.size() == 2);
+    REQUIRE(slowest[0].signal == "slow");
+    REQUIRE(slowest[0].duration >= 5ms);
+    REQUIRE(slowest[1].signal == "fast");
+}
+
+TEST_CASE("event_loop_does_not_count_self_timed_events_twice", "[p3]")
+{
+    EventLoop loop;
+    auto batch = Event::create([&]() {
+        //
+        // like a batch of mouse events, which times its handlers
+        auto const begin = EventLoop::Clock::now();
+        std::this_thread::sleep_for(2ms);
+        loop.callback_statistics().record(nullptr, "on_mouse_move", EventLoop::Clock::now() - begin);
+    });
+    batch->set_self_timed();
+    auto stop = Event::create([&]() { loop.stop(); });
+    stop->set_origin({}, "stop");
+    loop.call_at(EventLoop::Clock::now(), std::move(batch));
+    loop.call_at(EventLoop::Clock::now(), std::move(stop));
+    loop.run_forever();
+
+    auto& statistics = loop.callback_statistics();
+    REQUIRE(statistics.calls() == 2);
+    auto slowest = statistics.slowest();
+    REQUIRE(slowest.size() == 2);
+    REQUIRE(slowest[0].signal == "on_mouse_move");
+    REQUIRE(statistics.total() == slowest[0].duration + slowest[1].duration);
+}
+
+}
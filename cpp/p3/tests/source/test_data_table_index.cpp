@@ -0,0 +1,159 @@
+#include <catch2/catch.hpp>
+
+#include <p3/platform/WorkerPool.h>
+#include <p3/widgets/DataTableIndex.h>
+
+#include <chrono>
+#include <iostream>
+#include <random>
+#include <stdexcept>
+#include <thread>
+
+namespace p3::tests {
+
+TEST_CASE("data_table_index_sorts_by_multiple_keys", "[p3]")
+{
+    std::vector<std::int32_t> group { 1, 0, 1, 0, 1 };
+    std::vector<double> value { 5., 4., 3., 2., 1. };
+    DataTableIndex::Request request;
+    request.row_count = group.size();
+    request.keys.push_back({ std::make_shared<DataTable::Span<std::int32_t>>(group.data(), group.size()), false });
+    request.keys.push_back({ std::make_shared<DataTable::Span<double>>(value.data(), value.size()), true });
+    auto index = DataTableIndex::build(request);
+    REQUIRE(index.value() == DataTableIndex::Index { 1, 3, 0, 2, 4 });
+}
+
+TEST_CASE("data_table_index_filters_by_substring", "[p3]")
+{
+    DataTableIndex::Request request;
+    request.row_count = 4;
+    request.filter = "an";
+    request.filter_sources.push_back(std::make_shared<DataTable::Strings>(
+        std::vector<std::string> { "banana", "cherry", "mango", "kiwi" }));
+    auto index = DataTableIndex::build(request);
+    REQUIRE(index.value() == DataTableIndex::Index { 0, 2 });
+}
+
+TEST_CASE("data_table_index_builds_in_background", "[p3]")
+{
+    std::vector<double> value { 3., 1., 2. };
+    DataTableIndex::Request request;
+    request.row_count = value.size();
+    request.keys.push_back({ std::make_shared<DataTable::Span<double>>(value.data(), value.size()), false });
+
+    DataTableIndex builder;
+    std::shared_ptr<DataTableIndex::Index const> result;
+    builder.rebuild(request, [&](auto index) { result = index; });
+    builder.wait();
+    REQUIRE(!builder.busy());
+    REQUIRE(*result == DataTableIndex::Index { 1, 2, 0 });
+}
+
+TEST_CASE("data_table_index_sorts_a_snapshot", "[p3]")
+{
+    std::vector<double> value { 3., 1., 2. };
+    DataTable::Span<double> span(value.data(), value.size());
+    auto snapshot = span.snapshot();
+    REQUIRE(snapshot);
+    //
+    // changes of the owner after taking the snapshot are not seen
+    value[0] = 0.;
+    REQUIRE(snapshot->compare(0, 1) > 0);
+    REQUIRE(span.compare(0, 1) < 0);
+    REQUIRE(!DataTable::Strings(std::vector<std::string> { "a" }).snapshot());
+}
+
+namespace {
+
+    //
+    // span counting its snapshots
+    class CountingSpan : public DataTable::Span<std::int32_t> {
+    public:
+        using Span::Span;
+
+        std::shared_ptr<DataTable::Source const> snapshot() const override
+        {
+            ++snapshots;
+            return Span::snapshot();
+        }
+
+        mutable int snapshots = 0;
+    };
+
+}
+
+TEST_CASE("data_table_snapshots_keys_before_indexing", "[p3]")
+{
+    std::vector<std::int32_t> value { 2, 0, 1 };
+    auto source = std::make_shared<CountingSpan>(value.data(), value.size());
+
+    //
+    // the index reads the given sources, it does not copy them
+    DataTableIndex::Request request;
+    request.row_count = value.size();
+    request.keys.push_back({ source, false });
+    REQUIRE(DataTableIndex::build(request).value() == DataTableIndex::Index { 1, 2, 0 });
+    REQUIRE(source->snapshots == 0);
+
+    //
+    // the table copies keys and filter sources on its own thread
+    auto table = std::make_shared<DataTable>();
+    auto column = std::make_shared<DataTable::Column>();
+    column->set_source(source);
+    table->set_columns({ column });
+    table->set_sort_specs({ { 0, false } });
+    REQUIRE(source->snapshots == 1);
+    REQUIRE(*table->index() == DataTableIndex::Index { 1, 2, 0 });
+    table->set_filter("1");
+    REQUIRE(source->snapshots == 3);
+    REQUIRE(*table->index() == DataTableIndex::Index { 2 });
+}
+
+TEST_CASE("data_table_index_sorts_on_pool", "[p3]")
+{
+    std::size_t constexpr rows = 100000;
+    std::mt19937 generator(42);
+    std::uniform_int_distribution<std::int32_t> distribution(0, 100);
+    std::vector<std::int32_t> value(rows);
+    for (auto& v : value)
+        v = distribution(generator);
+    DataTableIndex::Request request;
+    request.row_count = rows;
+    request.keys.push_back({ std::make_shared<DataTable::Span<std::int32_t>>(value.data(), value.size()), false });
+
+    WorkerPool pool(3);
+    auto index = DataTableIndex::build(request, nullptr, &pool);
+    REQUIRE(index.value() == DataTableIndex::build(request).value());
+    REQUIRE(std::is_sorted(index->begin(), index->end(), [&](auto a, auto b) { return value[a] < value[b]; }));
+}
+
+TEST_CASE("data_table_rejects_null_columns", "[p3]")
+{
+    DataTable table;
+    auto column = std::make_shared<DataTable::Column>();
+    table.set_columns({ column });
+    REQUIRE_THROWS_AS(table.set_columns({ column, nullptr }), std::invalid_argument);
+    REQUIRE(table.columns().size() == 1);
+}
+
+TEST_CASE("benchmark_data_table_index_sort_1m", "[.][benchmark]")
+{
+    std::size_t constexpr rows = 1000000;
+    std::mt19937 generator(42);
+    std::uniform_real_distribution<double> distribution;
+    std::vector<double> value(rows);
+    for (auto& v : value)
+        v = distribution(generator);
+    DataTableIndex::Request request;
+    request.row_count = rows;
+    request.keys.push_back({ std::make_shared<DataTable::Span<double>>(value.data(), value.size()), false });
+
+    WorkerPool pool(std::max(1u, std::thread::hardware_concurrency()) - 1);
+    auto start = std::chrono::steady_clock::now();
+    auto index = DataTableIndex::build(request, nullptr, &pool);
+    auto elapsed = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    std::cout << "data table index: sorted " << rows << " rows in " << elapsed << "ms" << std::endl;
+    REQUIRE(std::is_sorted(index->begin(), index->end(), [&](auto a, auto b) { return value[a] < value[b]; }));
+}
+
+}
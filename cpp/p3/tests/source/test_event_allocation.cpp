@@ -0,0 +1,122 @@
+#include <catch2/catch.hpp>
+
+#include <p3/platform/event_loop.h>
+
+#include <atomic>
+#include <cstdlib>
+#include <iostream>
+#include <new>
+#include <thread>
+#include <vector>
+
+//
+// counts the heap allocations of the test binary, built as its own
+// executable (p3_allocation_tests) to not affect the other tests
+namespace {
+std::atomic<std::size_t> allocations { 0 };
+}
+
+void* operator new(std::size_t size)
+{
+    ++allocations;
+    if (auto pointer = std::malloc(size ? size : 1))
+        return pointer;
+    throw std::bad_alloc();
+}
+
+void operator delete(void* pointer) noexcept
+{
+    std::free(pointer);
+}
+
+void operator delete(void* pointer, std::size_t) noexcept
+{
+    std::free(pointer);
+}
+
+namespace p3::tests {
+
+namespace {
+
+    //
+    // events as they were created before pooling
+    class LegacyEvent {
+    public:
+        LegacyEvent(std::function<void()> function)
+            : _function(std::move(function))
+        {
+        }
+        virtual ~LegacyEvent() = default;
+        virtual void operator()() { _function(); }
+
+    private:
+        std::function<void()> _function;
+    };
+
+    struct Capture {
+        std::shared_ptr<int> counter;
+        float x, y;
+    };
+
+    template <typename F>
+    double allocations_per_event(std::size_t cycles, F&& f)
+    {
+        auto before = allocations.load();
+        for (std::size_t i = 0; i < cycles; ++i)
+            f();
+        return double(allocations.load() - before) / double(cycles);
+    }
+
+}
+
+TEST_CASE("small_events_are_recycled_without_allocation", "[p3]")
+{
+    auto counter = std::make_shared<int>(0);
+    Event::create([counter]() { ++*counter; }).reset();
+    auto per_event = allocations_per_event(100, [&]() {
+        auto event = Event::create([counter, x = 1.f, y = 2.f]() { *counter += int(x + y); });
+        (*event)();
+    });
+    REQUIRE(per_event == 0.);
+    REQUIRE(*counter == 300);
+}
+
+TEST_CASE("events_are_recycled_across_threads", "[p3]")
+{
+    //
+    // producers create the events, the consuming thread destroys them
+    auto counter = std::make_shared<std::atomic<int>>(0);
+    std::vector<std::unique_ptr<Event>> events(4000);
+    std::vector<std::thread> producers;
+    for (std::size_t thread = 0; thread < 4; ++thread)
+        producers.emplace_back([&, thread]() {
+            for (std::size_t i = thread; i < events.size(); i += 4)
+                events[i] = Event::create([counter]() { ++*counter; });
+        });
+    for (auto& producer : producers)
+        producer.join();
+    for (auto& event : events) {
+        (*event)();
+        event.reset();
+    }
+    REQUIRE(*counter == 4000);
+    REQUIRE(counter.use_count() == 1);
+}
+
+TEST_CASE("benchmark_event_allocations", "[.][benchmark]")
+{
+    std::size_t constexpr cycles = 100000;
+    Capture capture { std::make_shared<int>(0), 1.f, 2.f };
+    auto legacy = allocations_per_event(cycles, [&]() {
+        auto event = std::make_unique<LegacyEvent>([capture]() { ++*capture.counter; });
+        (*event)();
+    });
+    auto pooled = allocations_per_event(cycles, [&]() {
+        auto event = Event::create([capture]() { ++*capture.counter; });
+        (*event)();
+    });
+    std::cout << "allocations per event: legacy=" << legacy << ", pooled=" << pooled << std::endl;
+    REQUIRE(pooled < legacy);
+}
+
+}
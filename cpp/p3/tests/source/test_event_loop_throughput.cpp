@@ -0,0 +1,134 @@
+#include <catch2/catch.hpp>
+
+#include <p3/platform/event_loop.h>
+
+#include <atomic>
+#include <iostream>
+#include <thread>
+
+namespace p3::tests {
+
+namespace {
+
+    using namespace std::chrono_literals;
+
+    void expire(TimerWheel& wheel, TimerWheel::TimePoint now)
+    {
+        std::vector<Event*> expired;
+        wheel.expire(now, expired);
+        for (auto event : expired) {
+            (*event)();
+            delete event;
+        }
+    }
+
+    double post_from_threads(std::size_t threads, std::size_t events_per_thread)
+    {
+        EventLoop loop;
+        std::atomic<std::size_t> processed { 0 };
+        auto const total = threads * events_per_thread;
+        auto const start = std::chrono::steady_clock::now();
+        std::vector<std::thread> producers;
+        for (std::size_t i = 0; i < threads; ++i)
+            producers.emplace_back([&]() {
+                for (std::size_t j = 0; j < events_per_thread; ++j)
+                    loop.call_at(EventLoop::Clock::now(), Event::create([&]() {
+                        if (++processed == total)
+                            loop.stop();
+                    }));
+            });
+        loop.run_forever();
+        for (auto& producer : producers)
+            producer.join();
+        loop.close();
+        REQUIRE(processed == total);
+        return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    }
+
+}
+
+TEST_CASE("timer_wheel_expires_events_across_levels", "[p3]")
+{
+    auto const origin = TimerWheel::Clock::now();
+    TimerWheel wheel(origin);
+    std::vector<int> fired;
+    auto insert = [&](TimerWheel::Clock::duration delay, int id) {
+        wheel.insert(origin + delay, Event::create([&fired, id]() { fired.push_back(id); }).release());
+    };
+    //
+    // level 0, level 1, level 2 and the overflow list
+    insert(5ms, 1);
+    insert(70ms, 2);
+    insert(5s, 3);
+    insert(5h, 4);
+    REQUIRE(wheel.size() == 4);
+
+    expire(wheel, origin + 4ms);
+    REQUIRE(fired.empty());
+    REQUIRE(wheel.next_expiry().value() <= origin + 5ms);
+
+    expire(wheel, origin + 5ms);
+    REQUIRE(fired == std::vector<int> { 1 });
+
+    expire(wheel, origin + 69ms);
+    REQUIRE(fired.size() == 1);
+    expire(wheel, origin + 70ms);
+    REQUIRE(fired == std::vector<int> { 1, 2 });
+
+    //
+    // the wheel may wake up earlier for cascades, but never later
+    REQUIRE(wheel.next_expiry().value() <= origin + 5s);
+    expire(wheel, origin + 4999ms);
+    REQUIRE(fired.size() == 2);
+    expire(wheel, origin + 5s);
+    REQUIRE(fired == std::vector<int> { 1, 2, 3 });
+
+    expire(wheel, origin + 5h - 1ms);
+    REQUIRE(fired.size() == 3);
+    expire(wheel, origin + 5h);
+    REQUIRE(fired == std::vector<int> { 1, 2, 3, 4 });
+    REQUIRE(wheel.size() == 0);
+    REQUIRE(!wheel.next_expiry());
+}
+
+TEST_CASE("timer_wheel_expires_past_events_immediately", "[p3]")
+{
+    auto const origin = TimerWheel::Clock::now();
+    TimerWheel wheel(origin);
+    expire(wheel, origin + 1s);
+    int count = 0;
+    wheel.insert(origin, Event::create([&]() { ++count; }).release());
+    wheel.insert(origin + 500ms, Event::create([&]() { ++count; }).release());
+    REQUIRE(wheel.next_expiry().value() <= origin + 1s);
+    expire(wheel, origin + 1s);
+    REQUIRE(count == 2);
+}
+
+TEST_CASE("event_loop_runs_events_of_multiple_producers", "[p3]")
+{
+    post_from_threads(4, 1000);
+}
+
+TEST_CASE("event_loop_runs_events_in_order", "[p3]")
+{
+    EventLoop loop;
+    std::vector<int> order;
+    auto now = EventLoop::Clock::now();
+    loop.call_at(now + 20ms, Event::create([&]() { order.push_back(3); loop.stop(); }));
+    loop.call_at(now, Event::create([&]() { order.push_back(1); }));
+    loop.call_at(now, Event::create([&]() { order.push_back(2); }));
+    loop.run_forever();
+    REQUIRE(order == std::vector<int> { 1, 2, 3 });
+}
+
+TEST_CASE("benchmark_event_loop_throughput", "[.][benchmark]")
+{
+    std::size_t constexpr events = 1000000;
+    for (std::size_t threads : { 1, 2, 4, 8 }) {
+        auto seconds = post_from_threads(threads, events / threads);
+        std::cout << "threads=" << threads << ": "
+                  << std::size_t(double(events) / seconds) << " events/s" << std::endl;
+    }
+}
+
+}
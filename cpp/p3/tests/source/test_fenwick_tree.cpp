@@ -0,0 +1,33 @@
+#include <catch2/catch.hpp>
+
+#include <p3/FenwickTree.h>
+
+namespace p3::tests {
+
+TEST_CASE("fenwick_tree_computes_prefix_sums", "[p3]")
+{
+    FenwickTree<double> tree;
+    tree.assign({ 1., 2., 3., 4., 5. });
+    REQUIRE(tree.prefix(0) == 0.);
+    REQUIRE(tree.prefix(3) == 6.);
+    REQUIRE(tree.total() == 15.);
+    tree.set(1, 10.);
+    REQUIRE(tree.prefix(2) == 11.);
+    REQUIRE(tree.total() == 23.);
+}
+
+TEST_CASE("fenwick_tree_finds_item_containing_offset", "[p3]")
+{
+    FenwickTree<double> tree;
+    tree.assign({ 10., 0., 20., 30. });
+    REQUIRE(tree.find(0.) == 0);
+    REQUIRE(tree.find(9.5) == 0);
+    //
+    // items of zero height are skipped
+    REQUIRE(tree.find(10.) == 2);
+    REQUIRE(tree.find(29.) == 2);
+    REQUIRE(tree.find(30.) == 3);
+    REQUIRE(tree.find(60.) == 4);
+}
+
+}
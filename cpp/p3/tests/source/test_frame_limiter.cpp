@@ -0,0 +1,77 @@
+#include <catch2/catch.hpp>
+
+#include <p3/platform/FrameLimiter.h>
+
+namespace p3::tests {
+
+using namespace std::chrono_literals;
+
+TEST_CASE("frame_limiter_keeps_phase", "[p3]")
+{
+    FrameLimiter limiter;
+    limiter.set_frame_rate(100.);
+    REQUIRE(limiter.frame_rate().value() == Approx(100.));
+
+    FrameLimiter::TimePoint start {};
+    start += 1s;
+    limiter.start_frame(start);
+    REQUIRE(limiter.deadline() == start + 10ms);
+    //
+    // a frame starting late does not shift later deadlines
+    limiter.start_frame(start + 13ms);
+    REQUIRE(limiter.deadline() == start + 20ms);
+    //
+    // unless a whole frame was missed
+    limiter.start_frame(start + 45ms);
+    REQUIRE(limiter.deadline() == start + 55ms);
+}
+
+TEST_CASE("frame_limiter_without_rate_does_not_wait", "[p3]")
+{
+    FrameLimiter limiter;
+    limiter.start_frame();
+    REQUIRE(!limiter.frame_rate());
+    REQUIRE(limiter.deadline() <= FrameLimiter::Clock::now());
+    REQUIRE_THROWS(limiter.set_frame_rate(0.));
+}
+
+TEST_CASE("frame_limiter_waits_until_deadline", "[p3]")
+{
+    //
+    // simulated clock: sleeping overshoots by 500us, spinning takes 100us
+    struct {
+        FrameLimiter::TimePoint time {};
+        std::optional<FrameLimiter::TimePoint> slept_until;
+        int yields = 0;
+
+        FrameLimiter::TimePoint now() const { return time; }
+        void sleep_until(FrameLimiter::TimePoint time_point)
+        {
+            slept_until = time_point;
+            time = time_point + 500us;
+        }
+        void yield()
+        {
+            ++yields;
+            time += 100us;
+        }
+    } waiter;
+
+    auto const deadline = waiter.time + 5ms;
+    FrameLimiter::wait_until(deadline, waiter);
+    REQUIRE(waiter.slept_until == deadline - FrameLimiter::SpinThreshold);
+    REQUIRE(waiter.yields == 15);
+    REQUIRE(waiter.time == deadline);
+    //
+    // close deadlines are not slept for
+    waiter.slept_until.reset();
+    FrameLimiter::wait_until(waiter.time + 1ms, waiter);
+    REQUIRE(!waiter.slept_until);
+    //
+    // nor past ones
+    waiter.yields = 0;
+    FrameLimiter::wait_until(waiter.time - 1ms, waiter);
+    REQUIRE(waiter.yields == 0);
+}
+
+}
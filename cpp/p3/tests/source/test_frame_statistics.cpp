@@ -0,0 +1,56 @@
+#include <catch2/catch.hpp>
+
+#include <p3/platform/FrameStatistics.h>
+
+namespace p3::tests {
+
+using namespace std::chrono_literals;
+
+TEST_CASE("frame_statistics_computes_percentiles", "[p3]")
+{
+    FrameStatistics statistics(100);
+    for (int i = 1; i <= 100; ++i)
+        statistics.add_frame(std::chrono::milliseconds(i), std::nullopt, std::nullopt);
+    auto cpu = statistics.cpu();
+    REQUIRE(cpu.count == 100);
+    REQUIRE(cpu.p50 == 50ms);
+    REQUIRE(cpu.p95 == 95ms);
+    REQUIRE(cpu.p99 == 99ms);
+    REQUIRE(cpu.max == 100ms);
+    REQUIRE(statistics.gpu().count == 0);
+}
+
+TEST_CASE("frame_statistics_slides_window", "[p3]")
+{
+    FrameStatistics statistics(4);
+    for (auto time : { 200ms, 1ms, 2ms, 3ms, 4ms })
+        statistics.add_frame(time, std::nullopt, std::nullopt);
+    REQUIRE(statistics.frames() == 5);
+    REQUIRE(statistics.cpu().count == 4);
+    REQUIRE(statistics.cpu().max == 4ms);
+    statistics.set_window(2);
+    REQUIRE(statistics.cpu().count == 2);
+    REQUIRE(statistics.cpu().p50 == 3ms);
+    statistics.add_frame(1ms, std::nullopt, std::nullopt);
+    REQUIRE(statistics.cpu().max == 4ms);
+}
+
+TEST_CASE("frame_statistics_counts_late_frames", "[p3]")
+{
+    FrameStatistics statistics;
+    auto const period = FrameStatistics::Duration(16ms);
+    statistics.add_frame(1ms, 16ms, period);
+    statistics.add_frame(1ms, 20ms, period);
+    REQUIRE(statistics.late_frames() == 0);
+    statistics.add_frame(1ms, 33ms, period);
+    REQUIRE(statistics.late_frames() == 1);
+    REQUIRE(statistics.dropped_frames() == 1);
+    statistics.add_frame(1ms, 64ms, period);
+    REQUIRE(statistics.late_frames() == 2);
+    REQUIRE(statistics.dropped_frames() == 4);
+    statistics.reset();
+    REQUIRE(statistics.late_frames() == 0);
+    REQUIRE(statistics.frames() == 0);
+}
+
+}
@@ -0,0 +1,106 @@
+#include <catch2/catch.hpp>
+
+#include "headless.h"
+
+#include <p3/Layout.h>
+#include <p3/UserInterface.h>
+#include <p3/widgets/ListView.h>
+#include <p3/widgets/ScrollArea.h>
+#include <p3/widgets/spacer.h>
+
+#include <algorithm>
+#include <vector>
+
+namespace p3::tests {
+
+namespace {
+
+    struct Grid {
+        std::shared_ptr<ScrollArea> scroll_area = std::make_shared<ScrollArea>();
+        std::shared_ptr<ListView> list_view = std::make_shared<ListView>();
+        std::size_t bound = 0;
+
+        ///
+        /// a grid with a partial last row, followed by a spacer, hence
+        /// the scroll area can be scrolled past the end of the grid
+        Grid(Headless& headless, std::size_t items, std::size_t columns)
+        {
+            list_view->set_item_count(items);
+            list_view->set_columns(columns);
+            list_view->set_item_height(20 | px);
+            list_view->set_factory([]() { return std::make_shared<Spacer>(); });
+            list_view->set_bind([this](std::shared_ptr<Node>, std::size_t) { ++bound; });
+            auto spacer = std::make_shared<Spacer>();
+            spacer->set_height(LayoutLength { LengthPercentage { 2000 | px }, 0.f, 0.f });
+            auto layout = std::make_shared<Layout>();
+            layout->set_direction(Direction::Vertical);
+            layout->add(list_view);
+            layout->add(spacer);
+            scroll_area->set_content(layout);
+            headless.user_interface().set_content(scroll_area);
+        }
+    };
+
+}
+
+TEST_CASE("list_view_grid_scrolled_past_partial_last_row", "[p3]")
+{
+    Headless headless(320, 240);
+    Grid grid(headless, 95, 10);
+    headless.frame();
+    REQUIRE(grid.bound > 0);
+
+    grid.scroll_area->set_scroll_y(1000.f);
+    headless.frame();
+    headless.frame();
+    REQUIRE(grid.scroll_area->scroll_y() > 200.f);
+    //
+    // nothing is visible, the free widgets are trimmed
+    REQUIRE(grid.list_view->pool_size() <= 10);
+
+    grid.scroll_area->set_scroll_y(0.f);
+    headless.frame();
+    headless.frame();
+    REQUIRE(grid.list_view->pool_size() > 10);
+}
+
+TEST_CASE("list_view_releases_trimmed_widgets", "[p3]")
+{
+    Headless headless(320, 240);
+    Grid grid(headless, 95, 10);
+    std::vector<std::weak_ptr<Node>> created;
+    std::size_t released = 0;
+    grid.list_view->set_factory([&]() {
+        auto node = std::make_shared<Spacer>();
+        created.push_back(node);
+        return node;
+    });
+    grid.list_view->set_release([&](std::shared_ptr<Node>) { ++released; });
+    headless.frame();
+    auto const pooled = grid.list_view->pool_size();
+    REQUIRE(pooled > 10);
+
+    //
+    // nothing is visible, the pool keeps a row of free widgets
+    grid.list_view->set_item_count(0);
+    headless.frame();
+    headless.frame();
+    REQUIRE(grid.list_view->pool_size() == 10);
+    REQUIRE(released == pooled - 10);
+    REQUIRE(std::size_t(std::count_if(created.begin(), created.end(), [](auto& node) { return node.expired(); })) == released);
+}
+
+TEST_CASE("list_view_pool_is_capped", "[p3]")
+{
+    Headless headless(320, 240);
+    Grid grid(headless, 10000, 1);
+    for (int i = 0; i < 20; ++i) {
+        grid.scroll_area->set_scroll_y(float(i) * 97.f);
+        headless.frame();
+    }
+    //
+    // 240 / 20 visible rows, plus a partial one
+    REQUIRE(grid.list_view->pool_size() <= 2 * 13 + 1);
+}
+
+}
@@ -0,0 +1,140 @@
+#include <catch2/catch.hpp>
+
+#include <p3/Layout.h>
+#include <p3/Loader.h>
+#include <p3/Parser.h>
+#include <p3/Text.h>
+#include <p3/widgets/InputScalar.h>
+#include <p3/widgets/InputText.h>
+#include <p3/widgets/Slider.h>
+#include <p3/widgets/check_box.h>
+
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+
+namespace p3::tests {
+
+namespace {
+
+    auto const markup = R"(
+        <Layout direction="horizontal" spacing="2em" padding="1px 2rem" width="50% 1 0" class="toolbar">
+            <Button label="ok" visible="false"/>
+            <Text value="hello" color="#ff0000"/>
+        </Layout>)";
+
+}
+
+TEST_CASE("loader_instantiates_typed_attributes", "[p3]")
+{
+    Loader loader;
+    auto image = loader.compile(markup);
+    REQUIRE(Loader::valid(image.data(), image.size()));
+
+    auto root = std::dynamic_pointer_cast<Layout>(loader.instantiate(image.data(), image.size()));
+    REQUIRE(root);
+    REQUIRE(root->direction() == Direction::Horizontal);
+    REQUIRE(std::get<Em>(root->spacing().value()).value == 2.f);
+    REQUIRE(std::get<Px>(root->padding().value()[0]).value == 1.f);
+    REQUIRE(std::get<Rem>(root->padding().value()[1]).value == 2.f);
+    REQUIRE(std::get<Percentage>(std::get<0>(root->width()).value()).value == 50.f);
+    REQUIRE(std::get<1>(root->width()) == 1.f);
+    REQUIRE(root->class_name() == "toolbar");
+
+    REQUIRE(root->children().size() == 2);
+    REQUIRE(root->children()[0]->element_name() == "Button");
+    REQUIRE(root->children()[0]->label() == "ok");
+    REQUIRE(!root->children()[0]->visible());
+    auto text = std::dynamic_pointer_cast<Text>(root->children()[1]);
+    REQUIRE(text);
+    REQUIRE(text->value() == "hello");
+    REQUIRE(text->color() == Color(0xFF0000FFu));
+}
+
+TEST_CASE("loader_instantiates_widget_values", "[p3]")
+{
+    Loader loader;
+    auto root = loader.load(R"(
+        <Layout>
+            <CheckBox value="true"/>
+            <InputText value="abc" hint="name" multi_line="true"/>
+            <SliderS32 min="-5" max="5" value="3"/>
+            <InputFloat value="0.5" step="0.25" format="%.2f"/>
+        </Layout>)");
+    auto const& children = root->children();
+    REQUIRE(children.size() == 4);
+    REQUIRE(std::dynamic_pointer_cast<CheckBox>(children[0])->value());
+    auto input_text = std::dynamic_pointer_cast<InputText>(children[1]);
+    REQUIRE(input_text->value() == "abc");
+    REQUIRE(input_text->multi_line());
+    auto slider = std::dynamic_pointer_cast<Slider<std::int32_t>>(children[2]);
+    REQUIRE(slider->min() == -5);
+    REQUIRE(slider->value() == 3);
+    auto input = std::dynamic_pointer_cast<InputScalar<float>>(children[3]);
+    REQUIRE(input->value() == .5f);
+    REQUIRE(input->step() == .25f);
+    REQUIRE(input->format() == "%.2f");
+}
+
+TEST_CASE("loader_rejects_corrupt_images", "[p3]")
+{
+    Loader loader;
+    auto image = loader.compile(markup);
+    image.back() ^= 1;
+    REQUIRE(!Loader::valid(image.data(), image.size()));
+    REQUIRE_THROWS(loader.instantiate(image.data(), image.size()));
+    REQUIRE_THROWS(loader.instantiate(image.data(), 16));
+}
+
+TEST_CASE("loader_rejects_invalid_markup", "[p3]")
+{
+    Loader loader;
+    REQUIRE_THROWS(loader.compile("<Layout>"));
+    REQUIRE_THROWS(loader.compile("<Unknown/>"));
+    REQUIRE_THROWS(loader.compile(R"(<Layout direction="diagonal"/>)"));
+    REQUIRE_THROWS(loader.compile(R"(<Layout spacing="2 em px"/>)"));
+    REQUIRE_THROWS(loader.compile(R"(<SliderS32 value="1.5"/>)"));
+}
+
+TEST_CASE("loader_reports_all_invalid_values", "[p3]")
+{
+    Loader loader;
+    std::string message;
+    try {
+        loader.compile(R"(<Layout direction="diagonal" spacing="2em x"><Text color="nope"/></Layout>)");
+    } catch (parser::ParserError const& e) {
+        message = e.what();
+    }
+    REQUIRE(message == "invalid values: Layout.direction at offset 0, Layout.spacing at offset 4, Text.color at offset 0");
+}
+
+TEST_CASE("loader_rejects_unknown_attributes", "[p3]")
+{
+    Loader loader;
+    REQUIRE_THROWS_AS(loader.compile(R"(<Button colour="#ff0000"/>)"), parser::ParserError);
+    //
+    // typed attributes of other elements are unknown as well
+    REQUIRE_THROWS_AS(loader.compile(R"(<Button direction="vertical"/>)"), parser::ParserError);
+}
+
+TEST_CASE("loader_does_not_cache_failed_instantiation", "[p3]")
+{
+    auto const directory = std::filesystem::temp_directory_path();
+    auto const markup = directory / "p3_test_loader.xml";
+    auto const cache = directory / "p3_test_loader.p3ui";
+    std::filesystem::remove(cache);
+    std::ofstream(markup) << "<Layout><Broken/></Layout>";
+
+    Loader loader;
+    loader.add_element("Broken", []() -> std::shared_ptr<Node> { throw std::runtime_error("broken"); });
+    REQUIRE_THROWS(loader.load_cached(markup, cache));
+    REQUIRE(!std::filesystem::exists(cache));
+
+    loader.add_element("Broken", []() { return std::make_shared<Layout>(); });
+    REQUIRE(loader.load_cached(markup, cache));
+    REQUIRE(std::filesystem::exists(cache));
+    std::filesystem::remove(markup);
+    std::filesystem::remove(cache);
+}
+
+}
@@ -0,0 +1,106 @@
+#include <catch2/catch.hpp>
+
+#include <p3/Profiler.h>
+
+#include <atomic>
+#include <iostream>
+#include <thread>
+
+namespace p3::tests {
+
+namespace {
+
+    std::size_t occurrences(std::string const& text, std::string const& pattern)
+    {
+        std::size_t count = 0;
+        for (auto position = text.find(pattern); position != std::string::npos; position = text.find(pattern, position + 1))
+            ++count;
+        return count;
+    }
+
+}
+
+TEST_CASE("profiler_records_zones_of_all_threads", "[p3]")
+{
+    auto& profiler = Profiler::instance();
+    auto begin = Profiler::Clock::now();
+    profiler.record("before", begin, begin);
+
+    profiler.start();
+    REQUIRE(profiler.capturing());
+    auto now = Profiler::Clock::now();
+    profiler.record("main", now, now + std::chrono::microseconds(5));
+    std::thread([&]() {
+        auto now = Profiler::Clock::now();
+        profiler.record("worker \"1\"", now, now + std::chrono::microseconds(5));
+    }).join();
+    profiler.stop();
+    profiler.record("after", now, now);
+
+    auto trace = profiler.trace();
+    REQUIRE(trace.rfind("{\"traceEvents\":[", 0) == 0);
+    REQUIRE(occurrences(trace, "\"ph\":\"X\"") == 2);
+    REQUIRE(occurrences(trace, "\"name\":\"main\"") == 1);
+    REQUIRE(occurrences(trace, "\"name\":\"worker \\\"1\\\"\"") == 1);
+    REQUIRE(occurrences(trace, "before") == 0);
+    REQUIRE(occurrences(trace, "after") == 0);
+}
+
+TEST_CASE("profiler_keeps_latest_zones", "[p3]")
+{
+    auto& profiler = Profiler::instance();
+    profiler.start();
+    auto now = Profiler::Clock::now();
+    for (std::size_t i = 0; i < Profiler::Capacity + 10; ++i)
+        profiler.record("zone", now, now);
+    profiler.stop();
+    REQUIRE(occurrences(profiler.trace(), "\"ph\":\"X\"") == Profiler::Capacity);
+}
+
+TEST_CASE("profiler_restarts_while_threads_record", "[p3]")
+{
+    //
+    // a restart must not touch the buffers of recording threads
+    auto& profiler = Profiler::instance();
+    profiler.start();
+    std::atomic<bool> done { false };
+    std::thread worker([&]() {
+        while (!done) {
+            auto now = Profiler::Clock::now();
+            profiler.record("worker", now, now);
+        }
+    });
+    for (int i = 0; i < 100; ++i)
+        profiler.start();
+    done = true;
+    worker.join();
+    profiler.stop();
+    //
+    // buffers of threads which did not record since the restart are skipped
+    profiler.start();
+    auto now = Profiler::Clock::now();
+    profiler.record("main", now, now);
+    profiler.stop();
+    auto trace = profiler.trace();
+    REQUIRE(occurrences(trace, "\"ph\":\"X\"") == 1);
+    REQUIRE(occurrences(trace, "worker") == 0);
+}
+
+TEST_CASE("benchmark_profiler_zones", "[.][benchmark]")
+{
+    std::size_t constexpr zones = 10000000;
+    auto measure = [&]() {
+        auto start = std::chrono::steady_clock::now();
+        for (std::size_t i = 0; i < zones; ++i) {
+            Profiler::Scope scope("zone");
+        }
+        return std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / zones;
+    };
+    auto idle = measure();
+    Profiler::instance().start();
+    auto capturing = measure();
+    Profiler::instance().stop();
+    std::cout << "ns per zone: idle=" << idle << ", capturing=" << capturing << std::endl;
+}
+
+}
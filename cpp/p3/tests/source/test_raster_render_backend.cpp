@@ -0,0 +1,115 @@
+#include <catch2/catch.hpp>
+
+#include "headless.h"
+
+#include <p3/UserInterface.h>
+#include <p3/backend/RasterRenderBackend.h>
+#include <p3/widgets/Button.h>
+
+#include <imgui.h>
+
+#include <algorithm>
+#include <optional>
+#include <vector>
+
+namespace p3::tests {
+
+namespace {
+
+    ImDrawVert vertex(float x, float y)
+    {
+        return ImDrawVert { ImVec2(x, y), ImVec2(0.5f, 0.25f), IM_COL32(255, 0, 0, 128) };
+    }
+
+    struct Result : Promise<Pixels>::Implementation {
+        std::optional<Pixels> pixels;
+        std::exception_ptr error;
+
+        void set_value(Pixels value) override { pixels = std::move(value); }
+        void set_exception(std::exception_ptr e) override { error = std::move(e); }
+    };
+
+}
+
+TEST_CASE("raster_vertices_are_rebased_and_scaled", "[p3]")
+{
+    //
+    // the command references the last three of eight vertices
+    ImDrawList list(nullptr);
+    for (int i = 0; i < 8; ++i)
+        list.VtxBuffer.push_back(vertex(float(i), float(2 * i)));
+    for (int i : { 5, 6, 7, 7, 6, 5 })
+        list.IdxBuffer.push_back(ImDrawIdx(i));
+    ImDrawCmd command;
+    command.ElemCount = 6;
+    SkBitmap texture;
+    texture.allocN32Pixels(64, 32);
+
+    auto vertices = RasterRenderBackend::make_vertices(list, command, &texture, ImVec2(1.f, 2.f), ImVec2(2.f, 2.f));
+    REQUIRE(vertices->vertexCount() == 3);
+    REQUIRE(vertices->indexCount() == 6);
+    REQUIRE(std::vector<std::uint16_t>(vertices->indices(), vertices->indices() + 6) == std::vector<std::uint16_t> { 0, 1, 2, 2, 1, 0 });
+    REQUIRE(vertices->positions()[0] == SkPoint::Make(8.f, 16.f));
+    REQUIRE(vertices->positions()[2] == SkPoint::Make(12.f, 24.f));
+    REQUIRE(vertices->texCoords()[0] == SkPoint::Make(32.f, 8.f));
+    REQUIRE(vertices->colors()[0] == SkColorSetARGB(128, 255, 0, 0));
+}
+
+TEST_CASE("raster_vertices_of_large_ranges_are_expanded", "[p3]")
+{
+    //
+    // the range does not fit into 16 bit indices after rebasing
+    ImDrawList list(nullptr);
+    list.VtxBuffer.resize(0x10000);
+    for (int i = 0; i < list.VtxBuffer.Size; ++i)
+        list.VtxBuffer[i] = vertex(float(i), 0.f);
+    for (int i : { 0, 0xFFFF, 1 })
+        list.IdxBuffer.push_back(ImDrawIdx(i));
+    ImDrawCmd command;
+    command.ElemCount = 3;
+
+    auto vertices = RasterRenderBackend::make_vertices(list, command, nullptr, ImVec2(0.f, 0.f), ImVec2(1.f, 1.f));
+    REQUIRE(vertices->vertexCount() == 3);
+    REQUIRE(vertices->indexCount() == 0);
+    REQUIRE(vertices->positions()[1] == SkPoint::Make(float(0xFFFF), 0.f));
+    REQUIRE(vertices->positions()[2] == SkPoint::Make(1.f, 0.f));
+    REQUIRE(vertices->texCoords()[0] == SkPoint::Make(0.f, 0.f));
+}
+
+TEST_CASE("raster_tiles_match_single_threaded_rasterization", "[p3]")
+{
+    //
+    // the height is not a multiple of the tile height
+    auto render = [](std::size_t threads) {
+        Headless headless(300, 200, threads);
+        headless.user_interface().set_content(std::make_shared<Button>("button"));
+        headless.frame();
+        headless.frame();
+        std::vector<std::uint8_t> pixels(300 * 200 * 4);
+        headless.target().read_pixels(pixels.data(), false);
+        return pixels;
+    };
+    auto single = render(1);
+    REQUIRE(std::any_of(single.begin(), single.end(), [](auto value) { return value != 0; }));
+    REQUIRE(render(4) == single);
+}
+
+TEST_CASE("raster_captures_are_resolved_on_shutdown", "[p3]")
+{
+    Headless headless(64, 32);
+    auto captured = std::make_shared<Result>();
+    headless.render_backend().capture(&headless.target(), 64, 32, false,
+        RenderBackend::resolve(Promise<Pixels>(captured)));
+    headless.render_backend().shutdown();
+    REQUIRE(captured->pixels);
+    REQUIRE(captured->pixels->width == 64);
+    REQUIRE(captured->pixels->height == 32);
+    //
+    // failed or dropped captures deliver empty pixels
+    auto failed = std::make_shared<Result>();
+    RenderBackend::resolve(Promise<Pixels>(failed))(Pixels());
+    REQUIRE(!failed->pixels);
+    REQUIRE(failed->error);
+}
+
+}
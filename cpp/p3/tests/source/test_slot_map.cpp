@@ -0,0 +1,86 @@
+#include <catch2/catch.hpp>
+
+#include <p3/Node.h>
+#include <p3/SlotMap.h>
+
+#include <chrono>
+#include <iostream>
+
+namespace p3::tests {
+
+namespace {
+
+    class SlotMapTestNode : public Node {
+    public:
+        SlotMapTestNode()
+            : Node("SlotMapTestNode")
+        {
+        }
+    };
+
+}
+
+TEST_CASE("slot_map_resolves_added_values", "[p3]")
+{
+    int a = 1, b = 2;
+    SlotMap<int*> map;
+    auto id_a = map.add(&a);
+    auto id_b = map.add(&b);
+    REQUIRE(map.size() == 2);
+    REQUIRE(map.get(id_a) == &a);
+    REQUIRE(map.get(id_b) == &b);
+}
+
+TEST_CASE("slot_map_detects_stale_ids", "[p3]")
+{
+    int a = 1, b = 2;
+    SlotMap<int*> map;
+    auto id_a = map.add(&a);
+    REQUIRE(map.release(id_a));
+    REQUIRE(!map.contains(id_a));
+    REQUIRE(map.get(id_a) == nullptr);
+    REQUIRE(!map.release(id_a));
+    //
+    // slot is reused, but the generation differs
+    auto id_b = map.add(&b);
+    REQUIRE(SlotMap<int*>::index(id_a) == SlotMap<int*>::index(id_b));
+    REQUIRE(id_a != id_b);
+    REQUIRE(map.get(id_a) == nullptr);
+    REQUIRE(map.get(id_b) == &b);
+    REQUIRE(map.size() == 1);
+    REQUIRE(map.capacity() == 1);
+}
+
+TEST_CASE("node_ids_are_not_reused_after_destruction", "[p3]")
+{
+    auto count = Node::node_count();
+    std::uint64_t id;
+    {
+        SlotMapTestNode node;
+        id = node.imgui_id();
+        REQUIRE(Node::node_count() == count + 1);
+    }
+    REQUIRE(Node::node_count() == count);
+    SlotMapTestNode node;
+    REQUIRE(node.imgui_id() != id);
+}
+
+TEST_CASE("benchmark_node_create_destroy_1m", "[.][benchmark]")
+{
+    std::size_t constexpr cycles = 1000000;
+    auto start = std::chrono::steady_clock::now();
+    for (std::size_t i = 0; i < cycles; ++i)
+        auto node = std::make_shared<SlotMapTestNode>();
+    auto elapsed = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    std::cout << "node create/destroy: " << cycles << " cycles in " << elapsed << "ms" << std::endl;
+
+    SlotMap<void*> map;
+    start = std::chrono::steady_clock::now();
+    for (std::size_t i = 0; i < cycles; ++i)
+        map.release(map.add(&map));
+    elapsed = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    std::cout << "slot map add/release: " << cycles << " cycles in " << elapsed << "ms" << std::endl;
+    REQUIRE(map.size() == 0);
+}
+
+}
@@ -0,0 +1,169 @@
+#include <catch2/catch.hpp>
+
+#include "headless.h"
+
+#include <p3/Node.h>
+#include <p3/Parser.h>
+#include <p3/StyleSheet.h>
+#include <p3/UserInterface.h>
+
+#include <imgui.h>
+#include <imgui_internal.h>
+
+namespace p3::tests {
+
+namespace {
+
+    StyleBlock with_alpha(float alpha)
+    {
+        StyleBlock block;
+        block.alpha = alpha;
+        return block;
+    }
+
+    StyleBlock with_color(Color color)
+    {
+        StyleBlock block;
+        block.color = color;
+        return block;
+    }
+
+    Color const red(255, 0, 0, 255);
+    Color const green(0, 255, 0, 255);
+    Color const blue(0, 0, 255, 255);
+
+    //
+    // records the style in effect while it is measured
+    class Probe : public Node {
+    public:
+        Probe()
+            : Node("Probe")
+        {
+        }
+
+        void update_content() override
+        {
+            auto const& text = ImGui::GetStyle().Colors[ImGuiCol_Text];
+            color = Color(std::uint8_t(text.x * 255.f + .5f), std::uint8_t(text.y * 255.f + .5f),
+                std::uint8_t(text.z * 255.f + .5f), std::uint8_t(text.w * 255.f + .5f));
+            pushed_colors = GImGui->ColorStack.Size;
+        }
+
+        Color color;
+        int pushed_colors = 0;
+    };
+
+    struct Tree {
+        std::shared_ptr<Probe> parent = std::make_shared<Probe>();
+        std::shared_ptr<Probe> child = std::make_shared<Probe>();
+
+        Tree(Headless& headless, std::shared_ptr<StyleSheet> sheet)
+        {
+            parent->set_style_sheet(std::move(sheet));
+            parent->add(child);
+            headless.user_interface().set_content(parent);
+        }
+    };
+
+}
+
+TEST_CASE("style_sheet_matches_element_and_class", "[p3]")
+{
+    StyleSheet sheet({
+        { "Button", with_alpha(.1f) },
+        { ".primary", with_alpha(.2f) },
+        { "Text.primary", with_alpha(.3f) },
+    });
+    REQUIRE(sheet.match("Button", std::nullopt).alpha == .1f);
+    REQUIRE(sheet.match("Button", "primary").alpha == .2f);
+    REQUIRE(sheet.match("Text", "primary").alpha == .3f);
+    REQUIRE(!sheet.match("Text", std::nullopt).alpha);
+    REQUIRE(!sheet.match("Text", "secondary").alpha);
+}
+
+TEST_CASE("style_sheet_orders_rules_by_specificity", "[p3]")
+{
+    StyleBlock color;
+    color.color = Color(0xFF0000FFu);
+    StyleSheet sheet({
+        { "Button.primary", with_alpha(.3f) },
+        { ".primary", with_alpha(.2f) },
+        { "Button", with_alpha(.1f) },
+        { "*", color },
+        { "Button", with_alpha(.4f) },
+    });
+    //
+    // the class wins over the later element rules, equally
+    // specific rules are applied in order
+    REQUIRE(sheet.match("Button", "primary").alpha == .3f);
+    REQUIRE(sheet.match("Button", std::nullopt).alpha == .4f);
+    REQUIRE(sheet.match("Button", std::nullopt).color == Color(0xFF0000FFu));
+    REQUIRE(sheet.match("Text", "primary").alpha == .2f);
+}
+
+TEST_CASE("style_sheet_rejects_invalid_selectors", "[p3]")
+{
+    REQUIRE_THROWS(StyleSheet({ { "", StyleBlock() } }));
+    REQUIRE_THROWS(StyleSheet({ { "Button.", StyleBlock() } }));
+    REQUIRE_THROWS(StyleSheet({ { "Button .primary", StyleBlock() } }));
+    REQUIRE_THROWS(StyleSheet({ { ".a.b", StyleBlock() } }));
+    REQUIRE_NOTHROW(StyleSheet({ { "*.primary", StyleBlock() } }));
+}
+
+TEST_CASE("computed_style_pushes_only_changed_values", "[p3]")
+{
+    Headless headless(320, 240);
+    Tree tree(headless, std::make_shared<StyleSheet>(std::vector<StyleSheet::Rule> {
+                            { "Probe", with_color(red) },
+                        }));
+    headless.frame();
+    REQUIRE(tree.parent->color == red);
+    REQUIRE(tree.child->color == red);
+    //
+    // the child matches the same rule, the color is inherited
+    REQUIRE(tree.child->pushed_colors == tree.parent->pushed_colors);
+}
+
+TEST_CASE("computed_style_is_not_hidden_by_inline_color_of_parent", "[p3]")
+{
+    Headless headless(320, 240);
+    Tree tree(headless, std::make_shared<StyleSheet>(std::vector<StyleSheet::Rule> {
+                            { "Probe", with_color(red) },
+                        }));
+    tree.parent->set_color(green);
+    headless.frame();
+    REQUIRE(tree.parent->color == green);
+    REQUIRE(tree.child->color == red);
+    REQUIRE(tree.child->pushed_colors == tree.parent->pushed_colors + 1);
+    //
+    // the children follow changes of the inline color
+    tree.parent->set_color(std::nullopt);
+    headless.frame();
+    REQUIRE(tree.child->color == red);
+    REQUIRE(tree.child->pushed_colors == tree.parent->pushed_colors);
+}
+
+TEST_CASE("computed_style_is_invalidated_by_class_and_sheet", "[p3]")
+{
+    Headless headless(320, 240);
+    Tree tree(headless, std::make_shared<StyleSheet>(std::vector<StyleSheet::Rule> {
+                            { "Probe", with_color(red) },
+                            { ".blue", with_color(blue) },
+                        }));
+    headless.frame();
+    REQUIRE(tree.child->color == red);
+
+    tree.child->set_class_name("blue");
+    headless.frame();
+    REQUIRE(tree.parent->color == red);
+    REQUIRE(tree.child->color == blue);
+
+    tree.parent->set_style_sheet(std::make_shared<StyleSheet>(std::vector<StyleSheet::Rule> {
+        { "Probe", with_color(green) },
+    }));
+    headless.frame();
+    REQUIRE(tree.parent->color == green);
+    REQUIRE(tree.child->color == green);
+}
+
+}
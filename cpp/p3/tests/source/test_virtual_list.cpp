@@ -0,0 +1,191 @@
+#include <catch2/catch.hpp>
+
+#include "headless.h"
+
+#include <p3/UserInterface.h>
+#include <p3/widgets/ScrollArea.h>
+#include <p3/widgets/VirtualList.h>
+#include <p3/widgets/spacer.h>
+
+#include <vector>
+
+namespace p3::tests {
+
+namespace {
+
+    LayoutLength fixed(float pixels)
+    {
+        return LayoutLength { LengthPercentage { pixels | px }, 0.f, 0.f };
+    }
+
+    //
+    // counts the frames it was rendered in
+    class Item : public Spacer {
+    public:
+        void render_impl(Context& context, float width, float height) override
+        {
+            ++rendered;
+            Spacer::render_impl(context, width, height);
+        }
+
+        int rendered = 0;
+    };
+
+    struct Scrolled {
+        std::shared_ptr<ScrollArea> scroll_area = std::make_shared<ScrollArea>();
+        std::shared_ptr<VirtualList> list = std::make_shared<VirtualList>();
+        std::vector<std::shared_ptr<Item>> items;
+
+        ///
+        /// 1000 items of 10px in a 320x240 view
+        Scrolled(Headless& headless)
+        {
+            list->set_spacing(0 | px);
+            for (int i = 0; i < 1000; ++i) {
+                items.push_back(std::make_shared<Item>());
+                items.back()->set_height(fixed(10.f));
+                list->add(items.back());
+            }
+            scroll_area->set_content(list);
+            headless.user_interface().set_content(scroll_area);
+        }
+
+        /// true if exactly the items of the visible range were rendered
+        bool rendered_visible_range() const
+        {
+            auto const range = list->visible_range();
+            for (std::size_t i = 0; i < items.size(); ++i)
+                if ((items[i]->rendered != 0) != (i >= range[0] && i < range[1]))
+                    return false;
+            return true;
+        }
+
+        void reset()
+        {
+            for (auto& item : items)
+                item->rendered = 0;
+        }
+    };
+
+}
+
+TEST_CASE("virtual_list_updates_resized_children", "[p3]")
+{
+    Headless headless;
+    auto list = std::make_shared<VirtualList>();
+    list->set_spacing(0 | px);
+    std::vector<std::shared_ptr<Spacer>> items;
+    for (int i = 0; i < 100; ++i) {
+        items.push_back(std::make_shared<Spacer>());
+        items.back()->set_height(fixed(10.f));
+        list->add(items.back());
+    }
+    headless.user_interface().set_content(list);
+    headless.frame();
+    REQUIRE(list->contextual_minimum_content_height() == Approx(1000.f));
+
+    items[5]->set_height(fixed(30.f));
+    headless.frame();
+    REQUIRE(list->contextual_minimum_content_height() == Approx(1020.f));
+
+    items[7]->set_visible(false);
+    headless.frame();
+    REQUIRE(list->contextual_minimum_content_height() == Approx(1010.f));
+
+    items[7]->set_visible(true);
+    items[8]->set_height(fixed(20.f));
+    headless.frame();
+    REQUIRE(list->contextual_minimum_content_height() == Approx(1030.f));
+}
+
+TEST_CASE("virtual_list_rebuilds_on_removed_children", "[p3]")
+{
+    Headless headless;
+    auto list = std::make_shared<VirtualList>();
+    list->set_spacing(0 | px);
+    std::vector<std::shared_ptr<Spacer>> items;
+    for (int i = 0; i < 10; ++i) {
+        items.push_back(std::make_shared<Spacer>());
+        items.back()->set_height(fixed(float(i + 1)));
+        list->add(items.back());
+    }
+    headless.user_interface().set_content(list);
+    headless.frame();
+    REQUIRE(list->contextual_minimum_content_height() == Approx(55.f));
+
+    list->remove(items[9]);
+    items[0]->set_height(fixed(11.f));
+    headless.frame();
+    REQUIRE(list->contextual_minimum_content_height() == Approx(55.f));
+}
+
+TEST_CASE("virtual_list_visible_range_follows_scrolling", "[p3]")
+{
+    Headless headless(320, 240);
+    Scrolled scrolled(headless);
+    headless.frame();
+    auto range = scrolled.list->visible_range();
+    REQUIRE(range[0] == 0);
+    REQUIRE(range[1] > 10);
+    REQUIRE(range[1] <= 25);
+
+    scrolled.scroll_area->set_scroll_y(5000.f);
+    headless.frame();
+    headless.frame();
+    range = scrolled.list->visible_range();
+    REQUIRE(range[0] > 450);
+    REQUIRE(range[0] <= 500);
+    REQUIRE(range[1] - range[0] <= 25);
+}
+
+TEST_CASE("virtual_list_renders_only_visible_children", "[p3]")
+{
+    Headless headless(320, 240);
+    Scrolled scrolled(headless);
+    headless.frame();
+    scrolled.reset();
+    headless.frame();
+    REQUIRE(scrolled.rendered_visible_range());
+
+    scrolled.scroll_area->set_scroll_y(5000.f);
+    headless.frame();
+    scrolled.reset();
+    headless.frame();
+    REQUIRE(scrolled.list->visible_range()[0] > 0);
+    REQUIRE(scrolled.rendered_visible_range());
+}
+
+TEST_CASE("virtual_list_renders_absolute_children", "[p3]")
+{
+    Headless headless(320, 240);
+    Scrolled scrolled(headless);
+    headless.frame();
+    //
+    // far outside of the visible range
+    scrolled.items[900]->set_position(Position::Absolute);
+    headless.frame();
+    scrolled.reset();
+    headless.frame();
+    REQUIRE(scrolled.items[900]->rendered == 1);
+    REQUIRE(scrolled.list->contextual_minimum_content_height() == Approx(9990.f));
+
+    scrolled.items[900]->set_position(Position::Static);
+    headless.frame();
+    scrolled.reset();
+    headless.frame();
+    REQUIRE(scrolled.rendered_visible_range());
+    REQUIRE(scrolled.list->contextual_minimum_content_height() == Approx(10000.f));
+}
+
+TEST_CASE("virtual_list_rebuilds_if_most_children_resized", "[p3]")
+{
+    Headless headless(320, 240);
+    Scrolled scrolled(headless);
+    headless.frame();
+    for (auto& item : scrolled.items)
+        item->set_height(fixed(20.f));
+    headless.frame();
+    REQUIRE(scrolled.list->contextual_minimum_content_height() == Approx(20000.f));
+}
+
+}
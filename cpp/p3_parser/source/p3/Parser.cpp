@@ -1,48 +1,199 @@
 #include "Parser.h"
 
-#include <cctype>
-#include <regex>
+#include <array>
+#include <charconv>
+#include <cstdint>
+#include <cstring>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define P3_PARSER_SSE2
+#include <emmintrin.h>
+#endif
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
 
 namespace p3::parser
 {
 
+    namespace
+    {
+
+        //
+        // character classes, the tokenizers are called per attribute and
+        // per style value, std::isspace and friends are locale aware
+        enum CharClass : std::uint8_t
+        {
+            Space = 1,
+            Digit = 2,
+            HexDigit = 4,
+            Alpha = 8
+        };
+
+        constexpr std::array<std::uint8_t, 256> char_classes = []() {
+            std::array<std::uint8_t, 256> classes{};
+            for (int c = '\t'; c <= '\r'; ++c)
+                classes[c] |= Space;
+            classes[' '] |= Space;
+            for (int c = '0'; c <= '9'; ++c)
+                classes[c] |= Digit | HexDigit;
+            for (int c = 'a'; c <= 'z'; ++c)
+                classes[c] |= Alpha | (c <= 'f' ? HexDigit : 0);
+            for (int c = 'A'; c <= 'Z'; ++c)
+                classes[c] |= Alpha | (c <= 'F' ? HexDigit : 0);
+            return classes;
+        }();
+
+        inline bool is(char c, CharClass char_class)
+        {
+            return (char_classes[static_cast<unsigned char>(c)] & char_class) != 0;
+        }
+
+        inline pos skip_digits(pos it)
+        {
+            while (is(*it, Digit))
+                ++it;
+            return it;
+        }
+
+#if defined(P3_PARSER_SSE2)
+        inline unsigned count_trailing_zeros(unsigned mask)
+        {
+#if defined(_MSC_VER)
+            unsigned long index;
+            _BitScanForward(&index, mask);
+            return index;
+#else
+            return unsigned(__builtin_ctz(mask));
+#endif
+        }
+
+        //
+        // one bit per byte which is not whitespace, all 16 bytes have to be
+        // within the input
+        inline unsigned non_space_mask(pos block)
+        {
+            auto const bytes = _mm_loadu_si128(reinterpret_cast<__m128i const*>(block));
+            auto const control = _mm_sub_epi8(bytes, _mm_set1_epi8('\t'));
+            auto const is_control = _mm_cmpeq_epi8(_mm_min_epu8(control, _mm_set1_epi8('\r' - '\t')), control);
+            auto const is_blank = _mm_cmpeq_epi8(bytes, _mm_set1_epi8(' '));
+            return ~unsigned(_mm_movemask_epi8(_mm_or_si128(is_control, is_blank))) & 0xFFFFu;
+        }
+#endif
+
+        //
+        // end of the input marked by InputScope, nullptr if unknown
+        thread_local pos input_end = nullptr;
+
+        pos skip_space(pos it)
+        {
+            //
+            // most values are separated by a single space or none at all
+            if (!is(*it, Space))
+                return it;
+            if (!is(*++it, Space))
+                return it;
+#if defined(P3_PARSER_SSE2)
+            if (auto const end = input_end; end && end > it)
+                while (end - it >= 16)
+                {
+                    if (auto const mask = non_space_mask(it))
+                        return it + count_trailing_zeros(mask);
+                    it += 16;
+                }
+#endif
+            //
+            // the tail, shorter than a block
+            while (is(*it, Space))
+                ++it;
+            return it;
+        }
+
+        //
+        // the digits are validated by the tokenizer, up to 8 of them are
+        // decoded at once in a 64 bit word. the word is assembled with shifts,
+        // the first character is its lowest byte on any byte order
+        std::uint32_t decode_hex(pos begin, pos end)
+        {
+            auto const padding = 8 - int(end - begin);
+            std::uint64_t word = 0;
+            for (int i = 0; i < 8; ++i)
+            {
+                auto const digit = i < padding ? '0' : begin[i - padding];
+                word |= std::uint64_t(static_cast<unsigned char>(digit)) << (8 * i);
+            }
+            //
+            // '0'-'9' keep their low nibble, letters have bit 6 set and get 9 added
+            auto const nibbles = (word & 0x0F0F0F0F0F0F0F0Full) + ((word >> 6) & 0x0101010101010101ull) * 9;
+            //
+            // pairs of nibbles into bytes, the first character is the lowest byte
+            auto const bytes = ((nibbles & 0x000F000F000F000Full) << 4) | ((nibbles >> 8) & 0x000F000F000F000Full);
+            return std::uint32_t((bytes & 0xFF) << 24 | ((bytes >> 16) & 0xFF) << 16 | ((bytes >> 32) & 0xFF) << 8 | ((bytes >> 48) & 0xFF));
+        }
+
+        //
+        // the range was matched by tokenizer::floating_point, which accepts a
+        // leading plus unlike std::from_chars. false if the value is out of range
+        bool to_float(pos begin, pos end, float& value)
+        {
+            if (*begin == '+')
+                ++begin;
+            auto const [it, error] = std::from_chars(begin, end, value);
+            return error == std::errc() && it == end;
+        }
+
+    }
+
     namespace tokenizer
     {
 
         pos name(pos input)
         {
             const char* ptr = input;
-            while (std::isalpha(static_cast<unsigned char>(*ptr)))
+            while (is(*ptr, Alpha))
                 ++ptr;
             if (ptr == input)
                 return input;
-            while (*ptr == '_' || std::isalpha(static_cast<unsigned char>(*ptr)))
+            while (*ptr == '_' || is(*ptr, Alpha))
                 ++ptr;
             return ptr;
         }
 
-        namespace expression
-        {
-            std::regex floating_point(R"(^[-+]?([0-9]+(\.[0-9]*)?|\.[0-9]+)([eE][-+]?[0-9]+)?)");
-        }
+        //
+        // [-+]?([0-9]+(\.[0-9]*)?|\.[0-9]+)([eE][-+]?[0-9]+)?
         pos floating_point(pos input)
         {
-            std::cmatch match;
-            if (std::regex_search(input, match, expression::floating_point))
-                return match[0].second;
-            return input;
+            auto it = input;
+            if (*it == '-' || *it == '+')
+                ++it;
+            if (is(*it, Digit))
+            {
+                it = skip_digits(it);
+                if (*it == '.')
+                    it = skip_digits(it + 1);
+            }
+            else if (*it == '.' && is(it[1], Digit))
+                it = skip_digits(it + 1);
+            else
+                return input;
+            if (*it == 'e' || *it == 'E')
+            {
+                auto exponent = it + 1;
+                if (*exponent == '-' || *exponent == '+')
+                    ++exponent;
+                if (is(*exponent, Digit))
+                    it = skip_digits(exponent);
+            }
+            return it;
         }
 
-        namespace expression
-        {
-            std::regex comment(R"(\/\*([^*]|[\r\n]|(\*+([^*\/]|[\r\n])))*\*+\/)");
-        }
         pos comment(pos input)
         {
-            std::cmatch match;
-            if (std::regex_search(input, match, expression::comment))
-                return match[0].second;
-            return input;
+            if (input[0] != '/' || input[1] != '*')
+                return input;
+            auto end = std::strstr(input + 2, "*/");
+            return end ? end + 2 : input;
         }
 
         pos hex_color(pos pos)
@@ -50,30 +201,17 @@ namespace p3::parser
             if (*pos != '#')
                 return pos;
             auto it = pos + 1;
-            if (!std::isxdigit(*it))
-                return pos;
-            ++it;
-            if (!std::isxdigit(*it))
-                return pos;
-            ++it;
-            if (!std::isxdigit(*it))
-                return pos;
-            ++it;
-            if (!std::isxdigit(*it))
-                return it;
-            ++it;
-            if (!std::isxdigit(*it))
-                return pos;
-            ++it;
-            if (!std::isxdigit(*it))
-                return pos;
-            ++it;
-            if (!std::isxdigit(*it))
+            while (it - pos <= 8 && is(*it, HexDigit))
+                ++it;
+            switch (it - pos - 1)
+            {
+            case 3:
+            case 6:
+            case 8:
                 return it;
-            ++it;
-            if (!std::isxdigit(*it))
+            default:
                 return pos;
-            return ++it;
+            }
         }
 
         pos px(pos begin)
@@ -98,13 +236,27 @@ namespace p3::parser
 
     } // tokenizer
 
+    InputScope::InputScope(pos begin)
+        : _enclosing(input_end)
+    {
+        input_end = begin + std::strlen(begin);
+    }
+
+    InputScope::~InputScope()
+    {
+        input_end = _enclosing;
+    }
+
     pos skip_whitespace(pos it)
     {
         while (true)
-            if (std::isspace(static_cast<unsigned char>(*it)))
-                ++it;
-            else if (auto temp = tokenizer::comment(it); temp != it)
-                it = temp;
+            if (it = skip_space(it); it[0] == '/' && it[1] == '*')
+            {
+                if (auto temp = tokenizer::comment(it); temp != it)
+                    it = temp;
+                else
+                    break;
+            }
             else
                 break;
         return it;
@@ -114,11 +266,8 @@ namespace p3::parser
     {
         auto it = skip_whitespace(begin);
         float value;
-        if (auto temp = tokenizer::floating_point(it); it != temp)
-        {
-            value = std::stof(std::string(it, temp));
+        if (auto temp = tokenizer::floating_point(it); it != temp && to_float(it, temp, value))
             it = temp;
-        }
         else
             return begin;
         if (auto temp = tokenizer::px(it); it != temp)
@@ -142,11 +291,8 @@ namespace p3::parser
     pos Rule<Percentage, void>::parse(pos begin, Percentage& percentage)
     {
         auto it = skip_whitespace(begin);
-        if (auto temp = tokenizer::floating_point(it); it != temp)
-        {
-            percentage.value = std::stof(std::string(it, temp));
+        if (auto temp = tokenizer::floating_point(it); it != temp && to_float(it, temp, percentage.value))
             it = temp;
-        }
         else
             return begin;
         return *it == '%' ? it + 1 : begin;
@@ -155,11 +301,8 @@ namespace p3::parser
     pos Rule<float, void>::parse(pos begin, float& value)
     {
         auto it = skip_whitespace(begin);
-        if (auto temp = tokenizer::floating_point(it); temp != it)
-        {
-            value = std::stof(std::string(it, temp));
+        if (auto temp = tokenizer::floating_point(it); temp != it && to_float(it, temp, value))
             return temp;
-        }
         return begin;
     }
 
@@ -185,7 +328,7 @@ namespace p3::parser
         auto it = skip_whitespace(begin);
         if (auto temp = tokenizer::hex_color(it); it != temp)
         {
-            color.value = std::stoi(std::string(it + 1, temp), 0, 16);
+            color.value = decode_hex(it + 1, temp);
             return temp;
         }
         return begin;
@@ -222,7 +365,7 @@ namespace p3::parser
         if (auto temp = parser::parse<float>(it, std::get<2>(fd)); it == temp)
             return begin;
         else
-            return it;
+            return temp;
     }
 
 }
@@ -1,14 +1,17 @@
 #pragma once
 
+#include "StaticMap.h"
 #include "Types.h"
 
+#include <cstddef>
 #include <stdexcept>
-#include <unordered_map>
+#include <string>
+#include <string_view>
 
 namespace p3::parser
 {
 
-    class ParserError : std::runtime_error
+    class ParserError : public std::runtime_error
     {
     public:
         ParserError(std::string const& what) : std::runtime_error(what) {}
@@ -31,38 +34,59 @@ namespace p3::parser
 
     }
 
+    //
+    // keywords of the enums, perfect hash tables built at compile time
     template<typename E>
-    std::unordered_map<std::string, E> enum_table;
+    struct EnumTable;
 
-    template<typename T, typename = void >
-    struct Rule { static pos parse(pos, T&); };
-
-    template<> inline static auto enum_table<Cascade> = std::unordered_map<std::string, Cascade>{
-        {"inherit", Cascade::inherit},
-        {"initial", Cascade::initial}
+    template<>
+    struct EnumTable<Cascade>
+    {
+        static constexpr auto table = make_static_map<Cascade>({
+            {"inherit", Cascade::inherit},
+            {"initial", Cascade::initial}
+        });
     };
 
-    template<> inline static auto enum_table<Direction> = std::unordered_map<std::string, Direction>{
-        {"horizontal", Direction::Horizontal},
-        {"vertical", Direction::Vertical}
+    template<>
+    struct EnumTable<Direction>
+    {
+        static constexpr auto table = make_static_map<Direction>({
+            {"horizontal", Direction::Horizontal},
+            {"vertical", Direction::Vertical}
+        });
     };
 
-    template<> inline static auto enum_table<Alignment> = std::unordered_map<std::string, Alignment>{
-        {"start", Alignment::Start},
-        {"center", Alignment::Center},
-        {"end", Alignment::End},
-        {"stretch", Alignment::Stretch},
-        {"baseline", Alignment::Baseline}
+    template<>
+    struct EnumTable<Alignment>
+    {
+        static constexpr auto table = make_static_map<Alignment>({
+            {"start", Alignment::Start},
+            {"center", Alignment::Center},
+            {"end", Alignment::End},
+            {"stretch", Alignment::Stretch},
+            {"baseline", Alignment::Baseline}
+        });
     };
 
-    template<> inline static auto enum_table<Justification> = std::unordered_map<std::string, Justification>{
-        {"space_between", Justification::SpaceBetween},
-        {"space_around", Justification::SpaceAround},
-        {"start", Justification::Start},
-        {"center", Justification::Center},
-        {"end", Justification::End}
+    template<>
+    struct EnumTable<Justification>
+    {
+        static constexpr auto table = make_static_map<Justification>({
+            {"space_between", Justification::SpaceBetween},
+            {"space_around", Justification::SpaceAround},
+            {"start", Justification::Start},
+            {"center", Justification::Center},
+            {"end", Justification::End}
+        });
     };
 
+    template<typename E>
+    inline constexpr auto const& enum_table = EnumTable<E>::table;
+
+    template<typename T, typename = void >
+    struct Rule { static pos parse(pos, T&); };
+
     pos skip_whitespace(pos);
 
     template<typename T>
@@ -71,13 +95,54 @@ namespace p3::parser
         return Rule<T>::parse(begin, t);
     }
 
+    //
+    // marks the extent of a null terminated input for the duration of a
+    // parse. skipping whitespace uses vector loads only within the marked
+    // input, without it whitespace is skipped byte by byte
+    class InputScope
+    {
+    public:
+        explicit InputScope(pos begin);
+        ~InputScope();
+
+        InputScope(InputScope const&) = delete;
+        InputScope& operator=(InputScope const&) = delete;
+
+    private:
+        pos _enclosing;
+    };
+
+    //
+    // outcome of parsing a whole value without exceptions, e.g. for the
+    // loader compiling many attributes. offset is the position of the first
+    // character which could not be consumed, or the end of the input
+    struct ParseResult
+    {
+        bool ok;
+        std::size_t offset;
+
+        explicit operator bool() const { return ok; }
+    };
+
+    template<typename T>
+    ParseResult try_parse(pos begin, T& value)
+    {
+        InputScope scope(begin);
+        auto it = parse(begin, value);
+        if (it == begin)
+            return ParseResult{ false, std::size_t(skip_whitespace(begin) - begin) };
+        it = skip_whitespace(it);
+        return ParseResult{ *it == '\0', std::size_t(it - begin) };
+    }
+
     template<typename T>
     T parse(pos begin)
     {
+        InputScope scope(begin);
         T value;
         auto it = parse(begin, value);
         if (it == begin)
-            throw ParserError("todo: include line/char info");
+            throw ParserError("invalid value at offset " + std::to_string(skip_whitespace(begin) - begin));
         return value;
     }
 
@@ -89,8 +154,13 @@ namespace p3::parser
             auto it = skip_whitespace(begin);
             if (auto temp = tokenizer::name(it); temp != it)
             {
-                t = enum_table<T>[std::string(it, temp)];
-                return temp;
+                //
+                // unknown keywords are not consumed
+                if (auto value = enum_table<T>.find(std::string_view(it, std::size_t(temp - it))))
+                {
+                    t = *value;
+                    return temp;
+                }
             }
             return begin;
         }
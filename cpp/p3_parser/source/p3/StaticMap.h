@@ -0,0 +1,126 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <string_view>
+
+namespace p3 {
+
+template <typename T>
+struct StaticMapEntry {
+    std::string_view key;
+    T value;
+};
+
+/*
+ * immutable map of string keys, built at compile time with a perfect hash:
+ * the seed is searched such that every key lands in its own slot, hence a
+ * lookup hashes the key once and compares a single entry. keys are
+ * string_views, lookups don't allocate.
+ *
+ *     constexpr auto table = make_static_map<int>({ { "a", 1 }, { "b", 2 } });
+ *     if (auto value = table.find(key)) ...
+ */
+template <typename T, std::size_t N>
+class StaticMap {
+public:
+    using Entry = StaticMapEntry<T>;
+
+    //
+    // at least four slots per key, such that a seed is found quickly
+    static constexpr std::size_t SlotCount = [] {
+        std::size_t count = 1;
+        while (count < 4 * N)
+            count *= 2;
+        return count;
+    }();
+
+    constexpr explicit StaticMap(std::array<Entry, N> const& entries)
+        : _entries(entries)
+        , _seed(find_seed(entries))
+        , _slots(make_slots(entries, _seed))
+    {
+    }
+
+    constexpr T const* find(std::string_view key) const
+    {
+        auto const slot = _slots[hash(key, _seed) & (SlotCount - 1)];
+        if (slot == Empty || _entries[slot].key != key)
+            return nullptr;
+        return &_entries[slot].value;
+    }
+
+    constexpr bool contains(std::string_view key) const
+    {
+        return find(key) != nullptr;
+    }
+
+    constexpr std::size_t size() const { return N; }
+    constexpr Entry const* begin() const { return _entries.data(); }
+    constexpr Entry const* end() const { return _entries.data() + N; }
+
+    static constexpr std::uint32_t hash(std::string_view key, std::uint32_t seed)
+    {
+        //
+        // seeded fnv-1a
+        std::uint32_t hash = 2166136261u ^ seed;
+        for (auto c : key)
+            hash = (hash ^ static_cast<unsigned char>(c)) * 16777619u;
+        return hash ^ (hash >> 15);
+    }
+
+private:
+    static constexpr std::uint16_t Empty = 0xFFFF;
+    static_assert(N < Empty, "too many keys");
+
+    using Slots = std::array<std::uint16_t, SlotCount>;
+
+    /// false if two keys share a slot
+    static constexpr bool try_slots(std::array<Entry, N> const& entries, std::uint32_t seed, Slots& slots)
+    {
+        for (auto& slot : slots)
+            slot = Empty;
+        for (std::size_t i = 0; i < N; ++i) {
+            auto& slot = slots[hash(entries[i].key, seed) & (SlotCount - 1)];
+            if (slot != Empty)
+                return false;
+            slot = static_cast<std::uint16_t>(i);
+        }
+        return true;
+    }
+
+    static constexpr std::uint32_t find_seed(std::array<Entry, N> const& entries)
+    {
+        Slots slots {};
+        for (std::uint32_t seed = 0; seed < 0x10000; ++seed)
+            if (try_slots(entries, seed, slots))
+                return seed;
+        //
+        // duplicate keys, evaluated at compile time this fails the build
+        throw std::logic_error("no perfect hash found");
+    }
+
+    static constexpr Slots make_slots(std::array<Entry, N> const& entries, std::uint32_t seed)
+    {
+        Slots slots {};
+        try_slots(entries, seed, slots);
+        return slots;
+    }
+
+    std::array<Entry, N> _entries;
+    std::uint32_t _seed;
+    Slots _slots;
+};
+
+template <typename T, std::size_t N>
+constexpr StaticMap<T, N> make_static_map(StaticMapEntry<T> const (&entries)[N])
+{
+    std::array<StaticMapEntry<T>, N> array {};
+    for (std::size_t i = 0; i < N; ++i)
+        array[i] = entries[i];
+    return StaticMap<T, N>(array);
+}
+
+}
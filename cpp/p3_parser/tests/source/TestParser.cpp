@@ -163,4 +163,40 @@ namespace p3::parser::tests
         }
     }
 
+    TEST_CASE("parse_color_decodes_8_digits")
+    {
+        std::string data("#fF00a180");
+        auto input = data.c_str();
+        Color color;
+        REQUIRE(parse(input, color) != input);
+        REQUIRE(color.value == 0xFF00A180u);
+    }
+
+    TEST_CASE("parse_float_fails_out_of_range")
+    {
+        std::string data("1e99");
+        auto input = data.c_str();
+        float value;
+        REQUIRE(parse(input, value) == input);
+    }
+
+    TEST_CASE("try_parse_consumes_flexible_length")
+    {
+        LayoutLength flexible_length;
+        auto result = try_parse(" 33% 1 0 ", flexible_length);
+        REQUIRE(result);
+        REQUIRE(result.offset == 9);
+    }
+
+    TEST_CASE("try_parse_reports_position")
+    {
+        LayoutLength flexible_length;
+        auto result = try_parse("1px 2 3 x", flexible_length);
+        REQUIRE(!result);
+        REQUIRE(result.offset == 8);
+        result = try_parse("  x", flexible_length);
+        REQUIRE(!result);
+        REQUIRE(result.offset == 2);
+    }
+
 }
@@ -0,0 +1,42 @@
+#include <catch2/catch.hpp>
+
+#include <p3/Parser.h>
+#include <p3/StaticMap.h>
+
+namespace p3::parser::tests
+{
+
+    TEST_CASE("static_map_finds_every_key")
+    {
+        constexpr auto table = make_static_map<int>({
+            {"label", 0}, {"width", 1}, {"height", 2}, {"class", 3},
+            {"visible", 4}, {"disabled", 5}, {"color", 6}, {"Layout.spacing", 7}
+        });
+        static_assert(*table.find("Layout.spacing") == 7);
+        for (auto const& entry : table)
+        {
+            REQUIRE(table.find(entry.key) != nullptr);
+            REQUIRE(*table.find(entry.key) == entry.value);
+        }
+        REQUIRE(table.size() == 8);
+    }
+
+    TEST_CASE("static_map_rejects_unknown_keys")
+    {
+        constexpr auto table = make_static_map<int>({{"start", 0}, {"end", 1}});
+        REQUIRE(!table.contains(""));
+        REQUIRE(!table.contains("star"));
+        REQUIRE(!table.contains("starts"));
+        REQUIRE(!table.contains("End"));
+    }
+
+    TEST_CASE("parse_enum_does_not_consume_unknown_keywords")
+    {
+        std::string data("diagonal");
+        auto input = data.c_str();
+        Direction direction;
+        REQUIRE(parse(input, direction) == input);
+        static_assert(*enum_table<Justification>.find("space_around") == Justification::SpaceAround);
+    }
+
+}
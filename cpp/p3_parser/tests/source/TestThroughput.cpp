@@ -0,0 +1,107 @@
+#include <catch2/catch.hpp>
+
+#include <p3/Parser.h>
+
+#include <chrono>
+#include <random>
+#include <sstream>
+#include <string>
+
+namespace p3::parser::tests
+{
+
+    //
+    // hidden, run with: p3_parser_tests [throughput]
+    // the inputs are a few megabytes of values as they appear in style
+    // sheets, separated by indentation, newlines and comments
+
+    namespace
+    {
+
+        std::size_t constexpr Size = 4 << 20;
+
+        template<typename Make>
+        std::string make_input(Make make)
+        {
+            std::mt19937 random(42);
+            std::ostringstream stream;
+            std::size_t count = 0;
+            while (stream.tellp() < std::streamoff(Size))
+            {
+                stream << "\n        " << make(random);
+                if (++count % 16 == 0)
+                    stream << " /* comment */";
+            }
+            return stream.str();
+        }
+
+        template<typename T>
+        void measure(std::string const& name, std::string const& input)
+        {
+            std::size_t values = 0;
+            auto const start = std::chrono::steady_clock::now();
+            auto it = input.c_str();
+            InputScope scope(it);
+            while (true)
+            {
+                T value;
+                auto temp = parse(it, value);
+                if (temp == it)
+                    break;
+                it = temp;
+                ++values;
+            }
+            auto const seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+            REQUIRE(*skip_whitespace(it) == '\0');
+            WARN(name << ": " << values << " values, " << input.size() / seconds / (1 << 20) << " MiB/s");
+        }
+
+    }
+
+    TEST_CASE("throughput_layout_length", "[.][throughput]")
+    {
+        static char const* units[] = { "px", "em", "rem", "%" };
+        auto const input = make_input([](std::mt19937& random) {
+            std::uniform_real_distribution<float> value(0.f, 100.f);
+            std::ostringstream stream;
+            if (random() % 8 == 0)
+                stream << "auto";
+            else
+                stream << value(random) << units[random() % 4];
+            stream << ' ' << random() % 2 << ' ' << random() % 2;
+            return stream.str();
+        });
+        measure<LayoutLength>("layout_length", input);
+    }
+
+    TEST_CASE("throughput_color", "[.][throughput]")
+    {
+        auto const input = make_input([](std::mt19937& random) {
+            std::ostringstream stream;
+            stream << '#' << std::hex << (random() | 0x10000000u);
+            return stream.str();
+        });
+        measure<Color>("color", input);
+    }
+
+    TEST_CASE("throughput_float", "[.][throughput]")
+    {
+        auto const input = make_input([](std::mt19937& random) {
+            std::uniform_real_distribution<double> value(-1000., 1000.);
+            std::ostringstream stream;
+            stream << value(random);
+            return stream.str();
+        });
+        measure<float>("float", input);
+    }
+
+    TEST_CASE("throughput_alignment", "[.][throughput]")
+    {
+        static char const* names[] = { "start", "center", "end", "stretch", "baseline" };
+        auto const input = make_input([](std::mt19937& random) {
+            return std::string(names[random() % 5]);
+        });
+        measure<Alignment>("alignment", input);
+    }
+
+}
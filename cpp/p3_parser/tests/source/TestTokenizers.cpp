@@ -2,6 +2,9 @@
 
 #include <p3/Parser.h>
 
+#include <cstring>
+#include <memory>
+
 namespace p3::parser::tests
 {
 
@@ -173,4 +176,41 @@ namespace p3::parser::tests
         REQUIRE(std::string(input, tokenizer::hex_color(input)) != data);
     }
 
+    TEST_CASE("comment_only_at_position")
+    {
+        std::string data(R"(10px /* comment */)");
+        auto input = data.c_str();
+        REQUIRE(tokenizer::comment(input) == input);
+        REQUIRE(skip_whitespace(input) == input);
+    }
+
+    TEST_CASE("skip_whitespace_skips_long_runs")
+    {
+        //
+        // every alignment of the vectorized scan, with and without a marked input
+        std::string data(std::string(40, ' ') + "\t\n\r\v\f/* a */  \n x");
+        for (std::size_t i = 0; i < 40; ++i)
+        {
+            auto input = data.c_str() + i;
+            REQUIRE(*skip_whitespace(input) == 'x');
+            InputScope scope(input);
+            REQUIRE(*skip_whitespace(input) == 'x');
+        }
+    }
+
+    TEST_CASE("skip_whitespace_stays_within_input")
+    {
+        //
+        // runs up to the end of an exactly sized buffer, the blocks end
+        // at every offset from the terminating null
+        for (std::size_t size = 2; size < 40; ++size)
+        {
+            auto buffer = std::make_unique<char[]>(size + 1);
+            std::memset(buffer.get(), ' ', size);
+            buffer[size] = '\0';
+            InputScope scope(buffer.get());
+            REQUIRE(skip_whitespace(buffer.get()) == buffer.get() + size);
+        }
+    }
+
 }
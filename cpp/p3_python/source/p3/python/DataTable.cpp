@@ -0,0 +1,183 @@
+#include "numpy.h"
+#include "p3ui.h"
+
+#include <p3/widgets/DataTable.h>
+
+namespace p3::python {
+
+namespace {
+
+    //
+    // keeps the python object alive as long as the source refers to it.
+    // the last reference may be dropped by the render thread.
+    std::shared_ptr<void> make_guard(py::object object)
+    {
+        return std::shared_ptr<py::object>(new py::object(std::move(object)), [](py::object* object) {
+            py::gil_scoped_acquire acquire;
+            delete object;
+        });
+    }
+
+    template <typename T>
+    bool make_span(py::array const& array, std::shared_ptr<DataTable::Source>& source)
+    {
+        if (source || !py::isinstance<py::array_t<T>>(array))
+            return false;
+        source = std::make_shared<DataTable::Span<T>>(
+            static_cast<T const*>(array.data()),
+            std::size_t(array.shape(0)),
+            std::size_t(array.strides(0)),
+            make_guard(array));
+        return true;
+    }
+
+    //
+    // the utf-8 representation is cached by the str objects,
+    // the views stay valid as long as the list is alive
+    std::shared_ptr<DataTable::Source> make_strings(py::iterable const& iterable)
+    {
+        py::list list;
+        std::vector<std::string_view> views;
+        for (auto item : iterable) {
+            auto value = py::isinstance<py::str>(item) ? py::reinterpret_borrow<py::str>(item) : py::str(item);
+            Py_ssize_t size;
+            auto data = PyUnicode_AsUTF8AndSize(value.ptr(), &size);
+            if (!data)
+                throw py::error_already_set();
+            views.emplace_back(data, std::size_t(size));
+            list.append(value);
+        }
+        return std::make_shared<DataTable::Strings>(std::move(views), make_guard(list));
+    }
+
+    std::shared_ptr<DataTable::Source> make_source(py::object data)
+    {
+        if (data.is_none())
+            return nullptr;
+        if (!py::isinstance<py::array>(data))
+            return make_strings(data);
+        auto array = py::reinterpret_borrow<py::array>(data);
+        if (array.ndim() != 1)
+            throw std::invalid_argument(fmt::format("array has wrong shape dimension of {}", array.ndim()));
+        //
+        // the sources take unsigned strides, reversed views are copied
+        if (array.strides(0) < 0)
+            array = py::module_::import("numpy").attr("ascontiguousarray")(array).cast<py::array>();
+        auto kind = array.dtype().kind();
+        if (kind == 'S')
+            return std::make_shared<DataTable::FixedStrings>(
+                static_cast<char const*>(array.data()),
+                std::size_t(array.shape(0)),
+                std::size_t(array.itemsize()),
+                std::size_t(array.strides(0)),
+                make_guard(array));
+        if (kind == 'U' || kind == 'O')
+            return make_strings(array.attr("tolist")());
+        std::shared_ptr<DataTable::Source> source;
+        make_span<std::int8_t>(array, source);
+        make_span<std::uint8_t>(array, source);
+        make_span<std::int16_t>(array, source);
+        make_span<std::uint16_t>(array, source);
+        make_span<std::int32_t>(array, source);
+        make_span<std::uint32_t>(array, source);
+        make_span<std::int64_t>(array, source);
+        make_span<std::uint64_t>(array, source);
+        make_span<float>(array, source);
+        make_span<double>(array, source);
+        if (!source)
+            throw std::invalid_argument(fmt::format("unsupported dtype {}", py::str(array.dtype()).cast<std::string>()));
+        return source;
+    }
+
+    py::object data(DataTable::Column const& column)
+    {
+        auto const& source = column.source();
+        if (!source || !source->guard())
+            return py::none();
+        return *std::static_pointer_cast<py::object>(source->guard());
+    }
+
+    void set_data(DataTable::Column& column, py::object data)
+    {
+        column.set_source(make_source(std::move(data)));
+    }
+
+    //
+    // read only view on the index, the array keeps the index alive
+    py::object index(DataTable const& table)
+    {
+        auto const& index = table.index();
+        if (!index)
+            return py::none();
+        auto array = py::array_t<std::uint32_t>(
+            { index->size() },
+            { sizeof(std::uint32_t) },
+            index->data(),
+            make_capsule(index));
+        array.attr("setflags")(py::arg("write") = false);
+        return array;
+    }
+
+}
+
+void Definition<DataTable>::apply(py::module& module)
+{
+    auto table = py::class_<DataTable, Node, std::shared_ptr<DataTable>>(module, "DataTable");
+    table.def(py::init<>([](py::kwargs kwargs) {
+        auto table = std::make_shared<DataTable>();
+        ArgumentParser<Node>()(kwargs, *table);
+        auto dict = std::static_pointer_cast<py::dict>(table->user_data());
+        if (kwargs.contains("columns")) {
+            (*dict)["columns"] = kwargs["columns"];
+            assign(kwargs, "columns", *table, &DataTable::set_columns);
+        }
+        assign(kwargs, "resizeable", *table, &DataTable::set_resizeable);
+        assign(kwargs, "reorderable", *table, &DataTable::set_reorderable);
+        assign(kwargs, "freezed_columns", *table, &DataTable::set_freezed_columns);
+        assign(kwargs, "freezed_rows", *table, &DataTable::set_freezed_rows);
+        assign(kwargs, "sortable", *table, &DataTable::set_sortable);
+        assign(kwargs, "sort_specs", *table, &DataTable::set_sort_specs);
+        assign(kwargs, "filter", *table, &DataTable::set_filter);
+        assign(kwargs, "on_index_change", *table, &DataTable::set_on_index_change);
+        return table;
+    }));
+    def_content_property(table, "columns", &DataTable::columns, &DataTable::set_columns);
+    def_property(table, "resizeable", &DataTable::resizeable, &DataTable::set_resizeable);
+    def_property(table, "reorderable", &DataTable::reorderable, &DataTable::set_reorderable);
+    def_property(table, "freezed_columns", &DataTable::freezed_columns, &DataTable::set_freezed_columns);
+    def_property(table, "freezed_rows", &DataTable::freezed_rows, &DataTable::set_freezed_rows);
+    def_property_readonly(table, "row_count", &DataTable::row_count);
+    def_property(table, "sortable", &DataTable::sortable, &DataTable::set_sortable);
+    def_property(table, "sort_specs", &DataTable::sort_specs, &DataTable::set_sort_specs);
+    def_property(table, "filter", &DataTable::filter, &DataTable::set_filter);
+    def_property_readonly(table, "index", &index);
+    def_property_readonly(table, "indexing", &DataTable::indexing);
+    def_signal_property(table, "on_index_change", &DataTable::on_index_change, &DataTable::set_on_index_change);
+    def_method(table, "update_index", &DataTable::update_index);
+
+    py::class_<DataTable::SortSpec> sort_spec(table, "SortSpec");
+    sort_spec.def(py::init<>([](std::size_t column, bool descending) {
+        return DataTable::SortSpec { column, descending };
+    }),
+        py::arg("column"), py::arg("descending") = false);
+    sort_spec.def_readwrite("column", &DataTable::SortSpec::column);
+    sort_spec.def_readwrite("descending", &DataTable::SortSpec::descending);
+
+    py::class_<DataTable::Column, std::shared_ptr<DataTable::Column>> column(table, "Column");
+    column.def(py::init<>([](std::string title, py::kwargs kwargs) {
+        auto column = std::make_shared<DataTable::Column>();
+        column->set_title(std::move(title));
+        assign(kwargs, "width", *column, &DataTable::Column::set_width);
+        assign(kwargs, "format", *column, &DataTable::Column::set_format);
+        if (kwargs.contains("data"))
+            set_data(*column, kwargs["data"]);
+        return column;
+    }),
+        py::arg("title"));
+    def_property(column, "title", &DataTable::Column::title, &DataTable::Column::set_title);
+    def_property(column, "width", &DataTable::Column::width, &DataTable::Column::set_width);
+    def_property(column, "format", &DataTable::Column::format, &DataTable::Column::set_format);
+    def_property(column, "data", &data, &set_data);
+}
+
+}
@@ -111,6 +111,13 @@ void Definition<Layout>::apply(py::module& module)
     def_property(layout, "align_items", &Layout::align_items, &Layout::set_align_items);
     def_property(layout, "background_color", &Layout::background_color, &Layout::set_background_color);
     def_property(layout, "justify_content", &Layout::justify_content, &Layout::set_justify_content);
+    layout.def_property_readonly_static("cache_hits", [](py::object&) {
+        return Layout::cache_statistics().hits;
+    });
+    layout.def_property_readonly_static("cache_misses", [](py::object&) {
+        return Layout::cache_statistics().misses;
+    });
+    layout.def_static("reset_cache_statistics", &Layout::reset_cache_statistics);
 
     py::class_<Row, Layout, std::shared_ptr<Row>>(module, "Row").def(py::init<>([](py::kwargs kwargs) {
         auto layout = std::make_shared<Row>();
@@ -0,0 +1,70 @@
+#include "p3ui.h"
+#include <p3/widgets/ListView.h>
+
+namespace p3::python {
+
+namespace {
+
+    //
+    // widgets created by the factory are kept alive by the "children"
+    // list of the view until the pool releases them, the factory itself
+    // by the gc dict (see assign)
+    void set_factory(ListView& list_view, py::object factory)
+    {
+        auto user_data = std::static_pointer_cast<py::dict>(list_view.user_data());
+        (*user_data)["factory"] = factory;
+        (*user_data)["children"] = py::list();
+        list_view.set_release([&list_view](std::shared_ptr<Node> node) {
+            py::list children = (*std::static_pointer_cast<py::dict>(list_view.user_data()))["children"];
+            auto object = py::cast(std::move(node));
+            if (children.contains(object))
+                children.attr("remove")(object);
+        });
+        if (factory.is_none()) {
+            list_view.set_factory(nullptr);
+            return;
+        }
+        list_view.set_factory([&list_view, weak_ref = py::weakref(factory)]() -> std::shared_ptr<Node> {
+            auto strong = weak_ref();
+            if (strong.is_none())
+                return nullptr;
+            py::object node = strong();
+            py::list children = (*std::static_pointer_cast<py::dict>(list_view.user_data()))["children"];
+            children.append(node);
+            return node.cast<std::shared_ptr<Node>>();
+        });
+    }
+
+}
+
+void Definition<ListView>::apply(py::module& module)
+{
+    py::class_<ListView, Node, std::shared_ptr<ListView>> list_view(module, "ListView");
+
+    list_view.def(py::init<>([](py::kwargs kwargs) {
+        auto list_view = std::make_shared<ListView>();
+        ArgumentParser<Node>()(kwargs, *list_view);
+        assign(kwargs, "item_count", *list_view, &ListView::set_item_count);
+        assign(kwargs, "item_height", *list_view, &ListView::set_item_height);
+        assign(kwargs, "columns", *list_view, &ListView::set_columns);
+        if (kwargs.contains("factory"))
+            set_factory(*list_view, kwargs["factory"]);
+        assign(kwargs, "bind", *list_view, &ListView::set_bind);
+        return list_view;
+    }));
+    def_property(list_view, "item_count", &ListView::item_count, &ListView::set_item_count);
+    def_property(list_view, "item_height", &ListView::item_height, &ListView::set_item_height);
+    def_property(list_view, "columns", &ListView::columns, &ListView::set_columns);
+    list_view.def_property(
+        "factory",
+        [](ListView& list_view) {
+            auto user_data = std::static_pointer_cast<py::dict>(list_view.user_data());
+            return user_data->contains("factory") ? py::object((*user_data)["factory"]) : py::object(py::none());
+        },
+        &set_factory);
+    def_signal_property(list_view, "bind", &ListView::bind, &ListView::set_bind);
+    def_property_readonly(list_view, "pool_size", &ListView::pool_size);
+    def_method(list_view, "invalidate_items", &ListView::invalidate_items);
+}
+
+}
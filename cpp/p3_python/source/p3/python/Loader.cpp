@@ -0,0 +1,40 @@
+#include "p3ui.h"
+
+#include <p3/Loader.h>
+#include <p3/Node.h>
+
+namespace p3::python {
+
+void Definition<Loader>::apply(py::module& module)
+{
+    py::class_<Loader, std::shared_ptr<Loader>> loader(module, "Loader");
+
+    loader.def(py::init<>([]() {
+        return std::make_shared<Loader>();
+    }));
+
+    def_method(loader, "add_element", [](Loader& loader, std::string name, py::function factory) {
+        loader.add_element(std::move(name), [factory]() {
+            return factory().cast<std::shared_ptr<Node>>();
+        });
+    });
+    def_method(loader, "compile", [](Loader& loader, std::string const& markup) {
+        auto image = loader.compile(markup);
+        return py::bytes(reinterpret_cast<char const*>(image.data()), image.size());
+    });
+    def_method(loader, "instantiate", [](Loader& loader, py::bytes image) {
+        std::string_view view(image);
+        return loader.instantiate(reinterpret_cast<std::uint8_t const*>(view.data()), view.size());
+    });
+    def_method(loader, "load", [](Loader& loader, std::string const& markup) {
+        return loader.load(markup);
+    });
+    def_method(loader, "load_compiled", [](Loader& loader, std::string const& path) {
+        return loader.load_compiled(path);
+    });
+    def_method(loader, "load_cached", [](Loader& loader, std::string const& markup, std::string const& cache) {
+        return loader.load_cached(markup, cache);
+    });
+}
+
+}
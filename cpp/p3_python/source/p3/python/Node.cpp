@@ -1,5 +1,7 @@
+#include "Promise.h"
 #include "p3ui.h"
 #include <p3/Node.h>
+#include <p3/StyleSheet.h>
 
 namespace p3::python {
 
@@ -9,6 +11,8 @@ void ArgumentParser<Node>::operator()(py::kwargs const& kwargs, Node& node)
     assign(kwargs, "left", node, &Node::set_left);
     assign(kwargs, "top", node, &Node::set_top);
     assign(kwargs, "label", node, &Node::set_label);
+    assign(kwargs, "class_name", node, &Node::set_class_name);
+    assign(kwargs, "style_sheet", node, &Node::set_style_sheet);
     assign(kwargs, "color", node, &Node::set_color);
     assign(kwargs, "width", node, &Node::set_width);
     assign(kwargs, "height", node, &Node::set_height);
@@ -19,6 +23,7 @@ void ArgumentParser<Node>::operator()(py::kwargs const& kwargs, Node& node)
     assign(kwargs, "on_mouse_move", node, &Node::set_on_mouse_move);
     assign(kwargs, "on_mouse_leave", node, &Node::set_on_mouse_leave);
     assign(kwargs, "on_mouse_wheel", node, &Node::set_on_mouse_wheel);
+    assign(kwargs, "raw_mouse_events", node, &Node::set_raw_mouse_events);
     //
     // TODO: add setter and use assign
     if (kwargs.contains("children")) {
@@ -42,6 +47,8 @@ void Definition<Node>::apply(py::module& module)
     mouse_event.def_property_readonly("y", &Node::MouseEvent::y);
     mouse_event.def_property_readonly("global_x", &Node::MouseEvent::global_x);
     mouse_event.def_property_readonly("global_y", &Node::MouseEvent::global_y);
+    mouse_event.def_property_readonly("movement_x", &Node::MouseEvent::movement_x);
+    mouse_event.def_property_readonly("movement_y", &Node::MouseEvent::movement_y);
     mouse_event.def_property_readonly("left_button_down", &Node::MouseEvent::left_button_down);
     mouse_event.def_property_readonly("middle_button_down", &Node::MouseEvent::middle_button_down);
     mouse_event.def_property_readonly("right_button_down", &Node::MouseEvent::right_button_down);
@@ -93,17 +100,27 @@ void Definition<Node>::apply(py::module& module)
         return s.attr("__foo");
     });
     node.def("focus", &Node::focus);
+    node.def("capture", [](Node& node) {
+        auto asyncio = py::module::import("asyncio");
+        auto promise_impl = std::make_unique<Promise<Pixels>>(asyncio);
+        auto future = promise_impl->get_future();
+        node.capture(p3::Promise<Pixels>(std::move(promise_impl)));
+        return future;
+    });
     def_property(node, "position", &Node::position, &Node::set_position);
     def_property(node, "left", &Node::left, &Node::set_left);
     def_property(node, "top", &Node::top, &Node::set_top);
     def_property(node, "visible", &Node::visible, &Node::set_visible);
     def_property(node, "disabled", &Node::disabled, &Node::set_disabled);
     def_property(node, "label", &Node::label, &Node::set_label);
+    def_property(node, "class_name", &Node::class_name, &Node::set_class_name);
+    def_property(node, "style_sheet", &Node::style_sheet, &Node::set_style_sheet);
     def_signal_property(node, "on_resize", &Node::on_resize, &Node::set_on_resize);
     def_signal_property(node, "on_mouse_enter", &Node::on_mouse_enter, &Node::set_on_mouse_enter);
     def_signal_property(node, "on_mouse_move", &Node::on_mouse_move, &Node::set_on_mouse_move);
     def_signal_property(node, "on_mouse_leave", &Node::on_mouse_leave, &Node::set_on_mouse_leave);
     def_signal_property(node, "on_mouse_wheel", &Node::on_mouse_wheel, &Node::set_on_mouse_wheel);
+    def_property(node, "raw_mouse_events", &Node::raw_mouse_events, &Node::set_raw_mouse_events);
     def_method(node, "redraw", &Node::redraw);
     def_method(node, "add", [](Node& node, py::object child) {
         if (child.is_none())
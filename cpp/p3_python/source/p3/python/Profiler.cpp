@@ -0,0 +1,42 @@
+#include "p3ui.h"
+
+#include <p3/Profiler.h>
+
+namespace p3::python {
+
+void Definition<Profiler>::apply(py::module& module)
+{
+    py::class_<Profiler, std::unique_ptr<Profiler, py::nodelete>> profiler(module, "Profiler", R"doc(
+            Captures the phases of frames and event dispatch as zones.
+            The capture is saved in the chrome trace event format.
+        )doc");
+
+    profiler.def_property_readonly_static("enabled", [](py::object&) {
+#ifdef P3_PROFILER
+        return true;
+#else
+        return false;
+#endif
+    });
+    profiler.def_property_readonly_static("capturing", [](py::object&) {
+        return Profiler::instance().capturing();
+    });
+    profiler.def_static("start", []() {
+        Profiler::instance().start();
+    });
+    profiler.def_static("stop", []() {
+        Profiler::instance().stop();
+    });
+    profiler.def_static("trace", []() {
+        auto& profiler = Profiler::instance();
+        py::gil_scoped_release release;
+        return profiler.trace();
+    });
+    profiler.def_static("save", [](std::string const& path) {
+        auto& profiler = Profiler::instance();
+        py::gil_scoped_release release;
+        profiler.save(path);
+    });
+}
+
+}
@@ -1,10 +1,43 @@
 #pragma once
 
 #include "p3ui.h"
+#include <p3/Pixels.h>
 #include <p3/Promise.h>
 
 namespace p3::python {
 
+//
+// promised values are cast, pixels become numpy arrays of shape
+// (height, width, 4) which take over the buffer
+template <typename T>
+py::object to_python(T t)
+{
+    return py::cast(std::move(t));
+}
+
+inline py::object to_python(Pixels pixels)
+{
+    auto data = pixels.data.release();
+    py::capsule owner(data, [](void* data) { delete[] static_cast<std::uint8_t*>(data); });
+    return py::array_t<std::uint8_t>({ std::size_t(pixels.height), std::size_t(pixels.width), std::size_t(4) }, data, owner);
+}
+
+//
+// rejections become python exceptions, pybind11 can not cast an
+// exception_ptr. exceptions which were raised in python are kept
+inline py::object to_python(std::exception_ptr e)
+{
+    try {
+        std::rethrow_exception(std::move(e));
+    } catch (py::error_already_set& error) {
+        return error.value();
+    } catch (std::exception const& error) {
+        return py::handle(PyExc_RuntimeError)(error.what());
+    } catch (...) {
+        return py::handle(PyExc_RuntimeError)("unknown error");
+    }
+}
+
 template <typename T>
 class Promise
     : public p3::Promise<T>::Implementation {
@@ -28,7 +61,7 @@ public:
     void set_value(T t) override final
     {
         //py::gil_scoped_acquire acquire;
-        _loop.attr("call_soon")(_future.attr("set_result"), py::cast(std::move(t)));
+        _loop.attr("call_soon")(_future.attr("set_result"), to_python(std::move(t)));
         //
         // need to release that with gil..
         _loop = py::none();
@@ -38,7 +71,7 @@ public:
     void set_exception(std::exception_ptr e) override final
     {
         //py::gil_scoped_acquire acquire;
-        _loop.attr("call_soon")(_future.attr("set_exception"), py::cast(std::move(e)));
+        _loop.attr("call_soon")(_future.attr("set_exception"), to_python(std::move(e)));
         //
         // need to release that with gil..
         _loop = py::none();
@@ -83,7 +116,7 @@ public:
     void set_exception(std::exception_ptr e) override final
     {
         //py::gil_scoped_acquire acquire;
-        _loop.attr("call_soon")(_future.attr("set_exception"), py::cast(std::move(e)));
+        _loop.attr("call_soon")(_future.attr("set_exception"), to_python(std::move(e)));
         //
         // need to release that with gil..
         _loop = py::none();
@@ -1,46 +1,71 @@
 #include "p3ui.h"
 
+#include <p3/StyleSheet.h>
+
 namespace p3::python {
-/*
+
+namespace {
+
+    template <typename T>
+    void assign(py::kwargs const& kwargs, const char* name, std::optional<T>& value)
+    {
+        if (kwargs.contains(name))
+            value = kwargs[name].cast<std::optional<T>>();
+    }
+
+}
+
 void ArgumentParser<StyleBlock>::operator()(py::kwargs const& kwargs, StyleBlock& style_block)
 {
-    assign(kwargs, "position", style_block, &StyleBlock::set_position);
-    assign(kwargs, "color", style_block, &StyleBlock::set_color);
-    assign(kwargs, "background_color", style_block, &StyleBlock::set_background_color);
-    assign(kwargs, "spacing", style_block, &StyleBlock::set_spacing);
-    assign(kwargs, "padding", style_block, &StyleBlock::set_padding);
-    assign(kwargs, "x", style_block, &StyleBlock::set_x);
-    assign(kwargs, "y", style_block, &StyleBlock::set_y);
-    assign(kwargs, "width", style_block, &StyleBlock::set_width);
-    assign(kwargs, "height", style_block, &StyleBlock::set_height);
-    assign(kwargs, "visible", style_block, &StyleBlock::set_visible);
-    assign(kwargs, "direction", style_block, &StyleBlock::set_direction);
-    assign(kwargs, "align_items", style_block, &StyleBlock::set_align_items);
-    assign(kwargs, "justify_content", style_block, &StyleBlock::set_justify_content);
-    assign(kwargs, "border_width", style_block, &StyleBlock::set_border_width);
-    assign(kwargs, "border_color", style_block, &StyleBlock::set_border_color);
+    assign(kwargs, "color", style_block.color);
+    assign(kwargs, "background_color", style_block.background_color);
+    assign(kwargs, "button_color", style_block.button_color);
+    assign(kwargs, "border_color", style_block.border_color);
+    assign(kwargs, "alpha", style_block.alpha);
+    assign(kwargs, "padding", style_block.padding);
+    assign(kwargs, "spacing", style_block.spacing);
+    assign(kwargs, "rounding", style_block.rounding);
+    assign(kwargs, "border_width", style_block.border_width);
 }
 
 void Definition<StyleBlock>::apply(py::module& module)
 {
-     py::class_<StyleBlock, std::shared_ptr<StyleBlock>> style(module, "Style");
+    py::class_<StyleBlock> style(module, "Style");
 
-    style.def(py::init<>([](py::kwargs& kwargs) {
-        auto style = std::make_shared<StyleBlock>();
-        ArgumentParser<StyleBlock>()(kwargs, *style);
-        return style;
+    style.def(py::init<>([](py::kwargs kwargs) {
+        StyleBlock style_block;
+        ArgumentParser<StyleBlock>()(kwargs, style_block);
+        return style_block;
     }));
 
- def_property(style, "position", &StyleBlock::position, &StyleBlock::set_position);
-    def_property(style, "background_color", &StyleBlock::color, &StyleBlock::set_background_color);
-    def_property(style, "x", &StyleBlock::x, &StyleBlock::set_x);
-    def_property(style, "y", &StyleBlock::y, &StyleBlock::set_y);
-    def_property(style, "width", &StyleBlock::width, &StyleBlock::set_width);
-    def_property(style, "height", &StyleBlock::height, &StyleBlock::set_height);
-    def_property(style, "visible", &StyleBlock::visible, &StyleBlock::set_visible);
-    def_property(style, "border_width", &StyleBlock::border_width, &StyleBlock::set_border_width);
-    def_property(style, "border_color", &StyleBlock::border_color, &StyleBlock::set_border_color);
+    style.def_readwrite("color", &StyleBlock::color);
+    style.def_readwrite("background_color", &StyleBlock::background_color);
+    style.def_readwrite("button_color", &StyleBlock::button_color);
+    style.def_readwrite("border_color", &StyleBlock::border_color);
+    style.def_readwrite("alpha", &StyleBlock::alpha);
+    style.def_readwrite("padding", &StyleBlock::padding);
+    style.def_readwrite("spacing", &StyleBlock::spacing);
+    style.def_readwrite("rounding", &StyleBlock::rounding);
+    style.def_readwrite("border_width", &StyleBlock::border_width);
+
+    py::class_<StyleSheet, std::shared_ptr<StyleSheet>> style_sheet(module, "StyleSheet");
+
+    //
+    // rules are given as dict of selector and style, in order
+    style_sheet.def(py::init<>([](py::dict rules) {
+        std::vector<StyleSheet::Rule> compiled;
+        compiled.reserve(rules.size());
+        for (auto item : rules)
+            compiled.push_back(StyleSheet::Rule { item.first.cast<std::string>(), item.second.cast<StyleBlock>() });
+        return std::make_shared<StyleSheet>(std::move(compiled));
+    }));
+
+    style_sheet.def_property_readonly("rules", [](StyleSheet const& style_sheet) {
+        py::dict rules;
+        for (auto const& rule : style_sheet.rules())
+            rules[py::str(rule.selector)] = rule.block;
+        return rules;
+    });
 }
-    */
 
-}
\ No newline at end of file
+}
@@ -0,0 +1,20 @@
+#include "p3ui.h"
+#include <p3/widgets/VirtualList.h>
+
+namespace p3::python {
+
+void Definition<VirtualList>::apply(py::module& module)
+{
+    py::class_<VirtualList, Node, std::shared_ptr<VirtualList>> virtual_list(module, "VirtualList");
+
+    virtual_list.def(py::init<>([](py::kwargs kwargs) {
+        auto virtual_list = std::make_shared<VirtualList>();
+        ArgumentParser<Node>()(kwargs, *virtual_list);
+        assign(kwargs, "spacing", *virtual_list, &VirtualList::set_spacing);
+        return virtual_list;
+    }));
+    def_property(virtual_list, "spacing", &VirtualList::spacing, &VirtualList::set_spacing);
+    def_property_readonly(virtual_list, "visible_range", &VirtualList::visible_range);
+}
+
+}
@@ -35,8 +35,31 @@ void Definition<Window>::apply(py::module& module)
             return monitor == other;
         });
 
+    auto seconds = [](FrameStatistics::Duration duration) {
+        return std::chrono::duration<double>(duration).count();
+    };
+    py::class_<FrameStatistics::Summary>(module, "FrameTimeSummary")
+        .def_readonly("count", &FrameStatistics::Summary::count)
+        .def_property_readonly("p50", [=](FrameStatistics::Summary const& summary) { return seconds(summary.p50); })
+        .def_property_readonly("p95", [=](FrameStatistics::Summary const& summary) { return seconds(summary.p95); })
+        .def_property_readonly("p99", [=](FrameStatistics::Summary const& summary) { return seconds(summary.p99); })
+        .def_property_readonly("max", [=](FrameStatistics::Summary const& summary) { return seconds(summary.max); });
+
+    py::class_<FrameStatistics>(module, "FrameStatistics")
+        .def_property_readonly("cpu", &FrameStatistics::cpu)
+        .def_property_readonly("gpu", &FrameStatistics::gpu)
+        .def_property_readonly("frames", &FrameStatistics::frames)
+        .def_property_readonly("late_frames", &FrameStatistics::late_frames)
+        .def_property_readonly("dropped_frames", &FrameStatistics::dropped_frames)
+        .def_property("window", &FrameStatistics::window, &FrameStatistics::set_window)
+        .def("reset", &FrameStatistics::reset);
+
     auto window = py::class_<Window, std::shared_ptr<Window>>(module, "Window");
 
+    py::enum_<Window::Renderer>(window, "Renderer")
+        .value("OpenGL", Window::Renderer::OpenGL)
+        .value("Raster", Window::Renderer::Raster);
+
     py::class_<Window::Position>(window, "Position")
         .def(py::init<>([](int x, int y) { return Window::Position { x, y }; }))
         .def(py::init<>([](std::tuple<int, int> size) { return Window::Position { std::get<0>(size), std::get<1>(size) }; }))
@@ -51,8 +74,8 @@ void Definition<Window>::apply(py::module& module)
         .def_readwrite("height", &Window::Size::height);
     py::implicitly_convertible<py::tuple, Window::Size>();
 
-    window.def(py::init<>([](std::string title, Window::Size size, py::kwargs kwargs) {
-        auto window = std::make_shared<Window>(std::move(title), size.width, size.height);
+    window.def(py::init<>([](std::string title, Window::Size size, bool offscreen, Window::Renderer renderer, py::kwargs kwargs) {
+        auto window = std::make_shared<Window>(std::move(title), size.width, size.height, offscreen, renderer);
         auto dict = std::static_pointer_cast<py::dict>(window->user_data());
         (*dict)["user_interface"] = window->user_interface();
         assign(kwargs, "video_mode", *window, &Window::set_video_mode);
@@ -60,11 +83,16 @@ void Definition<Window>::apply(py::module& module)
         assign(kwargs, "vsync", *window, &Window::set_vsync);
         assign(kwargs, "idle_timeout", *window, &Window::set_idle_timeout);
         assign(kwargs, "idle_frame_time", *window, &Window::set_idle_frame_time);
+        assign(kwargs, "render_on_demand", *window, &Window::set_render_on_demand);
+        assign(kwargs, "target_frame_rate", *window, &Window::set_target_frame_rate);
+        assign(kwargs, "low_latency", *window, &Window::set_low_latency);
         return window;
     }),
         py::kw_only(),
         py::arg("title") = "p3",
-        py::arg("size") = Window::Size {1024, 768}
+        py::arg("size") = Window::Size {1024, 768},
+        py::arg("offscreen") = false,
+        py::arg("renderer") = Window::Renderer::OpenGL
         );
 
     def_content_property(window, "user_interface", &Window::user_interface, &Window::set_user_interface);
@@ -74,12 +102,36 @@ void Definition<Window>::apply(py::module& module)
     window.def_property_readonly("monitors", &Window::monitors);
     window.def_property_readonly("frames_per_second", &Window::frames_per_second);
     window.def_property_readonly("idle_timer", &Window::time_till_enter_idle_mode);
+    window.def_property_readonly("input_latency", &Window::input_latency);
+    window.def_property_readonly("offscreen", &Window::offscreen);
+    window.def_property_readonly("renderer", &Window::renderer);
+    window.def("frame", &Window::frame);
+    window.def("capture", [](Window& window) {
+        auto asyncio = py::module::import("asyncio");
+        auto promise_impl = std::make_unique<Promise<Pixels>>(asyncio);
+        auto future = promise_impl->get_future();
+        window.capture(p3::Promise<Pixels>(std::move(promise_impl)));
+        return future;
+    });
+    window.def("read_pixels", [](Window& window) {
+        auto const size = window.framebuffer_size();
+        auto pixels = py::array_t<std::uint8_t>({ std::size_t(size.height), std::size_t(size.width), std::size_t(4) });
+        window.read_pixels(pixels.mutable_data());
+        return pixels;
+    });
+    window.def_property_readonly(
+        "frame_statistics",
+        [](Window& window) -> FrameStatistics& { return window.frame_statistics(); },
+        py::return_value_policy::reference_internal);
     window.def_property("video_mode", &Window::video_mode, &Window::set_video_mode);
     window.def_property("position", &Window::position, &Window::set_position);
     window.def_property("size", &Window::size, &Window::set_size);
     window.def_property("vsync", &Window::vsync, &Window::set_vsync);
     window.def_property("idle_timeout", &Window::idle_timeout, &Window::set_idle_timeout);
     window.def_property("idle_frame_time", &Window::idle_frame_time, &Window::set_idle_frame_time);
+    window.def_property("render_on_demand", &Window::render_on_demand, &Window::set_render_on_demand);
+    window.def_property("target_frame_rate", &Window::target_frame_rate, &Window::set_target_frame_rate);
+    window.def_property("low_latency", &Window::low_latency, &Window::set_low_latency);
     window.def_property("user_interface", &Window::user_interface, &Window::set_user_interface);
 
     window.def_property_readonly("closed", [&](Window& w) {
@@ -43,6 +43,7 @@ void Definition<EventLoop>::apply(py::module& module)
         auto now = EventLoop::Clock::now();
         auto d = std::chrono::duration<double>(delay);
         auto task = std::make_unique<PythonTask>(std::move(handle));
+        task->set_origin({}, "task");
         auto tp = now + std::chrono::duration_cast<std::chrono::nanoseconds>(d);
         event_loop.call_at(tp, std::move(task));
     });
@@ -51,6 +52,46 @@ void Definition<EventLoop>::apply(py::module& module)
     });
     event_loop.def("stop", &EventLoop::stop);
     event_loop.def("close", &EventLoop::close);
+
+    py::class_<CallbackStatistics::Entry>(event_loop, "CallbackTiming")
+        .def_readonly("node", &CallbackStatistics::Entry::node)
+        .def_readonly("signal", &CallbackStatistics::Entry::signal)
+        .def_property_readonly("duration", [](CallbackStatistics::Entry const& entry) {
+            return std::chrono::duration<double>(entry.duration).count();
+        })
+        .def("__repr__", [](CallbackStatistics::Entry const& entry) {
+            return fmt::format("<CallbackTiming {} {} {:.3f}ms>", entry.node, entry.signal,
+                std::chrono::duration<double, std::milli>(entry.duration).count());
+        });
+    event_loop.def_property_readonly("slowest_callbacks", [](EventLoop& event_loop) {
+        return event_loop.callback_statistics().slowest();
+    });
+    event_loop.def_property(
+        "slowest_callbacks_size",
+        [](EventLoop& event_loop) { return event_loop.callback_statistics().size(); },
+        [](EventLoop& event_loop, std::size_t size) { event_loop.callback_statistics().set_size(size); });
+    event_loop.def_property(
+        "slow_callback_threshold",
+        [](EventLoop& event_loop) -> std::optional<double> {
+            auto threshold = event_loop.callback_statistics().warning_threshold();
+            if (!threshold)
+                return std::nullopt;
+            return std::chrono::duration<double>(threshold.value()).count();
+        },
+        [](EventLoop& event_loop, std::optional<double> seconds) {
+            event_loop.callback_statistics().set_warning_threshold(seconds
+                    ? std::optional<CallbackStatistics::Duration>(std::chrono::duration_cast<CallbackStatistics::Duration>(std::chrono::duration<double>(seconds.value())))
+                    : std::nullopt);
+        });
+    event_loop.def_property_readonly("callback_count", [](EventLoop& event_loop) {
+        return event_loop.callback_statistics().calls();
+    });
+    event_loop.def_property_readonly("callback_time", [](EventLoop& event_loop) {
+        return std::chrono::duration<double>(event_loop.callback_statistics().total()).count();
+    });
+    event_loop.def("reset_callback_statistics", [](EventLoop& event_loop) {
+        event_loop.callback_statistics().reset();
+    });
     //    def_property(image, "texture", &Image::texture, &Image::set_texture);
     //    def_property(image, "scale", &Image::scale, &Image::set_scale);
     //    def_property(image, "on_click", &Image::on_click, &Image::set_on_click);
@@ -44,6 +44,7 @@ PYBIND11_MODULE(native, module)
     python::Definition<Color>::apply(module);
     python::Definition<ColorEdit>::apply(module);
     python::Definition<ComboBox>::apply(module);
+    python::Definition<DataTable>::apply(module);
     python::Definition<Tab>::apply(module);
     python::Definition<Table>::apply(module);
     python::Definition<Text>::apply(module);
@@ -59,11 +60,14 @@ PYBIND11_MODULE(native, module)
     python::Definition<InputScalar<std::uint64_t>>::apply(module);
     python::Definition<InputScalar<float>>::apply(module);
     python::Definition<InputScalar<double>>::apply(module);
+    python::Definition<ListView>::apply(module);
+    python::Definition<Loader>::apply(module);
     python::Definition<Menu>::apply(module);
     python::Definition<MenuItem>::apply(module);
     python::Definition<MenuBar>::apply(module);
     python::Definition<Plot>::apply(module);
     python::Definition<Popup>::apply(module);
+    python::Definition<Profiler>::apply(module);
     python::Definition<ProgressBar>::apply(module);
     python::Definition<ChildWindow>::apply(module);
     python::Definition<ScrollArea>::apply(module);
@@ -78,8 +82,10 @@ PYBIND11_MODULE(native, module)
     python::Definition<Slider<float>>::apply(module);
     python::Definition<Slider<double>>::apply(module);
     python::Definition<Spacer>::apply(module);
+    python::Definition<StyleBlock>::apply(module);
     python::Definition<Theme>::apply(module);
     python::Definition<UserInterface>::apply(module);
+    python::Definition<VirtualList>::apply(module);
     python::Definition<Window>::apply(module);
 
     python::Definition<python::Surface>::apply(module);
@@ -0,0 +1,15 @@
+"""
+benchmarks of the python bindings. measured are the paths which cross the
+pybind boundary most: constructing widgets with keyword arguments, setting
+plot data and dispatching callbacks through the native event loop.
+
+with pytest-benchmark installed:
+
+    pytest --pyargs p3ui.benchmarks --benchmark-json=benchmarks.json
+
+without pytest:
+
+    python -m p3ui.benchmarks [--filter <substring>] [--json <path>]
+
+no window is created, hence the benchmarks run on machines without display.
+"""
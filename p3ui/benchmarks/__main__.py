@@ -0,0 +1,95 @@
+"""
+runs the benchmarks without pytest. the `benchmark` fixture of
+pytest-benchmark is replaced by a minimal object with the same call
+signature, the results are printed and optionally written as json.
+"""
+import argparse
+import importlib
+import inspect
+import json
+import platform
+import statistics
+import time
+
+MODULES = ['test_widgets', 'test_plot', 'test_callbacks']
+
+
+class Benchmark:
+
+    def __init__(self, max_time, rounds):
+        self.max_time = max_time
+        self.rounds = rounds
+        self.iterations = 0
+        self.samples = []
+
+    def __call__(self, function, *args, **kwargs):
+        #
+        # calibrate the iterations per round once, all rounds do the same work
+        iterations = 1
+        while True:
+            elapsed = self._time(function, args, kwargs, iterations)
+            if elapsed >= self.max_time / 10. or iterations >= 1000000:
+                break
+            iterations *= 10
+        self.iterations = max(1, int(iterations * self.max_time / max(elapsed, 1e-9) / self.rounds))
+        self.samples = [self._time(function, args, kwargs, self.iterations) / self.iterations
+                        for _ in range(self.rounds)]
+        return function(*args, **kwargs)
+
+    @staticmethod
+    def _time(function, args, kwargs, iterations):
+        begin = time.perf_counter()
+        for _ in range(iterations):
+            function(*args, **kwargs)
+        return time.perf_counter() - begin
+
+
+def main():
+    parser = argparse.ArgumentParser(prog='python -m p3ui.benchmarks')
+    parser.add_argument('--filter', default='')
+    parser.add_argument('--json')
+    parser.add_argument('--max-time', type=float, default=1.)
+    parser.add_argument('--rounds', type=int, default=5)
+    args = parser.parse_args()
+
+    results = []
+    print(f'{"benchmark":<48} {"median":>12} {"min":>12} {"stddev":>9} {"iterations":>12}')
+    for module_name in MODULES:
+        module = importlib.import_module(f'{__package__}.{module_name}')
+        for name, test in inspect.getmembers(module, inspect.isfunction):
+            full_name = f'{module_name}::{name}'
+            if not name.startswith('test_') or args.filter not in full_name:
+                continue
+            benchmark = Benchmark(args.max_time, args.rounds)
+            test(benchmark)
+            median = statistics.median(benchmark.samples)
+            stddev = statistics.stdev(benchmark.samples) if len(benchmark.samples) > 1 else 0.
+            print(f'{full_name:<48} {median * 1e6:>9.1f} us {min(benchmark.samples) * 1e6:>9.1f} us '
+                  f'{100. * stddev / median:>8.1f}% {benchmark.iterations:>12}')
+            results.append({
+                'name': full_name,
+                'iterations': benchmark.iterations,
+                'stats': {
+                    'median': median,
+                    'min': min(benchmark.samples),
+                    'mean': statistics.mean(benchmark.samples),
+                    'stddev': stddev,
+                    'data': benchmark.samples
+                }
+            })
+
+    if args.json:
+        with open(args.json, 'w') as file:
+            json.dump({
+                'machine_info': {
+                    'python_version': platform.python_version(),
+                    'machine': platform.machine(),
+                    'system': platform.system()
+                },
+                'datetime': time.strftime('%Y-%m-%dT%H:%M:%SZ', time.gmtime()),
+                'benchmarks': results
+            }, file, indent=2)
+
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,36 @@
+from p3ui import GuiEventLoop
+import asyncio
+
+CALLBACKS = 10000
+
+
+def _dispatch(loop):
+    for _ in range(CALLBACKS - 1):
+        loop.call_soon(lambda: None)
+    loop.call_soon(loop.stop)
+    loop.run_forever()
+
+
+def _switch_tasks(loop):
+    async def task():
+        for _ in range(CALLBACKS):
+            await asyncio.sleep(0)
+
+    loop.create_task(task()).add_done_callback(lambda _: loop.stop())
+    loop.run_forever()
+
+
+def test_dispatch_10000_callbacks(benchmark):
+    loop = GuiEventLoop()
+    try:
+        benchmark(_dispatch, loop)
+    finally:
+        loop.close()
+
+
+def test_switch_10000_tasks(benchmark):
+    loop = GuiEventLoop()
+    try:
+        benchmark(_switch_tasks, loop)
+    finally:
+        loop.close()
@@ -0,0 +1,47 @@
+from p3ui import *
+import numpy as np
+
+POINTS = 1000000
+
+_x = np.linspace(0., 1., POINTS)
+_y = np.sin(_x * 20.) + np.random.default_rng(42).normal(0., 0.1, POINTS)
+
+
+def test_line_series_kwargs(benchmark):
+    benchmark(lambda: Plot.LineSeriesDouble('series', x=_x, y=_y))
+
+
+def test_set_line_series_data(benchmark):
+    series = Plot.LineSeriesDouble('series')
+
+    def assign():
+        series.x = _x
+        series.y = _y
+
+    benchmark(assign)
+
+
+def test_set_line_series_data_float32(benchmark):
+    series = Plot.LineSeriesFloat('series')
+    x = _x.astype(np.float32)
+    y = _y.astype(np.float32)
+
+    def assign():
+        series.x = x
+        series.y = y
+
+    benchmark(assign)
+
+
+def test_get_line_series_data(benchmark):
+    series = Plot.LineSeriesDouble('series', x=_x, y=_y)
+    benchmark(lambda: (series.x, series.y))
+
+
+def test_bar_series_values(benchmark):
+    series = Plot.BarSeriesDouble('series')
+
+    def assign():
+        series.values = _y
+
+    benchmark(assign)
@@ -0,0 +1,54 @@
+from p3ui import *
+
+#
+# a control screen: rows of a label, a slider, a check box and a button
+ROWS = 1000
+
+
+def _on_change(value):
+    pass
+
+
+def _on_click():
+    pass
+
+
+def _row(index):
+    return Row(
+        padding=(0 | px, 0 | px),
+        align_items=Alignment.Center,
+        children=[
+            Text(f'value {index}', width=(10 | em, 0, 0)),
+            SliderDouble(min=0., max=100., value=float(index % 100), on_change=_on_change, width=(1 | em, 1, 1)),
+            CheckBox(value=index % 2 == 0, on_change=_on_change, label=f'enabled {index}'),
+            Button(label=f'apply {index}', on_click=_on_click)
+        ])
+
+
+def _screen():
+    return Column(children=[_row(index) for index in range(ROWS)])
+
+
+def test_button_kwargs(benchmark):
+    benchmark(lambda: Button(label='apply', on_click=_on_click, width=(10 | em, 0, 0), height=(2 | em, 0, 0)))
+
+
+def test_slider_kwargs(benchmark):
+    benchmark(lambda: SliderDouble(min=0., max=100., value=50., format='%.2f', on_change=_on_change))
+
+
+def test_text(benchmark):
+    benchmark(lambda: Text('value', width=(10 | em, 0, 0)))
+
+
+def test_screen_of_1000_rows(benchmark):
+    benchmark(_screen)
+
+
+def test_assign_signal(benchmark):
+    button = Button()
+
+    def assign():
+        button.on_click = _on_click
+
+    benchmark(assign)
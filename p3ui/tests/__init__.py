@@ -0,0 +1,8 @@
+"""
+tests of the python bindings, the paths where native objects hand results
+or ownership back to python.
+
+    pytest --pyargs p3ui.tests
+
+the window tests create offscreen windows, hence they need a display.
+"""
@@ -0,0 +1,36 @@
+from p3ui import GuiEventLoop, ListView, Spacer, Window, px
+import asyncio
+import gc
+import weakref
+
+
+def test_shrinking_a_list_view_releases_its_widgets():
+    loop = GuiEventLoop()
+    asyncio.set_event_loop(loop)
+    try:
+        window = Window(size=(320, 240), offscreen=True, renderer=Window.Renderer.Raster)
+        created = []
+
+        def factory():
+            widget = Spacer()
+            created.append(weakref.ref(widget))
+            return widget
+
+        list_view = ListView(item_count=1000, item_height=20 | px, factory=factory, bind=lambda widget, item: None)
+        window.user_interface.content = list_view
+        window.frame()
+        pooled = list_view.pool_size
+        assert pooled > 1
+        #
+        # nothing is visible, the pool keeps a single free widget
+        list_view.item_count = 0
+        window.frame()
+        window.frame()
+        gc.collect()
+        assert list_view.pool_size == 1
+        assert sum(reference() is None for reference in created) == pooled - 1
+        del window
+        gc.collect()
+    finally:
+        asyncio.set_event_loop(None)
+        loop.close()
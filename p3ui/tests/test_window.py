@@ -0,0 +1,23 @@
+from p3ui import GuiEventLoop, Window
+import asyncio
+import gc
+import pytest
+
+
+def test_closing_a_window_rejects_pending_captures():
+    loop = GuiEventLoop()
+    asyncio.set_event_loop(loop)
+    try:
+        window = Window(size=(64, 64), offscreen=True, renderer=Window.Renderer.Raster)
+        #
+        # the frame of the capture is never rendered
+        capture = window.capture()
+        del window
+        gc.collect()
+        loop.run_until_complete(asyncio.sleep(0))
+        assert capture.done()
+        with pytest.raises(RuntimeError, match='window was closed'):
+            capture.result()
+    finally:
+        asyncio.set_event_loop(None)
+        loop.close()